@@ -6,10 +6,15 @@
 #include "gvd_topo/core/TopologyExtractor.hpp"
 #include "gvd_topo/core/Visualizer.hpp"
 #include "gvd_topo/utils/Timer.hpp"
+#include <future>
 #include <memory>
 
 namespace gvd_topo {
 
+class AsyncOutputSink;
+struct OutputReport;
+struct RunControl;
+
 /**
  * @brief Command Line Interface Application
  * 
@@ -19,7 +24,7 @@ namespace gvd_topo {
 class CliApplication {
 public:
     CliApplication();
-    ~CliApplication() = default;
+    ~CliApplication();
 
     /**
      * @brief Run the application with given configuration
@@ -30,13 +35,15 @@ public:
 
     /**
      * @brief Set timing report callback
-     * @param callback Function to call for timing reports
+     * @param callback Function to call for timing reports; calls may come from
+     *        output writer threads but are serialized, never concurrent
      */
     void setTimingCallback(std::function<void(const std::string&, double)> callback);
 
 private:
     std::unique_ptr<GvdGenerator> gvd_generator_;
     std::unique_ptr<TopologyExtractor> topology_extractor_;
+    std::unique_ptr<AsyncOutputSink> output_sink_;
     std::function<void(const std::string&, double)> timing_callback_;
 
     /**
@@ -46,32 +53,79 @@ private:
      */
     OccupancyGrid loadOccupancyGrid(const ConfigOptions& config);
 
+    /**
+     * @brief Load a PGM map in row bands and generate the GVD as it streams in
+     * @param config Configuration containing input parameters
+     * @param grid Receives map metadata; cells only when an overlay is requested
+     * @return GVD result
+     */
+    GvdResult loadAndGenerateStreaming(const ConfigOptions& config, OccupancyGrid& grid);
+
     /**
      * @brief Generate GVD from occupancy grid
      * @param grid Input occupancy grid
+     * @param control Deadline, anytime mode and progress; null for none
      * @return GVD result
      */
-    GvdResult generateGVD(const OccupancyGrid& grid);
+    GvdResult generateGVD(const OccupancyGrid& grid, const RunControl* control = nullptr);
 
     /**
      * @brief Extract topology from GVD result
      * @param gvd_result GVD result
      * @param resolution Map resolution
+     * @param control Deadline, anytime mode and progress; null for none
      * @return Topological map
      */
-    TopologicalMap extractTopology(const GvdResult& gvd_result, double resolution);
+    TopologicalMap extractTopology(const GvdResult& gvd_result, double resolution,
+                                   const RunControl* control = nullptr);
 
     /**
-     * @brief Save outputs based on configuration
+     * @brief Queue outputs on the background sink; returns without waiting
+     *
+     * Completion is reported on stdout/stderr as each request finishes.
+     * run() flushes the sink before returning.
      * @param config Configuration containing output parameters
-     * @param grid Input occupancy grid
+     * @param grid Input occupancy grid (read only for the overlay)
      * @param gvd_result GVD result
-     * @param topo_map Topological map
+     * @param topo_map Topological map (may be null for a distance-only request)
+     * @return Ready once every requested file has been written or has failed
+     */
+    std::future<OutputReport> saveOutputs(const ConfigOptions& config,
+                                          std::shared_ptr<const OccupancyGrid> grid,
+                                          std::shared_ptr<const GvdResult> gvd_result,
+                                          std::shared_ptr<const TopologicalMap> topo_map);
+
+    /**
+     * @brief Process every map of a directory or manifest on a shared thread pool
+     * @param config Configuration containing batch and output parameters
+     * @return Exit code (0 when every map succeeded)
+     */
+    int runBatch(const ConfigOptions& config);
+
+    /**
+     * @brief Process batch inputs in order through pipelined stage workers
+     *
+     * Load, EDT+GVD, topology and output writing each run on their own thread,
+     * connected by bounded queues, so map N+1 loads while map N is in the EDT
+     * and map N-1 is being written.
+     * @param config Configuration containing batch and output parameters
+     * @return Exit code (0 when every processed map succeeded)
+     */
+    int runPipeline(const ConfigOptions& config);
+
+    /**
+     * @brief Serve map-processing requests on a Unix domain socket until stopped
+     * @param config Configuration containing daemon parameters and request defaults
+     * @return Exit code
+     */
+    int runDaemon(const ConfigOptions& config);
+
+    /**
+     * @brief Run a topology parameter sweep against one GVD result
+     * @param config Configuration containing sweep specifications
+     * @param gvd_result GVD result shared by every combination
      */
-    void saveOutputs(const ConfigOptions& config, 
-                    const OccupancyGrid& grid,
-                    const GvdResult& gvd_result,
-                    const TopologicalMap& topo_map);
+    void runSweep(const ConfigOptions& config, const GvdResult& gvd_result);
 
     /**
      * @brief Print processing statistics
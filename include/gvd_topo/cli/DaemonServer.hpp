@@ -0,0 +1,109 @@
+#pragma once
+
+#include "gvd_topo/io/YamlLoader.hpp"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace gvd_topo {
+
+class GvdGenerator;
+class ThreadPool;
+class TopologyExtractor;
+
+/**
+ * @brief Long-running map-processing server on a Unix domain socket
+ *
+ * Requests are text lines; a connection may send any number of them in turn:
+ *   PROCESS <path> [key=value ...]        YAML map or image file on the server
+ *   GRID <width> <height> [key=value ...] followed by width*height cell bytes
+ *                                         (int8: 0 free, 100 occupied, -1 unknown)
+ *   PING
+ *   STATS
+ * Options: format=json|binary, resolution=<m>, occ=<0-100>, prune=<m>,
+ * merge=<m>, clearance=0|1. Unset options take the daemon's configuration.
+ *
+ * Replies:
+ *   OK <bytes> <json|binary>\n followed by the payload
+ *   BUSY <pending>\n  the request queue or the GRID byte budget is full;
+ *                     nothing was run, retry later
+ *   ERR <message>\n
+ *
+ * A request is admitted before a GRID payload is allocated or read; a grid
+ * turned away (BUSY, bad option, larger than the whole budget) is still
+ * drained from the socket so the connection stays usable.
+ */
+class DaemonServer {
+public:
+    struct Options {
+        std::string socket_path;
+        int workers {0};          // concurrent requests, 0 = hardware concurrency
+        int queue_depth {16};     // admitted requests waiting for a worker
+        int max_connections {64}; // further clients get BUSY and are closed
+        uint64_t max_grid_bytes {uint64_t(1) << 30}; // GRID payloads held at once
+    };
+
+    struct Stats {
+        uint64_t served {0};
+        uint64_t rejected {0}; // BUSY replies
+        uint64_t failed {0};   // ERR replies
+    };
+
+    /**
+     * @brief Create a server; nothing is bound until serve()
+     * @param defaults Configuration supplying per-request defaults
+     * @param options Socket and concurrency settings
+     */
+    DaemonServer(const ConfigOptions& defaults, const Options& options);
+    ~DaemonServer();
+    DaemonServer(const DaemonServer&) = delete;
+    DaemonServer& operator=(const DaemonServer&) = delete;
+
+    /**
+     * @brief Bind the socket and serve until stop(), SIGINT or SIGTERM
+     *
+     * Throws std::runtime_error if the socket cannot be set up. The socket
+     * file is removed again on return.
+     */
+    void serve();
+
+    /**
+     * @brief Ask serve() to return; safe to call from any thread
+     */
+    void stop() { stop_requested_ = true; }
+
+    Stats stats() const;
+
+private:
+    struct Connection;
+
+    ConfigOptions defaults_;
+    Options options_;
+    int threads_per_request_ {1};
+    // Shared by every worker: run() is const and keeps no per-call state.
+    // Requests overriding prune/merge/clearance trace with their own params.
+    std::unique_ptr<GvdGenerator> generator_;
+    std::unique_ptr<TopologyExtractor> extractor_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::atomic<bool> stop_requested_ {false};
+    std::atomic<int> pending_ {0}; // admitted and not yet finished
+    std::atomic<uint64_t> grid_bytes_ {0}; // payloads of admitted GRID requests
+    std::atomic<uint64_t> served_ {0};
+    std::atomic<uint64_t> rejected_ {0};
+    std::atomic<uint64_t> failed_ {0};
+    std::mutex connections_mutex_;
+    std::list<std::unique_ptr<Connection>> connections_;
+
+    /**
+     * @brief Read and answer requests on one client connection until it closes
+     */
+    void handleConnection(Connection& conn);
+
+    void reapConnections(bool all);
+};
+
+} // namespace gvd_topo
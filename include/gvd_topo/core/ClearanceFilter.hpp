@@ -0,0 +1,26 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include <vector>
+
+namespace gvd_topo {
+
+struct RadiusTopology {
+    double radius {0.0};
+    std::vector<uint8_t> gvd_mask; // skeleton pixels with clearance >= radius
+    TopologicalMap map;
+};
+
+// Drops GVD pixels whose clearance (GvdResult::distance, meters) is below radius
+std::vector<uint8_t> filterGvdByClearance(const GvdResult& gvd, double radius);
+
+// One filtered skeleton and topology per robot radius from a single EDT.
+// Radii are processed in parallel on ThreadPool::shared(), within the
+// extractor's parallel / max_threads; results keep the input order.
+std::vector<RadiusTopology> extractForRadii(const GvdResult& gvd,
+                                            const std::vector<double>& radii,
+                                            const TopologyExtractor& extractor,
+                                            double resolution);
+
+} // namespace gvd_topo
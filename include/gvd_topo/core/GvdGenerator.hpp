@@ -1,17 +1,62 @@
 #pragma once
 
+#include "gvd_topo/core/PackedGrid.hpp"
 #include <vector>
 #include <cstdint>
 
 namespace gvd_topo {
 
 class OccupancyGrid;
+struct RunControl;
+
+// Box of map cells [x0, x1) x [y0, y1)
+struct Roi {
+    int x0 {0};
+    int y0 {0};
+    int x1 {0};
+    int y1 {0};
+
+    int width() const { return x1 - x0; }
+    int height() const { return y1 - y0; }
+    bool empty() const { return x0 >= x1 || y0 >= y1; }
+    Roi grown(int cells) const { return {x0 - cells, y0 - cells, x1 + cells, y1 + cells}; }
+    Roi clippedTo(int width, int height) const;
+
+    // Cells overlapping the map-frame box [min_x, max_x] x [min_y, max_y]
+    // (meters, relative to grid.origin as in the map YAML)
+    static Roi fromWorld(const OccupancyGrid& grid, double min_x, double min_y, double max_x, double max_y);
+};
 
 struct GvdResult {
     int width {0};
     int height {0};
     std::vector<float> distance; // EDT result, row-major
     std::vector<uint8_t> gvd_mask; // 0/255 skeleton mask
+    int scale {1};        // input cells per result cell side; > 1 for an anytime fallback
+    bool complete {true}; // false when a deadline cut the full-resolution run short
+    int offset_x {0};     // map cell of result cell (0, 0); non-zero for an ROI run
+    int offset_y {0};
+};
+
+// GvdResult with the skeleton at 1 bit per cell
+struct PackedGvdResult {
+    int width {0};
+    int height {0};
+    std::vector<float> distance;
+    PackedMask gvd_mask;
+};
+
+// Producer of consecutive row bands of cell values (Cell encoding), used to
+// overlap map decoding with the first EDT pass
+class RowBandSource {
+public:
+    virtual ~RowBandSource() = default;
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+    virtual double resolution() const = 0;
+    // Writes up to max_rows full rows into cells (row-major, width() per row)
+    // and returns the number of rows written; 0 once the map is exhausted
+    virtual int readBand(int8_t* cells, int max_rows) = 0;
 };
 
 class GvdGenerator {
@@ -19,17 +64,55 @@ public:
     struct Params {
         int occ_threshold {50};
         int morph_kernel {0}; // 0 means none
+        // cv::distanceTransform (3x3 mask) when built with OpenCV. runStreaming,
+        // runPacked and ROI runs always take the exact native EDT, so they
+        // match run() only when this is false or OpenCV is unavailable
+        bool use_opencv {true};
+        int stream_band_rows {256}; // rows per band in runStreaming
+        bool parallel {true};   // loops run on ThreadPool::shared()
+        int max_threads {0};    // 0 = whole shared pool
+        int anytime_factor {4}; // coarse fallback level: input cells per side
     };
 
     GvdGenerator();
     explicit GvdGenerator(const Params& p);
 
+    void setParams(const Params& p) { params_ = p; }
+    const Params& params() const { return params_; }
+    // Whether run() takes the OpenCV EDT: requested and built with OpenCV
+    static bool usesOpenCvEdt(const Params& p);
+
     GvdResult run(const OccupancyGrid& grid) const;
 
+    // run() polling control.token between row bands. A stop throws Cancelled,
+    // or in anytime mode returns a coarse level (scale = anytime_factor,
+    // complete = false) computed up front. Native path only; the OpenCV EDT
+    // is checked before it starts.
+    GvdResult run(const OccupancyGrid& grid, const RunControl& control) const;
+
+    // run() limited to roi (clipped to the grid): the result covers the ROI
+    // only, placed by offset_x / offset_y. The native EDT runs over the ROI
+    // plus a margin, widened until no distance in the ROI could be shortened
+    // by an obstacle outside it, so distances and skeleton match the native
+    // run() on the whole map, at a cost that follows the ROI area, not the map.
+    GvdResult run(const OccupancyGrid& grid, const Roi& roi) const;
+
+    // Native exact EDT only (meters, row-major), without ridge detection.
+    // Cells with no obstacle anywhere get a value beyond any in-grid distance.
+    std::vector<float> distanceField(const OccupancyGrid& grid) const;
+
+    // Decodes the map band by band while the row-wise EDT pass consumes the
+    // previous band; the source raster is never held in full. Matches run()
+    // whenever run() uses the native EDT. grid_out, when given, receives the
+    // decoded cells (needed only for overlays).
+    GvdResult runStreaming(RowBandSource& source, OccupancyGrid* grid_out = nullptr) const;
+
+    // Packed input and output, always with the native EDT. Cells are unpacked
+    // one row at a time, so no byte-per-cell buffer is ever allocated.
+    PackedGvdResult runPacked(const PackedOccupancy& grid) const;
+
 private:
     Params params_;
 };
 
 } // namespace gvd_topo
-
-
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gvd_topo {
+
+// Occupancy at 2 bits per cell (4x smaller than OccupancyGrid::data).
+// Codes: 0 free, 1 occupied (== Cell::Occupied), 2 unknown (negative values).
+// Graded values 1..99 pack as free, matching how the EDT treats them.
+// Rows are padded to whole 64-bit words so a row never shares a word.
+class PackedOccupancy {
+public:
+    static constexpr int kCellsPerWord = 32;
+    static constexpr uint64_t kFree = 0;
+    static constexpr uint64_t kOccupied = 1;
+    static constexpr uint64_t kUnknown = 2;
+
+    int width {0};
+    int height {0};
+    double resolution {0.05};
+    Origin2D origin {};
+    std::vector<uint64_t> words; // row-major, wordsPerRow() per row
+
+    PackedOccupancy() = default;
+    PackedOccupancy(int w, int h, double res); // all unknown, like OccupancyGrid
+
+    static PackedOccupancy fromGrid(const OccupancyGrid& grid);
+    OccupancyGrid toGrid() const;
+
+    bool empty() const { return width <= 0 || height <= 0 || words.empty(); }
+    size_t wordsPerRow() const { return (static_cast<size_t>(width) + kCellsPerWord - 1) / kCellsPerWord; }
+    const uint64_t* row(int y) const { return words.data() + static_cast<size_t>(y) * wordsPerRow(); }
+    uint64_t* row(int y) { return words.data() + static_cast<size_t>(y) * wordsPerRow(); }
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+
+    Cell get(int x, int y) const;
+    void set(int x, int y, Cell c);
+
+    // Word-parallel conversion of one row to and from Cell values
+    void unpackRow(int y, int8_t* out) const;
+    void packRow(int y, const int8_t* in);
+};
+
+// Binary mask at 1 bit per cell (8x smaller than a 0/255 byte mask).
+// Bit x % 64 of word x / 64 in each row; rows padded to whole words.
+class PackedMask {
+public:
+    int width {0};
+    int height {0};
+    std::vector<uint64_t> words;
+
+    PackedMask() = default;
+    PackedMask(int w, int h); // all clear
+
+    // Any non-zero byte counts as set
+    static PackedMask fromBytes(const std::vector<uint8_t>& mask, int w, int h);
+    std::vector<uint8_t> toBytes() const; // 0/255, GvdResult::gvd_mask layout
+
+    size_t wordsPerRow() const { return (static_cast<size_t>(width) + 63) / 64; }
+    const uint64_t* row(int y) const { return words.data() + static_cast<size_t>(y) * wordsPerRow(); }
+    uint64_t* row(int y) { return words.data() + static_cast<size_t>(y) * wordsPerRow(); }
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+
+    bool test(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1u; }
+    void set(int x, int y) { row(y)[x >> 6] |= uint64_t(1) << (x & 63); }
+    void reset(int x, int y) { row(y)[x >> 6] &= ~(uint64_t(1) << (x & 63)); }
+    size_t count() const; // set bits
+
+    void unpackRow(int y, uint8_t* out) const; // 0/255
+    void packRow(int y, const uint8_t* in);
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gvd_topo {
+
+struct SweepResult {
+    TopologyExtractor::Params params;
+    size_t node_count {0};
+    size_t edge_count {0};
+    double elapsed_ms {0.0};
+    TopologicalMap map; // only filled when SweepOptions::keep_maps is set
+};
+
+struct SweepOptions {
+    bool keep_maps {false};
+    bool parallel {true}; // combinations run on ThreadPool::shared()
+    int max_threads {0};  // 0 = whole shared pool
+};
+
+// "0.1,0.2,0.5" (list) or "0.1:1.0:0.1" (inclusive start:stop:step)
+std::vector<double> parseSweepValues(const std::string& spec);
+
+// Cartesian product of prune lengths and merge radii on top of `base`.
+// An empty list keeps the base value for that parameter.
+std::vector<TopologyExtractor::Params> makeSweepGrid(const std::vector<double>& prune_min_lengths,
+                                                     const std::vector<double>& merge_radii,
+                                                     const TopologyExtractor::Params& base = TopologyExtractor::Params{});
+
+// Runs every parameter set against the same GvdResult in parallel
+std::vector<SweepResult> runParameterSweep(const GvdResult& gvd,
+                                           const std::vector<TopologyExtractor::Params>& params,
+                                           double resolution,
+                                           const SweepOptions& options = SweepOptions{});
+
+// One row per combination: prune, merge, nodes, edges, ms
+void printSweepSummary(std::ostream& os, const std::vector<SweepResult>& results);
+
+} // namespace gvd_topo
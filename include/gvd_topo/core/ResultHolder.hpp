@@ -0,0 +1,23 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/utils/SnapshotHolder.hpp"
+
+namespace gvd_topo {
+
+// One published pipeline result; immutable once handed to the holder
+struct ResultSnapshot {
+    GvdResult gvd;
+    TopologicalMap map;
+};
+
+// In-process counterpart of SharedResultPublisher: planner threads pin the
+// latest distance field and topology while the next one is computed, e.g.
+//   ResultHolder holder;
+//   holder.publish({std::move(gvd), std::move(map)});          // producer
+//   auto reader = holder.reader();                              // per thread
+//   if (auto s = reader.pin()) plan(s->map, s->gvd.distance);   // no locks
+using ResultHolder = SnapshotHolder<ResultSnapshot>;
+
+} // namespace gvd_topo
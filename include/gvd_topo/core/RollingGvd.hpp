@@ -0,0 +1,126 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gvd_topo {
+
+class OccupancyGrid;
+
+// Robot-centric GVD and topology over a fixed-size window of a larger map.
+// Buffers are circular (cell (x, y) lives at slot (x mod W, y mod H)), so a
+// shift reuses the overlap in place and only the newly exposed strips are
+// computed. Distances are capped at max_distance, which bounds how far an
+// obstacle can influence a cell: a strip's EDT reads the map only within that
+// margin, and the overlap's distances never change. Ridges and skeleton nodes
+// are refreshed in a band around the strips, and the skeleton components
+// reaching it are retraced; edges elsewhere are kept. The topology equals
+// that of a fresh RollingGvd at the same pose. Obstacles outside the window (within the cap) count, unlike cropping;
+// cells outside the map are free. Coordinates are map cells * resolution,
+// as in TopologyExtractor::run on the whole map.
+class RollingGvd {
+public:
+    struct Params {
+        int window_width {400};     // cells (20 m at 0.05 m)
+        int window_height {400};
+        double max_distance {2.0};  // EDT cap in meters; no ridges where it saturates
+        double prune_min_length {0.1};
+        double merge_radius {0.05};
+        bool parallel {true};       // strip EDTs run on ThreadPool::shared()
+        int max_threads {0};
+    };
+
+    struct UpdateStats {
+        bool full {false};              // first update or a jump beyond the window
+        size_t cells_computed {0};      // EDT cells in exposed strips
+        size_t cells_refreshed {0};     // cells whose ridge / node status was re-evaluated
+        size_t edges_kept {0};
+        size_t edges_traced {0};
+    };
+
+    // map must outlive this object and stay unchanged
+    RollingGvd(const OccupancyGrid& map, const Params& params);
+
+    // Centres the window on a map-frame position (meters) or a map cell
+    const UpdateStats& moveTo(double x, double y);
+    const UpdateStats& moveToCell(int cx, int cy);
+
+    int originX() const { return origin_x_; } // map cell of window cell (0, 0)
+    int originY() const { return origin_y_; }
+    const UpdateStats& lastUpdate() const { return stats_; }
+
+    // Window contents, row-major from the origin (copies); the GvdResult's
+    // offset is the origin, so TopologyExtractor places it in the map
+    GvdResult gvd() const;
+    TopologicalMap topology() const;
+
+private:
+    struct Rect {
+        int x0, y0, x1, y1; // map cells, half-open
+        bool empty() const { return x0 >= x1 || y0 >= y1; }
+    };
+    struct Node {
+        int x {0};
+        int y {0};
+        bool traced {false};          // dead end created while tracing; lives with its edges
+        std::vector<int> edges;       // incident edge ids
+        std::vector<std::pair<int,int>> members; // raw skeleton nodes merged into it
+    };
+    struct Edge {
+        int u {0};
+        int v {0};
+        int dir {0};        // neighbour of u's start cell it leaves by, 0..7
+        bool ghost {false}; // walk that looped back to its start: visited, not output
+        double length {0.0};
+        float min_clearance {0.0f};
+        double clearance_sum {0.0};
+        std::vector<std::pair<int,int>> cells;
+    };
+
+    const OccupancyGrid& map_;
+    Params params_;
+    GvdGenerator edt_;
+    int w_;
+    int h_;
+    float cap_;
+    int margin_;       // EDT margin in cells
+    int merge_cells_;  // merge_radius in cells, rounded up
+    bool initialised_ {false};
+    int origin_x_ {0};
+    int origin_y_ {0};
+    UpdateStats stats_;
+
+    // Circular buffers, one entry per window cell
+    std::vector<float> dist_;
+    std::vector<uint8_t> mask_;
+    std::vector<uint8_t> raw_;       // skeleton endpoint / junction
+    std::vector<int32_t> cluster_;   // node id of a raw cell's cluster, -1 if none
+    std::vector<int32_t> label_;     // node id whose position is this cell, -1 if none
+    std::vector<int32_t> edge_of_;   // edge id tracing visited this cell, -1 if none
+    std::vector<uint8_t> flood_;     // skeleton component scratch, all zero between updates
+
+    std::unordered_map<int, Node> nodes_;
+    std::unordered_map<int, Edge> edges_;
+    int next_node_ {0};
+    int next_edge_ {0};
+
+    size_t slot(int x, int y) const;
+    bool inWindow(int x, int y) const;
+    Rect window() const { return {origin_x_, origin_y_, origin_x_ + w_, origin_y_ + h_}; }
+    Rect clip(Rect r) const;
+
+    void computeDistances(const Rect& r);
+    bool isRidge(int x, int y) const;
+    bool onSkeleton(int x, int y) const { return inWindow(x, y) && mask_[slot(x, y)]; }
+    void dropEdge(int id, std::vector<int>& doomed_nodes, std::vector<int>& reseed);
+    void dropNode(int id, std::vector<int>& doomed_edges, std::vector<std::pair<int,int>>& orphans);
+    std::pair<int,int> startCell(const Node& node) const;
+    void trace(int node_id);
+};
+
+} // namespace gvd_topo
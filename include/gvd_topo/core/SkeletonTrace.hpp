@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace gvd_topo {
+
+// Building blocks shared by TopologyExtractor and RollingGvd, so a rolling
+// window and a whole-map extraction merge, walk and prune the same way.
+// Skeleton arguments are callables (x, y) -> bool, false outside the grid.
+namespace skeleton {
+
+constexpr int kDx8[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+constexpr int kDy8[8] = { -1,-1,-1,  0, 0,  1, 1, 1 };
+
+template <typename Skeleton>
+int degree(const Skeleton& skel, int x, int y) {
+    int deg = 0;
+    for (int k = 0; k < 8; ++k) {
+        if (skel(x + kDx8[k], y + kDy8[k])) ++deg;
+    }
+    return deg;
+}
+
+// Endpoint or junction
+template <typename Skeleton>
+bool isRawNode(const Skeleton& skel, int x, int y) {
+    if (!skel(x, y)) return false;
+    const int deg = degree(skel, x, y);
+    return deg == 1 || deg >= 3;
+}
+
+struct NodeGroup {
+    int x {0};                 // rounded centroid of the members
+    int y {0};
+    std::vector<int> members;  // indices into the merged cells
+};
+
+// Union of cells within radius_px of each other. Groups come out row-major by
+// centroid (ties in order of their first member), the order nodes are traced
+// in. stop() is polled every 64 cells; stopping leaves nearby cells unmerged,
+// which is still a valid node set.
+template <typename Stop>
+std::vector<NodeGroup> mergeCells(const std::vector<std::pair<int,int>>& cells, double radius_px, Stop&& stop) {
+    const double r2 = radius_px * radius_px;
+    std::vector<int> parent(cells.size());
+    for (size_t i = 0; i < parent.size(); ++i) parent[i] = static_cast<int>(i);
+    auto findp = [&](int a) { while (parent[a] != a) a = parent[a] = parent[parent[a]]; return a; };
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (i % 64 == 0 && stop()) break;
+        for (size_t j = i + 1; j < cells.size(); ++j) {
+            const double dx = static_cast<double>(cells[i].first - cells[j].first);
+            const double dy = static_cast<double>(cells[i].second - cells[j].second);
+            if (dx * dx + dy * dy <= r2) {
+                const int a = findp(static_cast<int>(i));
+                const int b = findp(static_cast<int>(j));
+                if (a != b) parent[b] = a;
+            }
+        }
+    }
+    std::vector<int> group_of(cells.size(), -1);
+    std::vector<NodeGroup> groups;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        const int root = findp(static_cast<int>(i));
+        if (group_of[root] < 0) {
+            group_of[root] = static_cast<int>(groups.size());
+            groups.emplace_back();
+        }
+        groups[group_of[root]].members.push_back(static_cast<int>(i));
+    }
+    for (NodeGroup& g : groups) {
+        double sx = 0.0;
+        double sy = 0.0;
+        for (int m : g.members) {
+            sx += cells[m].first;
+            sy += cells[m].second;
+        }
+        g.x = static_cast<int>(std::round(sx / static_cast<double>(g.members.size())));
+        g.y = static_cast<int>(std::round(sy / static_cast<double>(g.members.size())));
+    }
+    std::stable_sort(groups.begin(), groups.end(), [](const NodeGroup& a, const NodeGroup& b) {
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    return groups;
+}
+
+inline std::vector<NodeGroup> mergeCells(const std::vector<std::pair<int,int>>& cells, double radius_px) {
+    return mergeCells(cells, radius_px, []() { return false; });
+}
+
+// Where tracing from a node starts: the node's cell, or the nearest skeleton
+// cell within 3 when the merged position is off the skeleton
+template <typename Skeleton>
+std::pair<int,int> startCell(const Skeleton& skel, int x, int y) {
+    if (skel(x, y)) return {x, y};
+    int best_x = x, best_y = y, best_dist = 1000;
+    for (int dy = -3; dy <= 3; ++dy) {
+        for (int dx = -3; dx <= 3; ++dx) {
+            const int d = dx * dx + dy * dy;
+            if (skel(x + dx, y + dy) && d < best_dist) {
+                best_dist = d;
+                best_x = x + dx;
+                best_y = y + dy;
+            }
+        }
+    }
+    return {best_x, best_y};
+}
+
+enum class WalkEnd {
+    Node,     // reached another node's cell
+    DeadEnd,  // no unvisited skeleton neighbour left: a new node goes here
+    Loop,     // came back to the start cell; not an edge
+    TooLong,  // step limit hit; not an edge
+};
+
+struct Walk {
+    WalkEnd end {WalkEnd::TooLong};
+    int x {0};          // last cell visited
+    int y {0};
+    double length {0.0};
+};
+
+// Follows the skeleton from start (sx, sy) into its neighbour (nx, ny),
+// always to an unvisited neighbour other than the previous cell, until a node
+// or a dead end. visit(x, y) is called on every cell entered, start excluded;
+// visited(x, y) must report those cells.
+template <typename Skeleton, typename Visited, typename IsNode, typename Visit>
+Walk walk(const Skeleton& skel, const Visited& visited, const IsNode& is_node, Visit&& visit,
+          int sx, int sy, int nx, int ny, double resolution, long max_steps) {
+    Walk w;
+    int px = sx, py = sy, cx = nx, cy = ny;
+    for (long steps = 0; steps < max_steps; ++steps) {
+        visit(cx, cy);
+        w.x = cx;
+        w.y = cy;
+        if (cx == sx && cy == sy) {
+            w.end = WalkEnd::Loop;
+            return w;
+        }
+        if (is_node(cx, cy)) {
+            w.end = WalkEnd::Node;
+            return w;
+        }
+        int next_x = -1, next_y = -1, choices = 0;
+        for (int k = 0; k < 8; ++k) {
+            const int tx = cx + kDx8[k];
+            const int ty = cy + kDy8[k];
+            if (!skel(tx, ty) || (tx == px && ty == py) || visited(tx, ty)) continue;
+            ++choices;
+            next_x = tx;
+            next_y = ty;
+        }
+        if (choices == 0) {
+            w.end = WalkEnd::DeadEnd;
+            return w;
+        }
+        w.length += std::hypot(static_cast<double>(next_x - cx) * resolution,
+                               static_cast<double>(next_y - cy) * resolution);
+        px = cx; py = cy; cx = next_x; cy = next_y;
+    }
+    w.end = WalkEnd::TooLong;
+    return w;
+}
+
+// Pruning rule: a short edge whose ends are both dead ends (degree counts
+// incident edges, a self-loop once)
+inline bool prunable(double length, double min_length, int degree_u, int degree_v) {
+    return length < min_length && degree_u <= 1 && degree_v <= 1;
+}
+
+} // namespace skeleton
+
+} // namespace gvd_topo
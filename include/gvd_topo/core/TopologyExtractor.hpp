@@ -19,29 +19,79 @@ struct TopoEdge {
     int v {0};
     double length {0.0};
     std::vector<std::pair<double,double>> polyline; // optional geometry
+    // Distance to the nearest obstacle along the polyline (meters); filled
+    // when the extractor is given the distance field
+    double min_clearance {0.0};
+    double mean_clearance {0.0};
+    std::vector<float> clearance; // per polyline point, optional
+    // Runs into the border of a GVD covering part of the map (an ROI run):
+    // the skeleton continues outside, and v is where it was cut
+    bool clipped {false};
 };
 
 struct TopologicalMap {
     std::vector<TopoNode> nodes;
     std::vector<TopoEdge> edges;
+    bool has_clearance {false}; // edges carry clearance statistics
+    // False for an anytime result: built from a coarse GVD, or tracing was
+    // stopped (edges are then unpruned and only some seeds were traced)
+    bool complete {true};
 };
 
+struct GvdResult;
+struct PackedGvdResult;
+struct Roi;
+class PackedMask;
+struct RunControl;
+
 class TopologyExtractor {
 public:
     struct Params {
         double prune_min_length {0.1};
         double merge_radius {0.05};
         double resolution {0.05};
+        bool record_clearance_profile {false}; // keep per-point clearance
+        bool parallel {true}; // scans run on ThreadPool::shared()
+        int max_threads {0};  // 0 = whole shared pool
     };
 
     TopologyExtractor();
     explicit TopologyExtractor(const Params& p);
 
     void setParams(const Params& p) { params_ = p; }
+    const Params& params() const { return params_; }
     TopologicalMap run(const std::vector<uint8_t>& gvd_mask, int width, int height, double resolution) const;
+    // Also records per-edge clearance from the EDT while tracing
+    TopologicalMap run(const std::vector<uint8_t>& gvd_mask, const std::vector<float>& distance,
+                       int width, int height, double resolution) const;
+    // resolution is the input grid's; a coarse GVD (scale > 1) is rescaled,
+    // and an ROI GVD is placed in map coordinates by its offset
+    TopologicalMap run(const GvdResult& gvd, double resolution) const;
+    // Same, tracing gvd_mask (gvd's size, e.g. a clearance-filtered copy of
+    // its skeleton) in place of gvd.gvd_mask
+    TopologicalMap run(const GvdResult& gvd, const std::vector<uint8_t>& gvd_mask, double resolution) const;
+    // Traces only the part of gvd inside roi (map cells), at a cost that
+    // follows the ROI area; edges leaving it are cut and marked clipped
+    TopologicalMap run(const GvdResult& gvd, double resolution, const Roi& roi) const;
+    // Polls control.token between scan bands and traced seeds. A stop throws
+    // Cancelled, or in anytime mode returns the map built so far. A coarse
+    // GVD (an anytime fallback) is always traced in full.
+    TopologicalMap run(const GvdResult& gvd, double resolution, const RunControl& control) const;
+    // Bit-packed skeleton, read in place; distance may be null
+    TopologicalMap run(const PackedMask& gvd_mask, const float* distance, double resolution) const;
+    TopologicalMap run(const PackedGvdResult& gvd, double resolution) const;
+    TopologicalMap run(const PackedGvdResult& gvd, double resolution, const RunControl& control) const;
 
 private:
     Params params_;
+
+    // Skeleton is a callable (x, y) -> bool over the mask representation;
+    // offset_x / offset_y place cell (0, 0) in the map
+    template <typename Skeleton>
+    TopologicalMap extract(const Skeleton& skel, const float* distance,
+                           int width, int height, double resolution,
+                           int offset_x = 0, int offset_y = 0,
+                           const RunControl* control = nullptr) const;
 };
 
 // Minimal JSON serialization
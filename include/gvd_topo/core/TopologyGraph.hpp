@@ -0,0 +1,136 @@
+#pragma once
+
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gvd_topo {
+
+class TopologyOverlay;
+
+// A point on the graph: a node, or an arc-length position along an edge.
+// Indices refer to TopologyGraph storage, not to TopoNode::id / TopoEdge::id.
+struct GraphLocation {
+    int node {-1};              // node index when snapped onto a node
+    int edge {-1};              // edge index when snapped onto an edge
+    double fraction {0.0};      // 0 at the edge's u end, 1 at its v end
+    double snap_distance {0.0}; // distance from the query point to the graph
+    bool valid() const { return node >= 0 || edge >= 0; }
+};
+
+// Immutable routing view of a TopologicalMap: CSR adjacency plus flattened
+// edge geometry for snapping. Rebuild it whenever the map changes.
+class TopologyGraph {
+public:
+    struct Arc {
+        int to {0};
+        int edge {0};
+    };
+
+    TopologyGraph() = default;
+    explicit TopologyGraph(const TopologicalMap& map);
+
+    int nodeCount() const { return static_cast<int>(node_x_.size()); }
+    int edgeCount() const { return static_cast<int>(edge_u_.size()); }
+
+    // -1 if the id is not present in the map
+    int nodeIndex(int node_id) const;
+    int edgeIndex(int edge_id) const;
+    int nodeId(int index) const { return node_ids_[index]; }
+    int edgeId(int index) const { return edge_ids_[index]; }
+
+    double nodeX(int index) const { return node_x_[index]; }
+    double nodeY(int index) const { return node_y_[index]; }
+    int edgeU(int index) const { return edge_u_[index]; }
+    int edgeV(int index) const { return edge_v_[index]; }
+    double edgeLength(int index) const { return edge_length_[index]; }
+
+    // Edge geometry from u to v (node positions included at both ends)
+    std::pair<const double*, size_t> edgeGeometry(int index) const;
+
+    const Arc* arcsBegin(int node) const { return arcs_.data() + arc_offsets_[node]; }
+    const Arc* arcsEnd(int node) const { return arcs_.data() + arc_offsets_[node + 1]; }
+
+    // Nearest point on any edge (or isolated node) to (x, y)
+    GraphLocation snap(double x, double y) const;
+    std::vector<GraphLocation> snap(const std::vector<std::pair<double,double>>& points) const;
+
+    // Content hash of nodes and edges; changes whenever the source map does
+    uint64_t fingerprint() const { return fingerprint_; }
+
+private:
+    std::vector<int> node_ids_;
+    std::vector<double> node_x_;
+    std::vector<double> node_y_;
+    std::vector<int> edge_ids_;
+    std::vector<int> edge_u_;
+    std::vector<int> edge_v_;
+    std::vector<double> edge_length_;
+    std::vector<size_t> geom_offsets_; // into geom_ (x,y interleaved), size edges+1
+    std::vector<double> geom_;
+    std::vector<size_t> arc_offsets_;  // size nodes+1
+    std::vector<Arc> arcs_;
+    std::vector<int> node_index_by_id_; // dense id -> index lookup
+    std::vector<int> edge_index_by_id_;
+    uint64_t fingerprint_ {0};
+};
+
+struct DistanceMatrixOptions {
+    bool compute_predecessors {false};
+    bool use_parallel {true};
+    int max_threads {0}; // 0 = auto-detect
+    const TopologyOverlay* overlay {nullptr}; // blocked/scaled edges, optional
+};
+
+// Row-major sources x targets matrix of shortest-path lengths along the graph.
+// Unreachable pairs hold +infinity.
+struct DistanceMatrix {
+    size_t rows {0};
+    size_t cols {0};
+    std::vector<double> values;
+    // Optional shortest-path tree per source: predecessors[row][node] is the
+    // edge index used to reach that node, -1 at tree roots and unreachable nodes.
+    std::vector<std::vector<int>> predecessors;
+
+    double at(size_t row, size_t col) const { return values[row * cols + col]; }
+};
+
+// One Dijkstra per source, run in parallel across sources.
+DistanceMatrix computeDistanceMatrix(const TopologyGraph& graph,
+                                     const std::vector<GraphLocation>& sources,
+                                     const std::vector<GraphLocation>& targets,
+                                     const DistanceMatrixOptions& options = DistanceMatrixOptions{});
+
+struct GraphPath {
+    double cost {0.0};     // +infinity when unreachable
+    std::vector<int> edges; // edge indices in travel order
+};
+
+// Point-to-point query; honours the overlay when one is given
+GraphPath shortestPath(const TopologyGraph& graph, const GraphLocation& from, const GraphLocation& to,
+                       const TopologyOverlay* overlay = nullptr);
+
+// Edge indices from the search root to `node`, following a predecessor tree
+std::vector<int> tracePredecessors(const TopologyGraph& graph, const std::vector<int>& predecessors, int node);
+
+// Single-entry cache; recomputes when the graph fingerprint, the query
+// locations or the options change.
+class DistanceMatrixCache {
+public:
+    std::shared_ptr<const DistanceMatrix> get(const TopologyGraph& graph,
+                                              const std::vector<GraphLocation>& sources,
+                                              const std::vector<GraphLocation>& targets,
+                                              const DistanceMatrixOptions& options = DistanceMatrixOptions{});
+    void invalidate();
+
+private:
+    std::mutex mutex_;
+    uint64_t key_ {0};
+    std::shared_ptr<const DistanceMatrix> cached_;
+};
+
+} // namespace gvd_topo
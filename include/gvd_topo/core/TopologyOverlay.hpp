@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gvd_topo/core/TopologyGraph.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gvd_topo {
+
+using Polygon2D = std::vector<std::pair<double,double>>;
+
+// Temporary cost overlay on a TopologyGraph (closed doors, blocked aisles).
+// Changes are O(1) per element and take effect on the next query; the raster
+// pipeline is never re-run. The graph must outlive the overlay. Mutations are
+// not synchronised with concurrent queries.
+class TopologyOverlay {
+public:
+    explicit TopologyOverlay(const TopologyGraph& graph);
+
+    // By TopoEdge::id / TopoNode::id; return false for unknown ids
+    bool blockEdge(int edge_id);
+    bool unblockEdge(int edge_id);
+    bool blockNode(int node_id);
+    bool unblockNode(int node_id);
+    // Multiplies the edge's traversal cost; 1.0 restores it
+    bool scaleEdgeCost(int edge_id, double factor);
+
+    // World-space polygon in map coordinates; affects every edge whose
+    // geometry enters the polygon and every node inside it.
+    // Return the number of edges touched.
+    size_t blockPolygon(const Polygon2D& polygon);
+    size_t unblockPolygon(const Polygon2D& polygon);
+    size_t scalePolygon(const Polygon2D& polygon, double factor);
+
+    void clear();
+
+    const TopologyGraph& graph() const { return *graph_; }
+    // Cost multiplier by edge index: +inf when the edge or an endpoint is blocked
+    double edgeFactor(int edge_index) const;
+    bool edgeBlocked(int edge_index) const { return edge_blocked_[edge_index] != 0; }
+    bool nodeBlocked(int node_index) const { return node_blocked_[node_index] != 0; }
+    // Bumped on every change; used to invalidate cached query results
+    uint64_t revision() const { return revision_; }
+
+private:
+    const TopologyGraph* graph_;
+    std::vector<uint8_t> edge_blocked_;
+    std::vector<uint8_t> node_blocked_;
+    std::vector<double> edge_scale_;
+    uint64_t revision_ {0};
+
+    template <typename Fn>
+    size_t forEachInPolygon(const Polygon2D& polygon, Fn&& on_edge, bool nodes_blocked);
+};
+
+// Copy of `map` as seen through the overlay: blocked edges and nodes are
+// dropped and scaled edges report their effective cost as length, so exports
+// and marker adapters reflect the overlay without touching the map itself.
+TopologicalMap applyOverlay(const TopologicalMap& map, const TopologyOverlay& overlay);
+
+} // namespace gvd_topo
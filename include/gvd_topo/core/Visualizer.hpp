@@ -5,6 +5,9 @@
 
 namespace gvd_topo {
 
+class OccupancyGrid;
+struct GvdResult;
+
 struct VisualizationOptions {
     int image_width {800};
     int image_height {600};
@@ -29,6 +32,12 @@ public:
                                         const std::string& output_path,
                                         int image_width, int image_height,
                                         double scale_factor = 0.0);
+
+    // Grid cells with the GVD (red), edges (blue) and nodes (green) drawn on
+    // top; map coordinates are converted with `resolution`. Requires OpenCV.
+    static void saveGvdOverlay(const OccupancyGrid& grid, const GvdResult& gvd,
+                               const TopologicalMap& map, double resolution,
+                               const std::string& output_path);
 };
 
 } // namespace gvd_topo
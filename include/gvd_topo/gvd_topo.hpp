@@ -10,19 +10,42 @@
 
 // Core functionality
 #include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/PackedGrid.hpp"
 #include "gvd_topo/core/GvdGenerator.hpp"
 #include "gvd_topo/core/TopologyExtractor.hpp"
 #include "gvd_topo/core/Visualizer.hpp"
+#include "gvd_topo/core/TopologyGraph.hpp"
+#include "gvd_topo/core/TopologyOverlay.hpp"
+#include "gvd_topo/core/ClearanceFilter.hpp"
+#include "gvd_topo/core/ParameterSweep.hpp"
+#include "gvd_topo/core/RollingGvd.hpp"
+#include "gvd_topo/core/ResultHolder.hpp"
 
 // I/O functionality
 #include "gvd_topo/io/YamlLoader.hpp"
+#include "gvd_topo/io/MappedFile.hpp"
+#include "gvd_topo/io/PgmLoader.hpp"
+#include "gvd_topo/io/PgmStreamReader.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include "gvd_topo/io/JsonWriter.hpp"
+#include "gvd_topo/io/TopologyLoader.hpp"
+#include "gvd_topo/io/ResultCache.hpp"
+#include "gvd_topo/io/DistanceField.hpp"
+#include "gvd_topo/io/SharedResults.hpp"
+#include "gvd_topo/io/BatchLoader.hpp"
+#include "gvd_topo/io/AsyncOutputSink.hpp"
 
 // Utilities
 #include "gvd_topo/utils/Timer.hpp"
 #include "gvd_topo/utils/ConfigManager.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include "gvd_topo/utils/TaskGraph.hpp"
+#include "gvd_topo/utils/Cancellation.hpp"
+#include "gvd_topo/utils/SnapshotHolder.hpp"
 
 // CLI functionality
 #include "gvd_topo/cli/CliApplication.hpp"
+#include "gvd_topo/cli/DaemonServer.hpp"
 
 // ROS adapters (if available)
 #include "gvd_topo/ros_adapters.hpp"
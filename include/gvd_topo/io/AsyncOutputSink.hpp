@@ -0,0 +1,89 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/DistanceField.hpp"
+#include "gvd_topo/io/JsonWriter.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gvd_topo {
+
+class ThreadPool;
+
+// Files to produce from one result; empty paths are skipped
+struct OutputRequest {
+    std::string map_file;        // topology JSON
+    JsonWriteOptions json;
+    std::string map_binary_file; // TopologyBinary
+    std::string distance_file;
+    DistanceExportOptions distance;
+    std::string gvd_image;       // overlay, needs the grid (OpenCV)
+    std::string topo_image;      // Visualizer rendering (OpenCV)
+    int topo_image_width {1200};
+    int topo_image_height {800};
+    double resolution {0.05};    // map -> pixel scale of the overlay
+};
+
+enum class OutputKind { MapJson, MapBinary, DistanceField, GvdOverlay, TopologyImage };
+
+struct OutputResult {
+    OutputKind kind {OutputKind::MapJson};
+    std::string path;
+    std::string error;  // empty on success
+    double ms {0.0};
+    DistanceExportReport distance; // DistanceField only
+    bool ok() const { return error.empty(); }
+};
+
+// Outcome of one submit(), entries in OutputKind order
+struct OutputReport {
+    std::vector<OutputResult> outputs;
+    bool ok() const {
+        for (const auto& o : outputs) if (!o.ok()) return false;
+        return true;
+    }
+};
+
+// Writes outputs on a background pool so serialisation and image encoding
+// stay off the caller's critical path. The sink holds shared ownership of
+// the results until their files are written; each output of a request runs
+// as its own task. Call flush() (or destroy the sink) before exiting.
+class AsyncOutputSink {
+public:
+    using Callback = std::function<void(const OutputReport&)>;
+
+    explicit AsyncOutputSink(int threads = 2);
+    ~AsyncOutputSink(); // flushes
+    AsyncOutputSink(const AsyncOutputSink&) = delete;
+    AsyncOutputSink& operator=(const AsyncOutputSink&) = delete;
+
+    // grid may be null unless an overlay is requested. on_done, when given,
+    // runs on a pool thread before the future becomes ready.
+    std::future<OutputReport> submit(std::shared_ptr<const OccupancyGrid> grid,
+                                     std::shared_ptr<const GvdResult> gvd,
+                                     std::shared_ptr<const TopologicalMap> map,
+                                     OutputRequest request,
+                                     Callback on_done = Callback{});
+
+    // Blocks until every submitted request has completed
+    void flush();
+    size_t pending() const;
+
+private:
+    std::unique_ptr<ThreadPool> pool_;
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+    size_t pending_ {0};
+
+    void finished();
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gvd_topo {
+
+struct BatchLoaderOptions {
+    int prefetch {4};             // maps read ahead of the one being consumed
+    int io_threads {2};           // pread fallback workers
+    bool use_io_uring {true};     // only honoured when built with io_uring support
+    double resolution {0.05};     // bare image inputs; YAML maps carry their own
+    int occupancy_threshold {50}; // bare image inputs and non-PGM YAML images
+};
+
+// One loaded map, delivered in input order
+struct BatchMap {
+    size_t index {0};
+    std::string path;        // as given: YAML or image
+    std::string image_path;
+    OccupancyGrid grid;
+    std::string error;       // set when loading failed; grid is then empty
+    size_t bytes {0};        // image file size
+    double read_ms {0.0};    // read submission to completion
+    double parse_ms {0.0};
+    bool ok() const { return error.empty(); }
+};
+
+// Prefetching loader for many maps. Up to `prefetch` image files are read
+// asynchronously (io_uring on Linux, else pread on a small thread pool) while
+// the caller works on the current map; each read lands in a buffer that the
+// native PGM parser thresholds in place. Non-PGM images fall back to
+// OccupancyGrid::loadFromImage. next() is not thread-safe.
+class BatchLoader {
+public:
+    explicit BatchLoader(std::vector<std::string> paths, const BatchLoaderOptions& options = BatchLoaderOptions{});
+    ~BatchLoader();
+    BatchLoader(const BatchLoader&) = delete;
+    BatchLoader& operator=(const BatchLoader&) = delete;
+
+    // Blocks until the next map is loaded; false once all are consumed.
+    // Per-map failures are reported through BatchMap::error, not thrown.
+    bool next(BatchMap& out);
+
+    size_t size() const;
+    const char* backend() const; // "io_uring" or "pread"
+
+    // Map list from a directory (its map YAMLs plus PGMs no YAML there
+    // refers to, sorted) or from a manifest file (one path per line, '#'
+    // comments, relative to the manifest). Throws std::runtime_error.
+    static std::vector<std::string> collectInputs(const std::string& dir_or_manifest);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/io/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gvd_topo {
+
+// On-disk encodings of GvdResult::distance (meters)
+enum class DistanceFormat : uint32_t {
+    Fixed16 = 1, // uint16 multiples of a quantum, saturating
+    Float16 = 2, // IEEE 754 half precision
+    Npy = 3      // NumPy .npy, float32, shape (height, width)
+};
+
+// "fixed16" / "float16" / "npy"; throws std::runtime_error otherwise
+DistanceFormat parseDistanceFormat(const std::string& name);
+const char* distanceFormatName(DistanceFormat format);
+
+struct DistanceExportOptions {
+    DistanceFormat format {DistanceFormat::Fixed16};
+    double quantum {0.001}; // meters per fixed16 step (1 mm covers 65.5 m)
+};
+
+struct DistanceExportReport {
+    double error_bound {0.0}; // guaranteed max abs error for unsaturated cells
+    double max_error {0.0};   // measured max abs error over the field
+    size_t saturated {0};     // cells clamped to the largest representable value
+    size_t bytes {0};         // file size
+};
+
+// Vectorised conversion kernels (F16C / compiler-vectorised loops)
+void quantizeFixed16(const float* src, uint16_t* dst, size_t n, double quantum);
+void dequantizeFixed16(const uint16_t* src, float* dst, size_t n, double quantum);
+void floatToHalf(const float* src, uint16_t* dst, size_t n);
+void halfToFloat(const uint16_t* src, float* dst, size_t n);
+
+// Throws std::runtime_error on I/O failure or an invalid quantum
+DistanceExportReport writeDistanceField(const GvdResult& gvd, const std::string& path,
+                                        const DistanceExportOptions& options = DistanceExportOptions{});
+
+// Zero-copy mmap reader for all three formats; the format is detected from
+// the file. Cells stay encoded until decoded.
+class MappedDistanceField {
+public:
+    explicit MappedDistanceField(const std::string& path); // throws std::runtime_error
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    size_t size() const { return static_cast<size_t>(width_) * static_cast<size_t>(height_); }
+    DistanceFormat format() const { return format_; }
+    double quantum() const { return quantum_; } // fixed16 only
+    // Element type of the raw cells: 2 bytes (fixed16, float16) or 4 (float32)
+    size_t elementSize() const { return element_size_; }
+    const void* raw() const { return cells_; }
+
+    float at(size_t index) const;
+    void decode(size_t begin, size_t count, float* dst) const;
+    std::vector<float> toVector() const;
+
+private:
+    MappedFile file_;
+    const void* cells_ {nullptr};
+    DistanceFormat format_ {DistanceFormat::Fixed16};
+    enum class Cells { Fixed16, Half, Single } cells_type_ {Cells::Fixed16}; // .npy may hold '<f2' too
+    size_t element_size_ {0};
+    int width_ {0};
+    int height_ {0};
+    double quantum_ {0.0};
+};
+
+} // namespace gvd_topo
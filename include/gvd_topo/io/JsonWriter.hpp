@@ -0,0 +1,26 @@
+#pragma once
+
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include <cstddef>
+#include <string>
+
+namespace gvd_topo {
+
+struct JsonWriteOptions {
+    int precision {6};               // significant digits; 6 matches iostream defaults
+    size_t buffer_bytes {1 << 20};   // write(2) granularity
+    size_t edges_per_chunk {256};    // unit of parallel formatting
+    bool parallel {true};            // chunks are formatted on ThreadPool::shared()
+    int max_threads {0};             // 0 = whole shared pool
+    bool trailing_newline {false};
+};
+
+// Serializes `map` in the toJson schema using std::to_chars. Edge chunks are
+// formatted in parallel and emitted in order through a large buffer, so
+// memory stays bounded by a few chunks regardless of map size.
+// Throws std::runtime_error on write failure.
+void writeTopologyJson(const TopologicalMap& map, int fd, const JsonWriteOptions& options = JsonWriteOptions{});
+void writeTopologyJson(const TopologicalMap& map, const std::string& path, const JsonWriteOptions& options = JsonWriteOptions{});
+std::string formatTopologyJson(const TopologicalMap& map, const JsonWriteOptions& options = JsonWriteOptions{});
+
+} // namespace gvd_topo
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gvd_topo {
+
+// Read-only memory mapping of a whole file (POSIX mmap). Move-only.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path); // throws std::runtime_error
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const uint8_t* data_ {nullptr};
+    size_t size_ {0};
+
+    void release();
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gvd_topo {
+
+// map_server style trinary thresholds (see MapInfo)
+struct PgmThreshold {
+    double occupied_thresh {0.65};
+    double free_thresh {0.196};
+    bool negate {false};
+};
+
+struct PgmHeader {
+    int width {0};
+    int height {0};
+    int maxval {255};
+    size_t data_offset {0}; // first raster byte
+};
+
+// Raw pixel -> Cell classification reduced to two byte bounds, so the
+// threshold is a pair of unsigned compares per pixel:
+//   v' = v ^ invert;  v' <= occupied_max -> Occupied,
+//   else v' >= free_min -> Free, else Unknown
+struct CellThresholds {
+    uint8_t invert {0};
+    uint8_t occupied_max {0};
+    uint8_t free_min {0};
+    bool any_occupied {true};
+    bool any_free {true};
+
+    static CellThresholds fromMapServer(const PgmThreshold& t, int maxval = 255);
+    // Legacy loadFromImage rule: v <= occ_threshold is occupied, everything else free
+    static CellThresholds fromBinary(int occ_threshold);
+};
+
+// Vectorised kernel: classifies n raw pixels into OccupancyGrid cell values
+void thresholdPixels(const uint8_t* src, int8_t* dst, size_t n, const CellThresholds& t);
+
+// Native binary P5 PGM reader; no OpenCV dependency
+class PgmLoader {
+public:
+    static bool isPgm(const std::string& path);
+    static bool isPgm(const uint8_t* data, size_t size);
+
+    // Throws std::runtime_error on malformed or truncated input. With
+    // require_raster false only the header itself has to be in the buffer.
+    static PgmHeader parseHeader(const uint8_t* data, size_t size, bool require_raster = true);
+
+    // Thresholds an in-memory P5 image straight into a grid (parallel row bands)
+    static OccupancyGrid fromBuffer(const uint8_t* data, size_t size, double resolution, const CellThresholds& t);
+
+    // mmap-backed loaders
+    static OccupancyGrid load(const std::string& path, double resolution, const PgmThreshold& t);
+    static OccupancyGrid load(const std::string& path, double resolution, int occ_threshold);
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/io/PgmLoader.hpp"
+#include <string>
+#include <vector>
+
+namespace gvd_topo {
+
+// Row-band reader for binary PGM files. Keeps only one band of raw bytes in
+// memory and thresholds it into cells as it goes; feed it to
+// GvdGenerator::runStreaming.
+class PgmStreamReader : public RowBandSource {
+public:
+    PgmStreamReader(const std::string& path, double resolution, const CellThresholds& thresholds);
+    ~PgmStreamReader() override;
+
+    PgmStreamReader(const PgmStreamReader&) = delete;
+    PgmStreamReader& operator=(const PgmStreamReader&) = delete;
+
+    int width() const override { return header_.width; }
+    int height() const override { return header_.height; }
+    double resolution() const override { return resolution_; }
+    int readBand(int8_t* cells, int max_rows) override;
+
+    int maxval() const { return header_.maxval; }
+    void setThresholds(const CellThresholds& thresholds) { thresholds_ = thresholds; }
+
+private:
+    int fd_ {-1};
+    PgmHeader header_ {};
+    double resolution_ {0.05};
+    CellThresholds thresholds_ {};
+    int next_row_ {0};
+    std::vector<uint8_t> raw_; // one band of source bytes
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gvd_topo {
+
+// Content-addressed on-disk cache of pipeline results. Entries are keyed by a
+// hash of the grid cells and every parameter that affects the output, and
+// hold the EDT, the bit-packed GVD mask and the topology (TopologyBinary
+// layout) in one file. The directory is kept under max_bytes by evicting the
+// least recently used entries; hits refresh an entry's modification time.
+// Writes go through a temporary file and rename, so several processes may
+// share a directory.
+class ResultCache {
+public:
+    struct Stats {
+        size_t hits {0};
+        size_t misses {0};
+        size_t stores {0};
+        size_t evictions {0};
+    };
+
+    ResultCache(const std::string& directory, uint64_t max_bytes);
+
+    static uint64_t makeKey(const OccupancyGrid& grid,
+                            const GvdGenerator::Params& gvd_params,
+                            const TopologyExtractor::Params& topo_params,
+                            double topology_resolution);
+
+    // False on a miss; unreadable or corrupt entries count as misses and are removed
+    bool load(uint64_t key, GvdResult& gvd, TopologicalMap& map);
+    // Failures are reported by exception; the cache itself stays consistent
+    void store(uint64_t key, const GvdResult& gvd, const TopologicalMap& map);
+
+    std::string entryPath(uint64_t key) const;
+    const Stats& stats() const { return stats_; }
+
+private:
+    std::string directory_;
+    uint64_t max_bytes_;
+    Stats stats_;
+
+    void evict(const std::string& keep);
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gvd_topo {
+
+namespace shared_results {
+struct Control;
+struct SlotHeader;
+} // namespace shared_results
+
+// Read-only, zero-copy view of one published result inside the segment.
+// Pointers stay valid until the publisher reuses the slot; see
+// SharedResultSubscriber::read for the consistency protocol.
+struct SharedSnapshot {
+    uint64_t generation {0};
+    int width {0};
+    int height {0};
+    const float* distance {nullptr};   // width*height, row-major
+    const uint8_t* gvd_mask {nullptr}; // width*height, 0/255
+    const uint8_t* topology_data {nullptr}; // TopologyBinary image
+    size_t topology_size {0};
+    TopologyBinaryView topology;       // over topology_data
+};
+
+// Single writer over a POSIX shared-memory segment (shm_open name, e.g.
+// "/gvd_topo"). Results go round-robin into a fixed number of slots, each
+// guarded by a seqlock: its sequence is odd while being written and
+// 2 * generation once complete. The newest complete generation is then
+// published, so readers never wait for the writer.
+class SharedResultPublisher {
+public:
+    // Creates (or re-creates) the segment; throws std::runtime_error on failure.
+    // slot_bytes bounds one serialized result, see requiredSlotBytes().
+    SharedResultPublisher(const std::string& name, size_t slot_bytes, int slot_count = 3,
+                          bool unlink_on_close = true);
+    ~SharedResultPublisher();
+    SharedResultPublisher(const SharedResultPublisher&) = delete;
+    SharedResultPublisher& operator=(const SharedResultPublisher&) = delete;
+
+    // Throws std::runtime_error if the result does not fit in a slot.
+    // Returns the generation number assigned to it.
+    uint64_t publish(const GvdResult& gvd, const TopologicalMap& map);
+
+    static size_t requiredSlotBytes(const GvdResult& gvd, const TopologicalMap& map);
+    const std::string& name() const { return name_; }
+
+private:
+    std::string name_;
+    bool unlink_on_close_;
+    uint8_t* base_ {nullptr};
+    size_t size_ {0};
+    shared_results::Control* control_ {nullptr};
+};
+
+// Maps the segment read-only; any number of processes may subscribe
+class SharedResultSubscriber {
+public:
+    explicit SharedResultSubscriber(const std::string& name); // throws std::runtime_error
+    ~SharedResultSubscriber();
+    SharedResultSubscriber(const SharedResultSubscriber&) = delete;
+    SharedResultSubscriber& operator=(const SharedResultSubscriber&) = delete;
+
+    // Newest complete generation, 0 before the first publication
+    uint64_t latestGeneration() const;
+
+    // Seqlock read: calls fn(const SharedSnapshot&) on the newest result and
+    // returns true once a call has observed a snapshot the writer did not touch
+    // meanwhile. fn may run more than once (torn attempts are discarded), so it
+    // should only read or copy. Returns false if nothing has been published.
+    template <typename Fn>
+    bool read(Fn&& fn) const {
+        SharedSnapshot snap;
+        for (;;) {
+            const int state = begin(snap);
+            if (state == kEmpty) return false;
+            if (state == kRetry) continue;
+            fn(static_cast<const SharedSnapshot&>(snap));
+            if (validate(snap)) return true;
+        }
+    }
+
+    // Unvalidated access for callers that run their own check: take the
+    // snapshot, use it, then ask whether it is still intact
+    bool acquire(SharedSnapshot& snap) const;
+    bool validate(const SharedSnapshot& snap) const;
+
+    // Owning copies of a consistent snapshot; false before the first publication
+    bool copyLatest(GvdResult& gvd, TopologicalMap& map, uint64_t* generation = nullptr) const;
+
+private:
+    static constexpr int kReady = 0;
+    static constexpr int kRetry = 1;
+    static constexpr int kEmpty = 2;
+
+    const uint8_t* base_ {nullptr};
+    size_t size_ {0};
+    const shared_results::Control* control_ {nullptr};
+
+    int begin(SharedSnapshot& snap) const;
+};
+
+} // namespace gvd_topo
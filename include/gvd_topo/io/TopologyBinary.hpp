@@ -0,0 +1,124 @@
+#pragma once
+
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gvd_topo {
+
+// Versioned binary TopologicalMap layout, designed to be used in place:
+//   header | node array | edge array | polyline points (x,y doubles) | clearance floats
+// All sections are 8-byte aligned and stored in host byte order (checked on load).
+namespace topo_binary {
+
+constexpr char kMagic[8] = {'G','V','D','T','O','P','O','\0'};
+// 2: kFlagIncomplete. 3: kEdgeClipped. Readers accept every version from
+// kMinVersion up, since older writers left the newer bits zero, and reject
+// flags they do not know.
+constexpr uint32_t kVersion = 3;
+constexpr uint32_t kMinVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+constexpr uint32_t kFlagHasClearance = 1u << 0;
+constexpr uint32_t kFlagIncomplete = 1u << 1; // anytime result (TopologicalMap::complete)
+constexpr uint32_t kKnownFlags = kFlagHasClearance | kFlagIncomplete;
+constexpr int32_t kEdgeClipped = 1 << 0;       // Edge::flags bit (TopoEdge::clipped)
+constexpr int32_t kKnownEdgeFlags = kEdgeClipped;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t node_count;
+    uint64_t edge_count;
+    uint64_t point_count;
+    uint64_t clearance_count;
+    uint64_t nodes_offset;
+    uint64_t edges_offset;
+    uint64_t points_offset;
+    uint64_t clearance_offset;
+    uint64_t total_size;
+};
+
+struct Node {
+    int32_t id;
+    int32_t reserved;
+    double x;
+    double y;
+};
+
+struct Edge {
+    int32_t id;
+    int32_t u;
+    int32_t v;
+    int32_t flags; // kEdge* bits
+    double length;
+    double min_clearance;
+    double mean_clearance;
+    uint64_t point_offset;     // index into the point array
+    uint64_t point_count;
+    uint64_t clearance_offset; // index into the clearance array
+    uint64_t clearance_count;
+};
+
+struct Point {
+    double x;
+    double y;
+};
+
+} // namespace topo_binary
+
+// Size in bytes of the serialized form of `map`
+size_t topologyBinarySize(const TopologicalMap& map);
+// Serializes into dst, which must hold topologyBinarySize(map) bytes
+void serializeTopologyBinary(const TopologicalMap& map, uint8_t* dst);
+std::vector<uint8_t> serializeTopologyBinary(const TopologicalMap& map);
+// Throws std::runtime_error on I/O failure
+void writeTopologyBinary(const TopologicalMap& map, const std::string& path);
+
+// Zero-copy, bounds-checked view over a serialized map. The buffer must stay
+// alive and unchanged for the lifetime of the view.
+class TopologyBinaryView {
+public:
+    TopologyBinaryView() = default;
+    // Throws std::runtime_error if the buffer is not a valid topology image
+    TopologyBinaryView(const uint8_t* data, size_t size);
+
+    size_t nodeCount() const { return header_ ? header_->node_count : 0; }
+    size_t edgeCount() const { return header_ ? header_->edge_count : 0; }
+    bool hasClearance() const { return header_ && (header_->flags & topo_binary::kFlagHasClearance); }
+    bool complete() const { return !header_ || !(header_->flags & topo_binary::kFlagIncomplete); }
+
+    const topo_binary::Node* nodes() const { return nodes_; }
+    const topo_binary::Edge* edges() const { return edges_; }
+    // Geometry of one edge, validated at construction
+    const topo_binary::Point* edgePoints(size_t edge) const { return points_ + edges_[edge].point_offset; }
+    const float* edgeClearance(size_t edge) const { return clearance_ + edges_[edge].clearance_offset; }
+
+    // Materialises an owning copy
+    TopologicalMap toMap() const;
+
+private:
+    const topo_binary::Header* header_ {nullptr};
+    const topo_binary::Node* nodes_ {nullptr};
+    const topo_binary::Edge* edges_ {nullptr};
+    const topo_binary::Point* points_ {nullptr};
+    const float* clearance_ {nullptr};
+};
+
+// mmap-backed reader: opening is O(header) and no data is copied
+class MappedTopology {
+public:
+    explicit MappedTopology(const std::string& path);
+    const TopologyBinaryView& view() const { return view_; }
+
+private:
+    MappedFile file_;
+    TopologyBinaryView view_;
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include <cstddef>
+#include <string>
+
+namespace gvd_topo {
+
+// Reads topological maps back from toJson / writeTopologyJson output and from
+// the binary format (TopologyBinary.hpp)
+class TopologyLoader {
+public:
+    // One-pass parse of the JSON schema; unknown keys are skipped.
+    // Throws std::runtime_error (with byte offset) on malformed input.
+    static TopologicalMap fromJson(const char* data, size_t size);
+    static TopologicalMap fromJson(const std::string& text) { return fromJson(text.data(), text.size()); }
+
+    // mmap-backed; the format is detected from the file's leading bytes
+    static TopologicalMap load(const std::string& path);
+    static bool isBinary(const std::string& path);
+};
+
+} // namespace gvd_topo
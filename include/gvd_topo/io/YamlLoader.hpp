@@ -2,16 +2,17 @@
 
 #include "gvd_topo/core/OccupancyGrid.hpp"
 #include <string>
+#include <vector>
 
 namespace gvd_topo {
 
 struct MapInfo {
     std::string image_file;
-    double resolution;
-    double origin_x, origin_y, origin_theta;
-    double occupied_thresh;
-    double free_thresh;
-    bool negate;
+    double resolution {0.05};
+    double origin_x {0.0}, origin_y {0.0}, origin_theta {0.0};
+    double occupied_thresh {0.65};
+    double free_thresh {0.196};
+    bool negate {false};
 };
 
 // Configuration structure for command-line options
@@ -22,6 +23,7 @@ struct ConfigOptions {
         std::string yaml_file;
         double resolution = 0.05;
         int occupancy_threshold = 50;
+        bool streaming = false; // row-band PGM ingestion overlapped with the EDT
     } input;
     
     // Output configuration
@@ -29,7 +31,41 @@ struct ConfigOptions {
         std::string map_file;
         std::string gvd_image;
         std::string topo_image;
+        std::string map_binary_file; // memory-mappable topology (TopologyBinary.hpp)
+        int json_precision = 6;      // significant digits in the JSON map
+        std::string distance_file;   // EDT export (DistanceField.hpp)
+        std::string distance_format = "fixed16"; // fixed16, float16 or npy
+        double distance_quantum = 0.001;         // meters per fixed16 step
     } output;
+
+    // On-disk result cache (ResultCache.hpp)
+    struct CacheConfig {
+        std::string directory;        // disabled when empty
+        double max_mb = 1024.0;       // LRU eviction bound
+        bool enabled() const { return !directory.empty(); }
+    } cache;
+
+    // Batch processing of many maps (CliApplication::runBatch)
+    struct BatchConfig {
+        std::string input;                       // directory or manifest; disabled when empty
+        std::string output_dir = "batch_output"; // per-map outputs and batch_report.json
+        int jobs = 0;            // maps processed concurrently, 0 = cores / threads_per_map
+        int threads_per_map = 1; // pool threads each map's stages may use
+        int prefetch = 4;        // maps read ahead by the loader
+        bool pipelined = false;  // one worker per stage instead of one job per map
+        bool latest_wins = false; // pipelined: newer inputs replace ones not yet started
+        int pipeline_queue = 2;  // pipelined: maps buffered between stages
+        bool enabled() const { return !input.empty(); }
+    } batch;
+
+    // Unix-socket request server (DaemonServer.hpp)
+    struct DaemonConfig {
+        std::string socket_path; // disabled when empty
+        int workers = 0;         // concurrent requests, 0 = auto-detect
+        int queue_depth = 16;    // waiting requests before BUSY replies
+        double grid_budget_mb = 1024.0; // GRID payloads held at once before BUSY replies
+        bool enabled() const { return !socket_path.empty(); }
+    } daemon;
     
     // Benchmark configuration
     struct BenchmarkConfig {
@@ -40,15 +76,28 @@ struct ConfigOptions {
         unsigned seed = 12345;
     } benchmark;
     
+    // Parameter sweep configuration
+    struct SweepConfig {
+        std::string prune_min_length; // list "a,b,c" or range "start:stop:step"
+        std::string merge_radius;
+        std::string output_dir;       // per-combination maps when set
+        bool enabled() const { return !prune_min_length.empty() || !merge_radius.empty(); }
+    } sweep;
+
     // Processing parameters
     struct ProcessingConfig {
         double distance_epsilon = 1e-6;
-        bool use_opencv = true;
+        bool use_opencv = true; // OpenCV EDT when built with it; --stream always runs the native one
         double prune_min_length = 0.5;
         double merge_radius = 0.2;
         int max_trace_steps = 100000;
         bool use_parallel_processing = true;
         int max_threads = 0; // 0 = auto-detect
+        double deadline_ms = 0.0; // EDT/GVD + topology time budget, 0 = none
+        bool anytime = false;     // on the deadline, keep a coarse/partial map instead of failing
+        bool progress = false;    // report stage progress on stderr
+        bool clearance_profile = false; // per-point clearance in map output
+        std::vector<double> robot_radii; // one filtered topology per radius (meters)
     } processing;
 };
 
@@ -26,6 +26,8 @@ struct Marker {
     Pose2D pose {};
     double scale {1.0};
     std::vector<uint8_t> color {255, 0, 0, 255}; // RGBA
+    double min_width {0.0};  // edges: narrowest corridor width (2 x min clearance)
+    double mean_width {0.0}; // edges: average corridor width
 };
 
 struct MarkerArray {
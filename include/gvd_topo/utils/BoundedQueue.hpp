@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace gvd_topo {
+
+// Multi-producer, multi-consumer FIFO with a fixed capacity. close() wakes
+// everyone: pushes then fail, pops drain what is left and then fail.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(std::max<size_t>(1, capacity)) {}
+
+    // Blocks while full; false once closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this]() { return closed_ || items_.size() < capacity_; });
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Latest-wins: never blocks; when full, the oldest queued items are
+    // evicted (into `dropped` when given) to make room. False once closed.
+    bool pushLatest(T item, std::vector<T>* dropped = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_) return false;
+        while (items_.size() >= capacity_) {
+            if (dropped) dropped->push_back(std::move(items_.front()));
+            items_.pop_front();
+        }
+        items_.push_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Blocks while empty; false once closed and drained
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this]() { return closed_ || !items_.empty(); });
+        if (items_.empty()) return false;
+        out = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+    size_t capacity() const { return capacity_; }
+
+private:
+    const size_t capacity_;
+    std::deque<T> items_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    bool closed_ {false};
+};
+
+} // namespace gvd_topo
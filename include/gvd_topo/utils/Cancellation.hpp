@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace gvd_topo {
+
+// Cooperative stop signal shared between a requester and a running engine.
+// It trips on cancel() or once the deadline has passed; engines poll it
+// between row bands and between traces.
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken() = default;
+    explicit CancellationToken(double budget_ms) { setBudget(budget_ms); }
+
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    void setDeadline(Clock::time_point deadline) {
+        deadline_ns_.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+    // Deadline budget_ms from now
+    void setBudget(double budget_ms) {
+        setDeadline(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                       std::chrono::duration<double, std::milli>(budget_ms)));
+    }
+
+    bool stopRequested() const {
+        if (cancelled_.load(std::memory_order_relaxed)) return true;
+        const int64_t deadline = deadline_ns_.load(std::memory_order_relaxed);
+        return deadline != kNoDeadline && Clock::now().time_since_epoch().count() >= deadline;
+    }
+
+    // +inf without a deadline, 0 once it has passed
+    double remainingMs() const {
+        const int64_t deadline = deadline_ns_.load(std::memory_order_relaxed);
+        if (deadline == kNoDeadline) return std::numeric_limits<double>::infinity();
+        const Clock::duration left(deadline - Clock::now().time_since_epoch().count());
+        return std::max(0.0, std::chrono::duration<double, std::milli>(left).count());
+    }
+
+private:
+    static constexpr int64_t kNoDeadline = std::numeric_limits<int64_t>::max();
+    std::atomic<bool> cancelled_ {false};
+    std::atomic<int64_t> deadline_ns_ {kNoDeadline}; // Clock ticks since epoch
+};
+
+// Thrown by a run stopped through its token when anytime mode is off
+class Cancelled : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Optional controls for one GvdGenerator / TopologyExtractor run
+struct RunControl {
+    const CancellationToken* token {nullptr};
+    // Fraction of the run's work done, non-decreasing in [0, 1]. Calls are
+    // serialised but may come from pool threads.
+    std::function<void(double)> progress;
+    // On a stop, return a valid coarser or partial result flagged incomplete
+    // instead of throwing Cancelled
+    bool anytime {false};
+
+    bool stopRequested() const { return token && token->stopRequested(); }
+};
+
+// Sums completed work units from any thread and forwards the running
+// fraction to RunControl::progress
+class ProgressMeter {
+public:
+    ProgressMeter(const RunControl* control, double total_units)
+        : progress_(control ? &control->progress : nullptr), total_(std::max(total_units, 1e-9)) {}
+
+    void add(double units) {
+        if (!progress_ || !*progress_) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ += units;
+        const double fraction = std::min(1.0, done_ / total_);
+        if (fraction > reported_) {
+            reported_ = fraction;
+            (*progress_)(fraction);
+        }
+    }
+
+    void finish() { add(total_); }
+
+private:
+    const std::function<void(double)>* progress_;
+    double total_;
+    double done_ {0.0};
+    double reported_ {0.0};
+    std::mutex mutex_;
+};
+
+} // namespace gvd_topo
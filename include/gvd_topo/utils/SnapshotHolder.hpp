@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gvd_topo {
+
+// Latest-value holder for immutable snapshots shared between threads.
+// publish() swaps in a new snapshot with one atomic exchange; readers pin
+// whatever is current without locking or allocating. Replaced snapshots are
+// reclaimed by epochs: each reader announces the epoch it entered in its own
+// slot, and a retired snapshot is freed by a later publish() (or reclaim())
+// once no slot still shows an epoch older than its retirement. Writers never
+// wait for readers; a reader that stays pinned only delays those frees.
+template <typename T>
+class SnapshotHolder {
+    struct Node {
+        T value;
+        uint64_t generation;
+    };
+
+public:
+    class Reader;
+
+    // Pinned view of one snapshot; valid while it lives
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& other) noexcept : reader_(other.reader_), node_(other.node_) {
+            other.reader_ = nullptr;
+            other.node_ = nullptr;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+        ~Snapshot() {
+            if (reader_) reader_->unpin();
+        }
+
+        // Null before the first publication
+        const T* get() const { return node_ ? &node_->value : nullptr; }
+        const T& operator*() const { return node_->value; }
+        const T* operator->() const { return &node_->value; }
+        explicit operator bool() const { return node_ != nullptr; }
+        uint64_t generation() const { return node_ ? node_->generation : 0; }
+
+    private:
+        friend class Reader;
+        Snapshot(Reader* reader, const Node* node) : reader_(reader), node_(node) {}
+        Reader* reader_;
+        const Node* node_;
+    };
+
+    // A registered reader, owned by one thread at a time. Pins may nest; the
+    // outermost one holds the epoch.
+    class Reader {
+    public:
+        Reader(Reader&& other) noexcept : holder_(other.holder_), slot_(other.slot_), depth_(other.depth_) {
+            other.holder_ = nullptr;
+            other.slot_ = nullptr;
+        }
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader& operator=(Reader&&) = delete;
+        ~Reader() {
+            if (!slot_) return;
+            slot_->epoch.store(kIdle, std::memory_order_release);
+            slot_->claimed.store(false, std::memory_order_release);
+        }
+
+        // Never blocks or allocates
+        Snapshot pin() {
+            if (depth_++ == 0) {
+                // The announcement must be visible before current_ is read, or
+                // a concurrent reclaim could miss this reader: both seq_cst
+                slot_->epoch.store(holder_->epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            }
+            return Snapshot(this, holder_->current_.load(std::memory_order_seq_cst));
+        }
+
+    private:
+        friend class SnapshotHolder;
+        friend class Snapshot;
+        Reader(SnapshotHolder* holder, typename SnapshotHolder::Slot* slot) : holder_(holder), slot_(slot) {}
+
+        void unpin() {
+            if (--depth_ == 0) slot_->epoch.store(kIdle, std::memory_order_release);
+        }
+
+        SnapshotHolder* holder_;
+        typename SnapshotHolder::Slot* slot_;
+        int depth_ {0};
+    };
+
+    // max_readers bounds the Reader objects alive at once
+    explicit SnapshotHolder(int max_readers = 64)
+        : slots_(static_cast<size_t>(std::max(1, max_readers))) {}
+
+    // Readers must be gone by now
+    ~SnapshotHolder() {
+        delete current_.load(std::memory_order_relaxed);
+        for (auto& r : retired_) delete r.node;
+    }
+
+    SnapshotHolder(const SnapshotHolder&) = delete;
+    SnapshotHolder& operator=(const SnapshotHolder&) = delete;
+
+    // Claims a reader slot; throws std::runtime_error when all are taken
+    Reader reader() {
+        for (auto& slot : slots_) {
+            bool expected = false;
+            if (!slot.claimed.load(std::memory_order_relaxed) &&
+                slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return Reader(this, &slot);
+            }
+        }
+        throw std::runtime_error("SnapshotHolder: all " + std::to_string(slots_.size()) + " reader slots in use");
+    }
+
+    // Makes value the current snapshot and returns its generation (from 1).
+    // Concurrent publishers are serialised among themselves only.
+    uint64_t publish(T value) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        Node* node = new Node{std::move(value), ++generation_};
+        const Node* old = current_.exchange(node, std::memory_order_seq_cst);
+        latest_generation_.store(node->generation, std::memory_order_release);
+        // Readers entering from here on see the new epoch and cannot reach old
+        const uint64_t retired_at = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+        if (old) retired_.push_back({old, retired_at});
+        reclaimLocked();
+        return node->generation;
+    }
+
+    // Frees what no reader can still see, without publishing
+    void reclaim() {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        reclaimLocked();
+    }
+
+    // Generation of the current snapshot, 0 before the first publication.
+    // Kept apart from the node, which may be freed once replaced.
+    uint64_t generation() const { return latest_generation_.load(std::memory_order_acquire); }
+
+    // Replaced snapshots still waiting for a pinned reader
+    size_t pendingReclaim() const {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        return retired_.size();
+    }
+
+private:
+    static constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+
+    // Cache-line sized, so readers announcing epochs do not share lines
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch {kIdle};
+        std::atomic<bool> claimed {false};
+    };
+    struct Retired {
+        const Node* node;
+        uint64_t epoch; // safe once every pinned reader entered at or after it
+    };
+
+    void reclaimLocked() {
+        if (retired_.empty()) return;
+        uint64_t oldest = kIdle;
+        for (const auto& slot : slots_) oldest = std::min(oldest, slot.epoch.load(std::memory_order_seq_cst));
+        size_t kept = 0;
+        for (auto& r : retired_) {
+            if (r.epoch <= oldest) {
+                delete r.node;
+            } else {
+                retired_[kept++] = r;
+            }
+        }
+        retired_.resize(kept);
+    }
+
+    std::vector<Slot> slots_;
+    std::atomic<const Node*> current_ {nullptr};
+    std::atomic<uint64_t> epoch_ {1};
+    std::atomic<uint64_t> latest_generation_ {0};
+    mutable std::mutex writer_mutex_;
+    uint64_t generation_ {0};      // guarded by writer_mutex_
+    std::vector<Retired> retired_; // guarded by writer_mutex_
+};
+
+} // namespace gvd_topo
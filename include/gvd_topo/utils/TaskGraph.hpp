@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gvd_topo {
+
+// DAG of named tasks run on a ThreadPool. A node lists the nodes whose
+// results it consumes and starts once all of them have finished; independent
+// nodes run concurrently. Dependencies must be added before their
+// dependents, which keeps the graph acyclic by construction.
+class TaskGraph {
+public:
+    using NodeId = size_t;
+
+    struct NodeTiming {
+        std::string name;
+        double start_ms {0.0}; // relative to the start of run()
+        double end_ms {0.0};
+        bool ran {false};      // false when skipped after a failed dependency
+        double ms() const { return end_ms - start_ms; }
+    };
+
+    explicit TaskGraph(ThreadPool& pool = ThreadPool::shared());
+
+    NodeId add(std::string name, std::function<void()> fn, std::vector<NodeId> deps = {});
+
+    // Runs every node on at most max_threads threads (0 = pool size), the
+    // caller included, and returns when all have settled. A throwing node
+    // skips everything downstream of it; the first exception is rethrown
+    // once the rest of the graph has finished.
+    void run(int max_threads = 0);
+
+    size_t size() const { return nodes_.size(); }
+    const std::vector<NodeTiming>& timings() const { return timings_; }
+    double wallMs() const { return wall_ms_; }
+
+    // Dependency chain with the largest summed node time in the last run:
+    // the wall time the graph would need with unlimited threads. A wall time
+    // well above it means nodes waited for a thread rather than for data.
+    std::vector<NodeId> criticalPath() const;
+
+private:
+    struct Node {
+        std::function<void()> fn;
+        std::vector<NodeId> deps;
+        std::vector<NodeId> dependents;
+    };
+    struct RunState; // shared with pool helpers, which may outlive run()
+
+    ThreadPool& pool_;
+    std::vector<Node> nodes_;
+    std::vector<NodeTiming> timings_;
+    double wall_ms_ {0.0};
+};
+
+} // namespace gvd_topo
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gvd_topo {
+
+// Work-stealing worker pool. Each worker owns a deque: tasks submitted from
+// a worker go to its own deque (popped LIFO), tasks from other threads go to
+// a shared injection queue, and idle workers steal the oldest task of a busy
+// one. The destructor drains queued tasks before joining, so futures
+// obtained from submit() always become ready.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0); // 0 = hardware concurrency
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename Fn>
+    auto submit(Fn&& fn) -> std::future<std::invoke_result_t<std::decay_t<Fn>>> {
+        using R = std::invoke_result_t<std::decay_t<Fn>>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<Fn>(fn));
+        std::future<R> result = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return result;
+    }
+
+    // Calls body(lo, hi) over disjoint chunks covering [begin, end) on at most
+    // max_threads threads (0 = size()), the caller included, and returns once
+    // every chunk has run. Chunks hold at least `grain` indices and are
+    // claimed dynamically. The caller never waits on a queued helper, so
+    // nesting inside pool tasks cannot deadlock. The first exception thrown
+    // by body is rethrown here.
+    void parallelFor(int begin, int end, int max_threads,
+                     const std::function<void(int, int)>& body, int grain = 1);
+
+    int size() const { return static_cast<int>(workers_.size()); }
+
+    // Process-wide pool (hardware concurrency) shared by the GVD and topology
+    // engines, so several of them running at once do not oversubscribe cores
+    static ThreadPool& shared();
+
+private:
+    struct WorkerQueue {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_; // one per worker
+    std::deque<std::function<void()>> injected_;       // guarded by mutex_
+    std::atomic<size_t> queued_ {0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ {false};
+
+    void enqueue(std::function<void()> task);
+    bool tryPop(int self, std::function<void()>& task);
+    void workerLoop(int self);
+};
+
+} // namespace gvd_topo
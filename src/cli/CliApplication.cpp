@@ -1,7 +1,28 @@
 #include "gvd_topo/cli/CliApplication.hpp"
+#include "gvd_topo/cli/DaemonServer.hpp"
 #include "gvd_topo/io/YamlLoader.hpp"
+#include "gvd_topo/io/PgmLoader.hpp"
+#include "gvd_topo/io/PgmStreamReader.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include "gvd_topo/io/JsonWriter.hpp"
+#include "gvd_topo/io/ResultCache.hpp"
+#include "gvd_topo/io/DistanceField.hpp"
+#include "gvd_topo/io/BatchLoader.hpp"
+#include "gvd_topo/io/AsyncOutputSink.hpp"
+#include "gvd_topo/utils/Cancellation.hpp"
+#include "gvd_topo/utils/TaskGraph.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include "gvd_topo/utils/BoundedQueue.hpp"
+#include "gvd_topo/core/ClearanceFilter.hpp"
+#include "gvd_topo/core/ParameterSweep.hpp"
+#include <algorithm>
 #include <iostream>
+#include <filesystem>
 #include <fstream>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <sstream>
 
 #ifdef GVD_TOPO_WITH_OPENCV
 #include <opencv2/imgcodecs.hpp>
@@ -10,45 +31,452 @@
 
 namespace gvd_topo {
 
+namespace {
+
+// "out/map.json" + "_r0.3" -> "out/map_r0.3.json"
+std::string withSuffix(const std::string& path, const std::string& suffix) {
+    if (path.empty()) return path;
+    std::filesystem::path p(path);
+    std::filesystem::path out = p.parent_path() / (p.stem().string() + suffix + p.extension().string());
+    return out.string();
+}
+
+JsonWriteOptions jsonOptions(const ConfigOptions& config) {
+    JsonWriteOptions options;
+    options.precision = config.output.json_precision;
+    options.parallel = config.processing.use_parallel_processing;
+    options.max_threads = config.processing.max_threads;
+    options.trailing_newline = true;
+    return options;
+}
+
+// Outputs that need the topology (everything but the distance field)
+bool hasMapOutputs(const ConfigOptions& config) {
+    return !config.output.map_file.empty() || !config.output.map_binary_file.empty() ||
+           !config.output.gvd_image.empty() || !config.output.topo_image.empty();
+}
+
+// "<stage>: NN%" on stderr at every 10% step
+std::function<void(double)> progressPrinter(const std::string& stage) {
+    auto last = std::make_shared<int>(0);
+    return [stage, last](double fraction) {
+        const int step = static_cast<int>(fraction * 10.0);
+        if (step == *last) return;
+        *last = step;
+        std::cerr << stage << ": " << step * 10 << "%" << std::endl;
+    };
+}
+
+// Per-node timings in start order, then the chain that bounded the run
+void reportTaskGraph(const TaskGraph& graph,
+                     const std::function<void(const std::string&, double)>& timing) {
+    const auto& nodes = graph.timings();
+    std::vector<size_t> order;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].ran) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(),
+              [&nodes](size_t a, size_t b) { return nodes[a].start_ms < nodes[b].start_ms; });
+    for (size_t i : order) timing(nodes[i].name, nodes[i].ms());
+
+    const std::vector<TaskGraph::NodeId> path = graph.criticalPath();
+    if (path.empty() || order.size() < 2) return;
+    std::ostringstream line;
+    line << "critical path:";
+    double busy = 0.0;
+    for (size_t k = 0; k < path.size(); ++k) {
+        const auto& t = nodes[path[k]];
+        line << (k ? " -> " : " ") << t.name << " (" << t.ms() << " ms)";
+        busy += t.ms();
+    }
+    line << "; " << busy << " of " << graph.wallMs() << " ms wall";
+    std::cout << line.str() << std::endl;
+}
+
+// Per-map outcome of a batch run
+struct BatchItem {
+    std::string path;
+    std::string error;
+    bool dropped {false}; // superseded by a newer input (latest-wins)
+    int width {0};
+    int height {0};
+    size_t nodes {0};
+    size_t edges {0};
+    double read_ms {0.0};
+    double parse_ms {0.0};
+    double gvd_ms {0.0};
+    double topology_ms {0.0};
+    double write_ms {0.0};
+
+    void fromLoaded(const BatchMap& m) {
+        path = m.path;
+        error = m.error;
+        read_ms = m.read_ms;
+        parse_ms = m.parse_ms;
+        width = m.grid.width;
+        height = m.grid.height;
+    }
+};
+
+// Serialised "[k/N] path: ..." lines as maps finish
+class BatchProgress {
+public:
+    explicit BatchProgress(size_t total) : total_(total) {}
+
+    void report(const BatchItem& item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cout << "[" << ++completed_ << "/" << total_ << "] " << item.path << ": ";
+        if (item.dropped) {
+            std::cout << "dropped (superseded)" << std::endl;
+        } else if (!item.error.empty()) {
+            std::cout << "FAILED: " << item.error << std::endl;
+        } else {
+            std::cout << item.width << "x" << item.height << ", nodes=" << item.nodes << ", edges=" << item.edges
+                      << ", gvd=" << item.gvd_ms << " ms, topology=" << item.topology_ms << " ms" << std::endl;
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    size_t total_;
+    size_t completed_ {0};
+};
+
+// Output names by file stem, disambiguated when two inputs share one. The
+// first input keeps the plain stem; later ones get the lowest "_<n>" suffix
+// that is neither another input's own stem nor already handed out.
+std::vector<std::string> batchStems(const std::vector<std::string>& inputs) {
+    std::vector<std::string> stems(inputs.size());
+    std::set<std::string> used;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        stems[i] = std::filesystem::path(inputs[i]).stem().string();
+        used.insert(stems[i]);
+    }
+    std::set<std::string> taken;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (taken.insert(stems[i]).second) continue;
+        std::string stem;
+        for (size_t n = 1;; ++n) {
+            stem = stems[i] + "_" + std::to_string(n);
+            if (used.insert(stem).second) break;
+        }
+        taken.insert(stem);
+        stems[i] = stem;
+    }
+    return stems;
+}
+
+BatchLoaderOptions batchLoaderOptions(const ConfigOptions& config) {
+    BatchLoaderOptions options;
+    options.prefetch = config.batch.prefetch;
+    options.resolution = config.input.resolution;
+    options.occupancy_threshold = config.input.occupancy_threshold;
+    return options;
+}
+
+// dir/<stem><extension of the single-map option>; empty when that output is off
+std::string batchOutputPath(const std::string& dir, const std::string& stem,
+                            const std::string& option, const char* default_ext) {
+    if (option.empty()) return std::string();
+    std::string ext = std::filesystem::path(option).extension().string();
+    if (ext.empty()) ext = default_ext;
+    return (std::filesystem::path(dir) / (stem + ext)).string();
+}
+
+// <stem>.json plus whichever single-map outputs are enabled; throws on failure
+void writeBatchOutputs(const ConfigOptions& config, const std::string& stem,
+                       const GvdResult& gvd, const TopologicalMap& topo) {
+    const std::string& dir = config.batch.output_dir;
+    JsonWriteOptions json = jsonOptions(config);
+    json.max_threads = std::max(1, config.batch.threads_per_map);
+    writeTopologyJson(topo, (std::filesystem::path(dir) / (stem + ".json")).string(), json);
+    const std::string bin = batchOutputPath(dir, stem, config.output.map_binary_file, ".bin");
+    if (!bin.empty()) writeTopologyBinary(topo, bin);
+    const std::string dist = batchOutputPath(dir, stem, config.output.distance_file, ".gvdd");
+    if (!dist.empty()) {
+        DistanceExportOptions options;
+        options.format = parseDistanceFormat(config.output.distance_format);
+        options.quantum = config.output.distance_quantum;
+        writeDistanceField(gvd, dist, options);
+    }
+    const std::string image = batchOutputPath(dir, stem, config.output.topo_image, ".png");
+    if (!image.empty()) Visualizer::saveTopologicalMapAsImage(topo, image, 1200, 800);
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+        else out += c;
+    }
+    return out;
+}
+
+// Aggregate summary on stdout and batch_report.json; returns the exit code.
+// `fields` holds mode-specific report members, each line ending in ",\n".
+int finishBatch(const ConfigOptions& config, const char* mode, const std::vector<BatchItem>& items,
+                const std::vector<std::string>& stems, double wall_ms,
+                const std::string& settings, const std::string& fields) {
+    size_t failed = 0;
+    size_t dropped = 0;
+    double cells = 0.0;
+    BatchItem totals;
+    for (const auto& it : items) {
+        if (it.dropped) { ++dropped; continue; }
+        if (!it.error.empty()) { ++failed; continue; }
+        cells += static_cast<double>(it.width) * it.height;
+        totals.read_ms += it.read_ms;
+        totals.parse_ms += it.parse_ms;
+        totals.gvd_ms += it.gvd_ms;
+        totals.topology_ms += it.topology_ms;
+        totals.write_ms += it.write_ms;
+    }
+    const double seconds = std::max(wall_ms, 1e-3) / 1000.0;
+    const double maps_per_s = static_cast<double>(items.size() - failed - dropped) / seconds;
+    const double mcells_per_s = cells / 1e6 / seconds;
+
+    std::cout << mode << ": " << items.size() << " maps (" << failed << " failed) in " << wall_ms << " ms, "
+              << maps_per_s << " maps/s, " << mcells_per_s << " Mcells/s [" << settings << "]" << std::endl;
+    std::cout << mode << " stage totals: read=" << totals.read_ms << " ms, parse=" << totals.parse_ms
+              << " ms, gvd=" << totals.gvd_ms << " ms, topology=" << totals.topology_ms
+              << " ms, write=" << totals.write_ms << " ms" << std::endl;
+
+    const std::string report_path = (std::filesystem::path(config.batch.output_dir) / "batch_report.json").string();
+    std::ofstream out(report_path);
+    if (!out.is_open()) {
+        std::cerr << "Cannot create batch report: " << report_path << std::endl;
+        return 1;
+    }
+    out << "{\n" << fields
+        << "  \"maps\": " << items.size() << ",\n  \"failed\": " << failed << ",\n"
+        << "  \"wall_ms\": " << wall_ms << ",\n  \"maps_per_second\": " << maps_per_s << ",\n"
+        << "  \"megacells_per_second\": " << mcells_per_s << ",\n"
+        << "  \"stage_ms\": {\"read\": " << totals.read_ms << ", \"parse\": " << totals.parse_ms
+        << ", \"gvd\": " << totals.gvd_ms << ", \"topology\": " << totals.topology_ms
+        << ", \"write\": " << totals.write_ms << "},\n  \"items\": [";
+    for (size_t i = 0; i < items.size(); ++i) {
+        const BatchItem& it = items[i];
+        out << (i ? ",\n" : "\n") << "    {\"path\": \"" << jsonEscape(it.path) << "\", ";
+        if (it.dropped) {
+            out << "\"dropped\": true}";
+            continue;
+        }
+        if (!it.error.empty()) {
+            out << "\"error\": \"" << jsonEscape(it.error) << "\"}";
+            continue;
+        }
+        out << "\"output\": \"" << jsonEscape(stems[i]) << ".json\", \"width\": " << it.width
+            << ", \"height\": " << it.height << ", \"nodes\": " << it.nodes << ", \"edges\": " << it.edges
+            << ", \"read_ms\": " << it.read_ms << ", \"parse_ms\": " << it.parse_ms
+            << ", \"gvd_ms\": " << it.gvd_ms << ", \"topology_ms\": " << it.topology_ms
+            << ", \"write_ms\": " << it.write_ms << "}";
+    }
+    out << "\n  ]\n}\n";
+    std::cout << "Wrote batch report: " << report_path << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+} // namespace
+
 CliApplication::CliApplication() 
     : gvd_generator_(std::make_unique<GvdGenerator>())
     , topology_extractor_(std::make_unique<TopologyExtractor>())
+    , output_sink_(std::make_unique<AsyncOutputSink>())
     , timing_callback_([](const std::string&, double){}) {
 }
 
+CliApplication::~CliApplication() = default;
+
 void CliApplication::setTimingCallback(std::function<void(const std::string&, double)> callback) {
-    timing_callback_ = callback;
+    // Output writers report from AsyncOutputSink threads while run() reports
+    // graph timings, so every call goes through one lock
+    auto mutex = std::make_shared<std::mutex>();
+    timing_callback_ = [callback = std::move(callback), mutex](const std::string& label, double ms) {
+        std::lock_guard<std::mutex> lock(*mutex);
+        callback(label, ms);
+    };
 }
 
 int CliApplication::run(const ConfigOptions& config) {
     try {
-        // Load occupancy grid
-        OccupancyGrid grid;
-        {
-            ScopeTimer timer("load+preprocess", timing_callback_);
-            grid = loadOccupancyGrid(config);
+        GvdGenerator::Params gvd_params = gvd_generator_->params();
+        gvd_params.use_opencv = config.processing.use_opencv;
+        gvd_params.parallel = config.processing.use_parallel_processing;
+        gvd_params.max_threads = config.processing.max_threads;
+        gvd_generator_->setParams(gvd_params);
+
+        if (config.daemon.enabled()) {
+            return runDaemon(config);
+        }
+        if (config.batch.enabled()) {
+            return runBatch(config);
         }
 
-        // Generate GVD
+        TopologyExtractor::Params topo_params;
+        topo_params.record_clearance_profile = config.processing.clearance_profile;
+        topo_params.parallel = config.processing.use_parallel_processing;
+        topo_params.max_threads = config.processing.max_threads;
+        topology_extractor_->setParams(topo_params);
+
+        OccupancyGrid grid;
         GvdResult gvd_result;
-        {
-            ScopeTimer timer("EDT+GVD", timing_callback_);
-            gvd_result = generateGVD(grid);
+        TopologicalMap topo_map;
+        // Cache entries are keyed by grid contents, which streaming never holds
+        std::unique_ptr<ResultCache> cache;
+        uint64_t cache_key = 0;
+        bool cache_hit = false;
+        double cache_lookup_ms = 0.0; // reported once the store has run, with the counters
+        // Deadline and progress for EDT/GVD + topology (not the streaming path)
+        CancellationToken deadline;
+        const bool controlled = config.processing.deadline_ms > 0.0 || config.processing.progress;
+        RunControl gvd_control;
+        gvd_control.token = &deadline;
+        gvd_control.anytime = config.processing.anytime && config.processing.deadline_ms > 0.0;
+        RunControl topo_control = gvd_control;
+        if (config.processing.progress) {
+            gvd_control.progress = progressPrinter("EDT+GVD");
+            topo_control.progress = progressPrinter("topology");
         }
+        if (config.input.streaming && !config.benchmark.enabled) {
+            // Decoding and the row-wise EDT pass overlap, so they share one timer
+            ScopeTimer timer("load+EDT+GVD (streamed)", timing_callback_);
+            gvd_result = loadAndGenerateStreaming(config, grid);
+        } else {
+            // Load occupancy grid
+            {
+                ScopeTimer timer("load+preprocess", timing_callback_);
+                grid = loadOccupancyGrid(config);
+            }
 
-        // Extract topology
-        TopologicalMap topo_map;
-        {
-            ScopeTimer timer("topology", timing_callback_);
-            topo_map = extractTopology(gvd_result, config.input.resolution);
+            if (config.cache.enabled()) {
+                const Timer lookup;
+                cache = std::make_unique<ResultCache>(config.cache.directory,
+                                                      static_cast<uint64_t>(config.cache.max_mb * 1024.0 * 1024.0));
+                cache_key = ResultCache::makeKey(grid, gvd_generator_->params(), topo_params, config.input.resolution);
+                cache_hit = cache->load(cache_key, gvd_result, topo_map);
+                cache_lookup_ms = lookup.ms();
+            }
+
+            // Generate GVD
+            if (!cache_hit) {
+                ScopeTimer timer("EDT+GVD", timing_callback_);
+                if (config.processing.deadline_ms > 0.0) deadline.setBudget(config.processing.deadline_ms);
+                gvd_result = generateGVD(grid, controlled ? &gvd_control : nullptr);
+            }
         }
 
-        // Print statistics
-        printStatistics(gvd_result, topo_map);
+        // Sweep mode replaces the single extraction
+        if (config.sweep.enabled()) {
+            runSweep(config, gvd_result);
+            return 0;
+        }
 
-        // Save outputs
-        saveOutputs(config, grid, gvd_result, topo_map);
+        // Everything after the EDT only needs the GVD, so it runs as a task
+        // graph: topology, per-radius topologies and the distance export
+        // proceed concurrently, and each writer starts as soon as its input exists.
+        // Output nodes only enqueue on the sink; their futures are joined at the
+        // flush below so no pool worker blocks on file I/O inside the graph.
+        auto shared_grid = std::make_shared<const OccupancyGrid>(std::move(grid));
+        auto shared_gvd = std::make_shared<const GvdResult>(std::move(gvd_result));
+        std::shared_ptr<const TopologicalMap> shared_map;
+        if (cache_hit) shared_map = std::make_shared<const TopologicalMap>(std::move(topo_map));
+        std::vector<RadiusTopology> radius_maps;
+        std::mutex pending_mutex;
+        std::vector<std::future<OutputReport>> pending_outputs;
+        auto enqueue = [&](std::future<OutputReport> f) {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            pending_outputs.push_back(std::move(f));
+        };
 
+        TaskGraph graph;
+        std::vector<TaskGraph::NodeId> after_topology;
+        if (!cache_hit) {
+            after_topology.push_back(graph.add("topology", [&]() {
+                shared_map = std::make_shared<const TopologicalMap>(
+                    extractTopology(*shared_gvd, config.input.resolution, controlled ? &topo_control : nullptr));
+            }));
+        }
+        if (cache && !cache_hit) {
+            graph.add("cache-store", [&]() {
+                if (!shared_map->complete) return; // anytime results are never cached
+                try {
+                    cache->store(cache_key, *shared_gvd, *shared_map);
+                } catch (const std::exception& e) {
+                    std::cerr << e.what() << std::endl;
+                }
+            }, after_topology);
+        }
+        if (!config.output.distance_file.empty() && !shared_gvd->complete) {
+            std::cerr << "distance export skipped: the deadline left only a coarse EDT" << std::endl;
+        } else if (!config.output.distance_file.empty()) {
+            graph.add("distance-export", [&]() {
+                ConfigOptions distance_config;
+                distance_config.output.distance_file = config.output.distance_file;
+                distance_config.output.distance_format = config.output.distance_format;
+                distance_config.output.distance_quantum = config.output.distance_quantum;
+                enqueue(saveOutputs(distance_config, nullptr, shared_gvd, nullptr));
+            });
+        }
+        if (hasMapOutputs(config)) {
+            graph.add("map-outputs", [&]() {
+                ConfigOptions map_config = config;
+                map_config.output.distance_file.clear();
+                enqueue(saveOutputs(map_config, shared_grid, shared_gvd, shared_map));
+            }, after_topology);
+        }
+        if (!config.processing.robot_radii.empty()) {
+            // Clearance-filtered topology per robot radius, reusing the same EDT
+            const TaskGraph::NodeId radii = graph.add("radius-topology", [&]() {
+                radius_maps = extractForRadii(*shared_gvd, config.processing.robot_radii,
+                                              *topology_extractor_, config.input.resolution);
+            });
+            if (hasMapOutputs(config)) {
+                graph.add("radius-outputs", [&]() {
+                    for (const auto& r : radius_maps) {
+                        std::ostringstream suffix;
+                        suffix << "_r" << r.radius;
+                        ConfigOptions radius_config = config;
+                        radius_config.output.map_file = withSuffix(config.output.map_file, suffix.str());
+                        radius_config.output.map_binary_file = withSuffix(config.output.map_binary_file, suffix.str());
+                        radius_config.output.topo_image = withSuffix(config.output.topo_image, suffix.str());
+                        radius_config.output.gvd_image.clear(); // the base overlay already shows the full skeleton
+                        radius_config.output.distance_file.clear(); // identical for every radius
+                        enqueue(saveOutputs(radius_config, shared_grid, shared_gvd,
+                                            std::make_shared<const TopologicalMap>(r.map)));
+                    }
+                }, {radii});
+            }
+        }
+        graph.run(config.processing.use_parallel_processing ? config.processing.max_threads : 1);
+        reportTaskGraph(graph, timing_callback_);
+        if (cache) {
+            const ResultCache::Stats& s = cache->stats();
+            timing_callback_("cache-lookup (hits=" + std::to_string(s.hits) + ", misses=" + std::to_string(s.misses) +
+                                 ", evictions=" + std::to_string(s.evictions) + ")",
+                             cache_lookup_ms);
+        }
+
+        // Print statistics
+        printStatistics(*shared_gvd, *shared_map);
+        if (!shared_map->complete) {
+            std::cout << "incomplete: deadline of " << config.processing.deadline_ms << " ms reached; "
+                      << (shared_gvd->complete ? "tracing stopped early"
+                                               : "map built from a " + std::to_string(shared_gvd->scale) +
+                                                     "x coarser GVD")
+                      << std::endl;
+        }
+        for (const auto& r : radius_maps) {
+            std::cout << "radius=" << r.radius << ": nodes=" << r.map.nodes.size()
+                      << ", edges=" << r.map.edges.size() << std::endl;
+        }
+
+        {
+            ScopeTimer timer("output-flush", timing_callback_);
+            for (auto& f : pending_outputs) f.wait();
+            output_sink_->flush();
+        }
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -75,91 +503,411 @@ OccupancyGrid CliApplication::loadOccupancyGrid(const ConfigOptions& config) {
     }
 }
 
-GvdResult CliApplication::generateGVD(const OccupancyGrid& grid) {
-    return gvd_generator_->run(grid);
+GvdResult CliApplication::loadAndGenerateStreaming(const ConfigOptions& config, OccupancyGrid& grid) {
+    std::string image_path = config.input.image_file;
+    double resolution = config.input.resolution;
+    MapInfo info;
+    const bool from_yaml = !config.input.yaml_file.empty();
+    if (from_yaml) {
+        info = YamlLoader::loadMapInfo(config.input.yaml_file);
+        image_path = (std::filesystem::path(config.input.yaml_file).parent_path() / info.image_file).string();
+        resolution = info.resolution;
+    }
+    if (!PgmLoader::isPgm(image_path)) {
+        throw std::runtime_error("Streaming mode requires a binary PGM input: " + image_path);
+    }
+
+    // Same threshold rules as the non-streaming loaders
+    PgmStreamReader reader(image_path, resolution, CellThresholds::fromBinary(config.input.occupancy_threshold));
+    Origin2D origin;
+    if (from_yaml) {
+        PgmThreshold t;
+        t.occupied_thresh = info.occupied_thresh;
+        t.free_thresh = info.free_thresh;
+        t.negate = info.negate;
+        reader.setThresholds(CellThresholds::fromMapServer(t, reader.maxval()));
+        origin.x = info.origin_x;
+        origin.y = info.origin_y;
+        origin.theta = info.origin_theta;
+    }
+    if (GvdGenerator::usesOpenCvEdt(gvd_generator_->params())) {
+        std::cerr << "--stream uses the exact native EDT, not the OpenCV one of non-streaming runs; "
+                     "set processing.use_opencv: false for matching results" << std::endl;
+    }
+    // Cells are only materialised when the overlay needs them
+    const bool keep_cells = !config.output.gvd_image.empty();
+    GvdResult result = gvd_generator_->runStreaming(reader, keep_cells ? &grid : nullptr);
+    if (!keep_cells) {
+        grid.width = reader.width();
+        grid.height = reader.height();
+        grid.resolution = resolution;
+    }
+    grid.origin = origin;
+    return result;
+}
+
+GvdResult CliApplication::generateGVD(const OccupancyGrid& grid, const RunControl* control) {
+    return control ? gvd_generator_->run(grid, *control) : gvd_generator_->run(grid);
 }
 
-TopologicalMap CliApplication::extractTopology(const GvdResult& gvd_result, double resolution) {
-    return topology_extractor_->run(gvd_result.gvd_mask, gvd_result.width, gvd_result.height, resolution);
+TopologicalMap CliApplication::extractTopology(const GvdResult& gvd_result, double resolution,
+                                               const RunControl* control) {
+    return control ? topology_extractor_->run(gvd_result, resolution, *control)
+                   : topology_extractor_->run(gvd_result, resolution);
 }
 
-void CliApplication::saveOutputs(const ConfigOptions& config, 
-                                const OccupancyGrid& grid,
-                                const GvdResult& gvd_result,
-                                const TopologicalMap& topo_map) {
-    // Save topological map JSON
-    if (!config.output.map_file.empty()) {
-        std::ofstream ofs(config.output.map_file);
-        if (!ofs) {
-            std::cerr << "Failed to open " << config.output.map_file << std::endl;
-            return;
+std::future<OutputReport> CliApplication::saveOutputs(const ConfigOptions& config,
+                                                     std::shared_ptr<const OccupancyGrid> grid,
+                                                     std::shared_ptr<const GvdResult> gvd_result,
+                                                     std::shared_ptr<const TopologicalMap> topo_map) {
+    OutputRequest request;
+    request.map_file = config.output.map_file;
+    request.json = jsonOptions(config);
+    request.map_binary_file = config.output.map_binary_file;
+    request.distance_file = config.output.distance_file;
+#ifdef GVD_TOPO_WITH_OPENCV
+    request.gvd_image = config.output.gvd_image;
+#endif
+    request.topo_image = config.output.topo_image;
+    request.resolution = config.input.resolution;
+    if (!request.distance_file.empty()) {
+        try {
+            request.distance.format = parseDistanceFormat(config.output.distance_format);
+            request.distance.quantum = config.output.distance_quantum;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            request.distance_file.clear();
         }
-        ofs << toJson(topo_map) << std::endl;
-        std::cout << "Wrote map: " << config.output.map_file << std::endl;
     }
+    if (request.gvd_image.empty()) grid.reset(); // only the overlay reads cells
 
-#ifdef GVD_TOPO_WITH_OPENCV
-    // Save GVD visualization
-    if (!config.output.gvd_image.empty()) {
-        ScopeTimer timer("overlay", timing_callback_);
-        cv::Mat vis(grid.height, grid.width, CV_8UC3);
-        
-        // Create base visualization
-        for (int y = 0; y < grid.height; ++y) {
-            for (int x = 0; x < grid.width; ++x) {
-                int8_t c = grid.data[grid.index(x, y)];
-                uint8_t v = 127;
-                if (c == static_cast<int8_t>(100)) v = 0; // occupied -> black
-                else if (c == static_cast<int8_t>(0)) v = 255; // free -> white
-                vis.at<cv::Vec3b>(y,x) = cv::Vec3b(v,v,v);
-            }
-        }
-        
-        // Overlay GVD
-        for (int y = 0; y < gvd_result.height; ++y) {
-            for (int x = 0; x < gvd_result.width; ++x) {
-                if (gvd_result.gvd_mask[y * gvd_result.width + x]) {
-                    vis.at<cv::Vec3b>(y,x) = cv::Vec3b(255,0,0); // GVD -> red
+    auto timing = timing_callback_;
+    const char* distance_format = distanceFormatName(request.distance.format);
+    return output_sink_->submit(std::move(grid), std::move(gvd_result), std::move(topo_map), std::move(request),
+                         [timing, distance_format](const OutputReport& report) {
+        // One string per stream so lines from concurrent writers stay whole
+        std::ostringstream out;
+        std::ostringstream err;
+        for (const auto& o : report.outputs) {
+            if (o.kind == OutputKind::GvdOverlay) timing("overlay", o.ms);
+            if (o.kind == OutputKind::TopologyImage) timing("topo-visualization", o.ms);
+            if (!o.ok()) {
+                if (o.kind == OutputKind::TopologyImage) err << "Failed to create topological map image: ";
+                err << o.error << "\n";
+                continue;
+            }
+            switch (o.kind) {
+            case OutputKind::MapJson:
+                out << "Wrote map: " << o.path << "\n";
+                break;
+            case OutputKind::DistanceField:
+                out << "Wrote distance field: " << o.path << " (" << distance_format
+                    << ", " << o.distance.bytes << " bytes, max error " << o.distance.max_error
+                    << " m, bound " << o.distance.error_bound << " m";
+                if (o.distance.saturated > 0) out << ", " << o.distance.saturated << " cells saturated";
+                out << ")\n";
+                break;
+            case OutputKind::MapBinary:
+                out << "Wrote binary map: " << o.path << "\n";
+                break;
+            case OutputKind::GvdOverlay:
+                out << "Wrote overlay: " << o.path << "\n";
+                break;
+            case OutputKind::TopologyImage:
+                out << "Wrote topological map image: " << o.path << "\n";
+                break;
+            }
+        }
+        std::cout << out.str() << std::flush;
+        std::cerr << err.str() << std::flush;
+    });
+}
+
+void CliApplication::runSweep(const ConfigOptions& config, const GvdResult& gvd_result) {
+    TopologyExtractor::Params base;
+    base.record_clearance_profile = config.processing.clearance_profile;
+    base.parallel = config.processing.use_parallel_processing;
+    base.max_threads = config.processing.max_threads;
+    const auto combos = makeSweepGrid(parseSweepValues(config.sweep.prune_min_length),
+                                      parseSweepValues(config.sweep.merge_radius), base);
+    SweepOptions options;
+    options.keep_maps = !config.sweep.output_dir.empty();
+    options.parallel = config.processing.use_parallel_processing;
+    options.max_threads = config.processing.max_threads;
+
+    std::vector<SweepResult> results;
+    {
+        ScopeTimer timer("sweep", timing_callback_);
+        results = runParameterSweep(gvd_result, combos, config.input.resolution, options);
+    }
+    printSweepSummary(std::cout, results);
+
+    if (options.keep_maps) {
+        std::filesystem::create_directories(config.sweep.output_dir);
+        for (const auto& r : results) {
+            std::ostringstream name;
+            name << "topo_p" << r.params.prune_min_length << "_m" << r.params.merge_radius << ".json";
+            const std::string path = (std::filesystem::path(config.sweep.output_dir) / name.str()).string();
+            try {
+                writeTopologyJson(r.map, path, jsonOptions(config));
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+        std::cout << "Wrote " << results.size() << " sweep maps to " << config.sweep.output_dir << std::endl;
+    }
+}
+
+int CliApplication::runBatch(const ConfigOptions& config) {
+    if (config.batch.pipelined) {
+        return runPipeline(config);
+    }
+    const std::vector<std::string> inputs = BatchLoader::collectInputs(config.batch.input);
+    if (inputs.empty()) {
+        throw std::runtime_error("No maps found in batch input: " + config.batch.input);
+    }
+    std::filesystem::create_directories(config.batch.output_dir);
+
+    const int threads_per_map = std::max(1, config.batch.threads_per_map);
+    const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int jobs = config.batch.jobs > 0 ? config.batch.jobs : std::max(1, hw / threads_per_map);
+    const std::vector<std::string> stems = batchStems(inputs);
+
+    TopologyExtractor::Params topo_params = topology_extractor_->params();
+    topo_params.record_clearance_profile = config.processing.clearance_profile;
+    topo_params.parallel = config.processing.use_parallel_processing;
+    topo_params.max_threads = threads_per_map;
+    GvdGenerator::Params gvd_params = gvd_generator_->params();
+    gvd_params.max_threads = threads_per_map;
+
+    BatchLoader loader(inputs, batchLoaderOptions(config));
+    std::vector<BatchItem> items(inputs.size());
+    BatchProgress progress(inputs.size());
+
+    Timer wall;
+    {
+        ThreadPool pool(jobs);
+        std::deque<std::future<void>> inflight;
+        BatchMap loaded;
+        while (loader.next(loaded)) {
+            BatchItem& item = items[loaded.index];
+            item.fromLoaded(loaded);
+            if (!loaded.ok()) {
+                progress.report(item);
+                continue;
+            }
+            // At most `jobs` decoded grids wait on the pool; the loader reads ahead meanwhile
+            while (inflight.size() >= static_cast<size_t>(jobs)) {
+                inflight.front().get();
+                inflight.pop_front();
+            }
+            auto map = std::make_shared<BatchMap>(std::move(loaded));
+            const std::string stem = stems[map->index];
+            inflight.push_back(pool.submit([&, map, stem]() {
+                BatchItem& it = items[map->index];
+                try {
+                    GvdGenerator generator(gvd_params);
+                    TopologyExtractor extractor(topo_params);
+                    Timer timer;
+                    const GvdResult gvd = generator.run(map->grid);
+                    it.gvd_ms = timer.ms();
+                    timer.reset();
+                    const TopologicalMap topo = extractor.run(gvd, map->grid.resolution);
+                    it.topology_ms = timer.ms();
+                    it.nodes = topo.nodes.size();
+                    it.edges = topo.edges.size();
+                    timer.reset();
+                    writeBatchOutputs(config, stem, gvd, topo);
+                    it.write_ms = timer.ms();
+                } catch (const std::exception& e) {
+                    it.error = e.what();
+                }
+                progress.report(it);
+            }));
+        }
+        for (auto& f : inflight) f.get();
+    }
+    const double wall_ms = wall.ms();
+    timing_callback_("batch", wall_ms);
+
+    std::ostringstream settings;
+    settings << loader.backend() << ", jobs=" << jobs << ", threads/map=" << threads_per_map;
+    std::ostringstream fields;
+    fields << "  \"mode\": \"batch\",\n  \"backend\": \"" << loader.backend() << "\",\n"
+           << "  \"jobs\": " << jobs << ",\n  \"threads_per_map\": " << threads_per_map << ",\n";
+    return finishBatch(config, "batch", items, stems, wall_ms, settings.str(), fields.str());
+}
+
+int CliApplication::runPipeline(const ConfigOptions& config) {
+    const std::vector<std::string> inputs = BatchLoader::collectInputs(config.batch.input);
+    if (inputs.empty()) {
+        throw std::runtime_error("No maps found in batch input: " + config.batch.input);
+    }
+    std::filesystem::create_directories(config.batch.output_dir);
+
+    const int threads_per_map = std::max(1, config.batch.threads_per_map);
+    const size_t depth = static_cast<size_t>(std::max(1, config.batch.pipeline_queue));
+    const bool latest_wins = config.batch.latest_wins;
+    const std::vector<std::string> stems = batchStems(inputs);
+
+    TopologyExtractor::Params topo_params = topology_extractor_->params();
+    topo_params.record_clearance_profile = config.processing.clearance_profile;
+    topo_params.parallel = config.processing.use_parallel_processing;
+    topo_params.max_threads = threads_per_map;
+    GvdGenerator::Params gvd_params = gvd_generator_->params();
+    gvd_params.max_threads = threads_per_map;
+    const GvdGenerator generator(gvd_params);
+    const TopologyExtractor extractor(topo_params);
+
+    // One map in flight between stages
+    struct Job {
+        size_t index {0};
+        double resolution {0.05};
+        OccupancyGrid grid;
+        GvdResult gvd;
+        TopologicalMap topo;
+    };
+    using JobPtr = std::unique_ptr<Job>;
+    BoundedQueue<JobPtr> to_gvd(depth);
+    BoundedQueue<JobPtr> to_topology(depth);
+    BoundedQueue<JobPtr> to_write(depth);
+
+    BatchLoader loader(inputs, batchLoaderOptions(config));
+    std::vector<BatchItem> items(inputs.size());
+    BatchProgress progress(inputs.size());
+    // Time each stage spends working, excluding waits on its queues
+    double busy_load = 0.0, busy_gvd = 0.0, busy_topology = 0.0, busy_write = 0.0;
+    size_t dropped = 0;
+
+    Timer wall;
+    std::thread load_stage([&]() {
+        BatchMap loaded;
+        for (;;) {
+            Timer timer;
+            if (!loader.next(loaded)) break;
+            busy_load += timer.ms();
+            BatchItem& item = items[loaded.index];
+            item.fromLoaded(loaded);
+            if (!loaded.ok()) {
+                progress.report(item);
+                continue;
+            }
+            auto job = std::make_unique<Job>();
+            job->index = loaded.index;
+            job->resolution = loaded.grid.resolution;
+            job->grid = std::move(loaded.grid);
+            if (latest_wins) {
+                // Inputs the EDT stage has not started yet are superseded by this one
+                std::vector<JobPtr> stale;
+                to_gvd.pushLatest(std::move(job), &stale);
+                for (const auto& s : stale) {
+                    items[s->index].dropped = true;
+                    progress.report(items[s->index]);
+                    ++dropped;
                 }
+            } else {
+                to_gvd.push(std::move(job));
             }
         }
-        
-        // Draw edges
-        for (const auto& edge : topo_map.edges) {
-            for (size_t i = 1; i < edge.polyline.size(); ++i) {
-                cv::Point p0(static_cast<int>(std::round(edge.polyline[i-1].first / config.input.resolution)),
-                             static_cast<int>(std::round(edge.polyline[i-1].second / config.input.resolution)));
-                cv::Point p1(static_cast<int>(std::round(edge.polyline[i].first / config.input.resolution)),
-                             static_cast<int>(std::round(edge.polyline[i].second / config.input.resolution)));
-                cv::line(vis, p0, p1, cv::Scalar(0,0,255), 1); // edges -> blue
+        to_gvd.close();
+    });
+    std::thread gvd_stage([&]() {
+        JobPtr job;
+        while (to_gvd.pop(job)) {
+            Timer timer;
+            try {
+                job->gvd = generator.run(job->grid);
+            } catch (const std::exception& e) {
+                items[job->index].error = e.what();
+            }
+            job->grid = OccupancyGrid{};
+            items[job->index].gvd_ms = timer.ms();
+            busy_gvd += items[job->index].gvd_ms;
+            if (!items[job->index].error.empty()) {
+                progress.report(items[job->index]);
+                continue;
             }
+            to_topology.push(std::move(job));
         }
-        
-        // Draw nodes
-        for (const auto& node : topo_map.nodes) {
-            cv::Point p(static_cast<int>(std::round(node.x / config.input.resolution)),
-                        static_cast<int>(std::round(node.y / config.input.resolution)));
-            cv::circle(vis, p, 2, cv::Scalar(0,255,0), -1); // nodes -> green
+        to_topology.close();
+    });
+    std::thread topology_stage([&]() {
+        JobPtr job;
+        while (to_topology.pop(job)) {
+            BatchItem& item = items[job->index];
+            Timer timer;
+            try {
+                job->topo = extractor.run(job->gvd, job->resolution);
+                item.nodes = job->topo.nodes.size();
+                item.edges = job->topo.edges.size();
+            } catch (const std::exception& e) {
+                item.error = e.what();
+            }
+            item.topology_ms = timer.ms();
+            busy_topology += item.topology_ms;
+            if (!item.error.empty()) {
+                progress.report(item);
+                continue;
+            }
+            to_write.push(std::move(job));
         }
-        
-        if (!cv::imwrite(config.output.gvd_image, vis)) {
-            std::cerr << "Failed to write " << config.output.gvd_image << std::endl;
-            return;
+        to_write.close();
+    });
+    // The calling thread writes outputs
+    {
+        JobPtr job;
+        while (to_write.pop(job)) {
+            BatchItem& item = items[job->index];
+            Timer timer;
+            try {
+                writeBatchOutputs(config, stems[job->index], job->gvd, job->topo);
+            } catch (const std::exception& e) {
+                item.error = e.what();
+            }
+            item.write_ms = timer.ms();
+            busy_write += item.write_ms;
+            progress.report(item);
         }
-        std::cout << "Wrote overlay: " << config.output.gvd_image << std::endl;
     }
-#endif
+    load_stage.join();
+    gvd_stage.join();
+    topology_stage.join();
+    const double wall_ms = wall.ms();
+    timing_callback_("pipeline", wall_ms);
 
-    // Save topological map visualization
-    if (!config.output.topo_image.empty()) {
-        ScopeTimer timer("topo-visualization", timing_callback_);
-        try {
-            Visualizer::saveTopologicalMapAsImage(topo_map, config.output.topo_image, 1200, 800);
-            std::cout << "Wrote topological map image: " << config.output.topo_image << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "Failed to create topological map image: " << e.what() << std::endl;
-        }
+    // Steady-state throughput is bounded by the busiest stage
+    const double slowest = std::max({busy_load, busy_gvd, busy_topology, busy_write});
+    const size_t processed = static_cast<size_t>(std::count_if(items.begin(), items.end(),
+        [](const BatchItem& it) { return !it.dropped && it.error.empty(); }));
+    std::cout << "pipeline stages busy: load=" << busy_load << " ms, gvd=" << busy_gvd
+              << " ms, topology=" << busy_topology << " ms, write=" << busy_write << " ms";
+    if (slowest > 0.0) {
+        std::cout << " (slowest-stage bound " << processed / (slowest / 1000.0) << " maps/s)";
     }
+    std::cout << std::endl;
+
+    std::ostringstream settings;
+    settings << loader.backend() << ", pipelined, queue=" << depth << ", threads/map=" << threads_per_map
+             << (latest_wins ? ", latest-wins" : "") << ", dropped=" << dropped;
+    std::ostringstream fields;
+    fields << "  \"mode\": \"pipeline\",\n  \"backend\": \"" << loader.backend() << "\",\n"
+           << "  \"queue_depth\": " << depth << ",\n  \"threads_per_map\": " << threads_per_map << ",\n"
+           << "  \"latest_wins\": " << (latest_wins ? "true" : "false") << ",\n"
+           << "  \"dropped\": " << dropped << ",\n"
+           << "  \"stage_busy_ms\": {\"load\": " << busy_load << ", \"gvd\": " << busy_gvd
+           << ", \"topology\": " << busy_topology << ", \"write\": " << busy_write << "},\n";
+    return finishBatch(config, "pipeline", items, stems, wall_ms, settings.str(), fields.str());
+}
+
+int CliApplication::runDaemon(const ConfigOptions& config) {
+    DaemonServer::Options options;
+    options.socket_path = config.daemon.socket_path;
+    options.workers = config.daemon.workers;
+    options.queue_depth = config.daemon.queue_depth;
+    options.max_grid_bytes = static_cast<uint64_t>(config.daemon.grid_budget_mb * 1024.0 * 1024.0);
+    DaemonServer server(config, options);
+    server.serve();
+    return 0;
 }
 
 void CliApplication::printStatistics(const GvdResult& gvd_result, const TopologicalMap& topo_map) {
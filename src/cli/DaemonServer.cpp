@@ -0,0 +1,511 @@
+#include "gvd_topo/cli/DaemonServer.hpp"
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/JsonWriter.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include "gvd_topo/utils/Cancellation.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace gvd_topo {
+
+namespace {
+
+constexpr size_t kMaxLine = 4096;
+constexpr long long kMaxGridCells = 1LL << 30;
+constexpr int kPollMs = 200;
+
+std::atomic<bool> g_signal_stop {false};
+
+void onStopSignal(int) { g_signal_stop = true; }
+
+// Buffered line reader over a connected socket; bulk reads go straight
+// into the caller's buffer once the buffered bytes are used up
+class SocketReader {
+public:
+    explicit SocketReader(int fd) : fd_(fd), buf_(64 * 1024) {}
+
+    // False on EOF or error; throws if the line exceeds kMaxLine
+    bool readLine(std::string& line) {
+        for (;;) {
+            const char* begin = buf_.data() + begin_;
+            const char* nl = static_cast<const char*>(std::memchr(begin, '\n', end_ - begin_));
+            if (nl) {
+                size_t len = static_cast<size_t>(nl - begin);
+                if (len > 0 && begin[len - 1] == '\r') --len;
+                line.assign(begin, len);
+                begin_ += static_cast<size_t>(nl - begin) + 1;
+                return true;
+            }
+            if (end_ - begin_ >= kMaxLine) throw std::runtime_error("request line too long");
+            if (!fill()) return false;
+        }
+    }
+
+    bool readExact(void* dst, size_t n) {
+        auto* out = static_cast<char*>(dst);
+        const size_t buffered = std::min(n, end_ - begin_);
+        std::memcpy(out, buf_.data() + begin_, buffered);
+        begin_ += buffered;
+        size_t got = buffered;
+        while (got < n) {
+            const ssize_t r = ::recv(fd_, out + got, n - got, 0);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            got += static_cast<size_t>(r);
+        }
+        return true;
+    }
+
+    // Discards n bytes, a buffer at a time
+    bool skip(size_t n) {
+        for (;;) {
+            const size_t buffered = std::min(n, end_ - begin_);
+            begin_ += buffered;
+            n -= buffered;
+            if (n == 0) return true;
+            begin_ = end_ = 0;
+            if (!fill()) return false;
+        }
+    }
+
+private:
+    int fd_;
+    std::vector<char> buf_;
+    size_t begin_ {0};
+    size_t end_ {0};
+
+    bool fill() {
+        if (begin_ > 0) {
+            std::memmove(buf_.data(), buf_.data() + begin_, end_ - begin_);
+            end_ -= begin_;
+            begin_ = 0;
+        }
+        for (;;) {
+            const ssize_t r = ::recv(fd_, buf_.data() + end_, buf_.size() - end_, 0);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            end_ += static_cast<size_t>(r);
+            return true;
+        }
+    }
+};
+
+bool sendAll(int fd, const char* data, size_t n) {
+    while (n > 0) {
+        const ssize_t r = ::send(fd, data, n, MSG_NOSIGNAL);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        data += r;
+        n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+bool sendLine(int fd, const std::string& line) {
+    const std::string out = line + "\n";
+    return sendAll(fd, out.data(), out.size());
+}
+
+struct RequestOptions {
+    bool binary {false};
+    double resolution {0.05};
+    int occupancy_threshold {50};
+    double deadline_ms {0.0}; // from receipt, queueing included; 0 = none
+    bool anytime {false};
+    TopologyExtractor::Params topology;
+    bool custom_topology {false}; // topology differs from the daemon's extractor
+};
+
+RequestOptions parseOptions(const std::vector<std::string>& tokens, size_t first, const ConfigOptions& defaults,
+                            const TopologyExtractor::Params& topology) {
+    RequestOptions req;
+    req.resolution = defaults.input.resolution;
+    req.occupancy_threshold = defaults.input.occupancy_threshold;
+    req.topology = topology;
+    req.deadline_ms = defaults.processing.deadline_ms;
+    req.anytime = defaults.processing.anytime;
+    for (size_t i = first; i < tokens.size(); ++i) {
+        const size_t eq = tokens[i].find('=');
+        if (eq == std::string::npos) throw std::runtime_error("expected key=value: " + tokens[i]);
+        const std::string key = tokens[i].substr(0, eq);
+        const std::string value = tokens[i].substr(eq + 1);
+        if (key == "format") {
+            if (value != "json" && value != "binary") throw std::runtime_error("unknown format: " + value);
+            req.binary = value == "binary";
+        } else if (key == "resolution") {
+            req.resolution = std::stod(value);
+            if (!(req.resolution > 0.0)) throw std::runtime_error("resolution must be positive");
+        } else if (key == "occ") {
+            req.occupancy_threshold = std::stoi(value);
+            if (req.occupancy_threshold < 0 || req.occupancy_threshold > 100) {
+                throw std::runtime_error("occ must be within 0-100");
+            }
+        } else if (key == "prune") {
+            req.topology.prune_min_length = std::stod(value);
+            req.custom_topology = true;
+        } else if (key == "merge") {
+            req.topology.merge_radius = std::stod(value);
+            req.custom_topology = true;
+        } else if (key == "clearance") {
+            req.topology.record_clearance_profile = value == "1" || value == "true";
+            req.custom_topology = true;
+        } else if (key == "deadline") {
+            req.deadline_ms = std::stod(value);
+            if (req.deadline_ms < 0.0) throw std::runtime_error("deadline must not be negative");
+        } else if (key == "anytime") {
+            req.anytime = value == "1" || value == "true";
+        } else {
+            throw std::runtime_error("unknown option: " + key);
+        }
+    }
+    return req;
+}
+
+bool hasYamlExtension(const std::string& path) {
+    const std::string ext = std::filesystem::path(path).extension().string();
+    return ext == ".yaml" || ext == ".yml";
+}
+
+// Payload for one request: the serialized topology
+std::string processGrid(const OccupancyGrid& grid, const RequestOptions& req, const ConfigOptions& defaults,
+                        const GvdGenerator& generator, const TopologyExtractor& shared_extractor,
+                        const CancellationToken& deadline) {
+    std::unique_ptr<TopologyExtractor> custom;
+    if (req.custom_topology) custom = std::make_unique<TopologyExtractor>(req.topology);
+    const TopologyExtractor& extractor = custom ? *custom : shared_extractor;
+    TopologicalMap map;
+    if (req.deadline_ms > 0.0) {
+        RunControl control;
+        control.token = &deadline;
+        control.anytime = req.anytime;
+        map = extractor.run(generator.run(grid, control), grid.resolution, control);
+    } else {
+        map = extractor.run(generator.run(grid), grid.resolution);
+    }
+    if (req.binary) {
+        std::string payload(topologyBinarySize(map), '\0');
+        serializeTopologyBinary(map, reinterpret_cast<uint8_t*>(&payload[0]));
+        return payload;
+    }
+    JsonWriteOptions options;
+    options.precision = defaults.output.json_precision;
+    options.parallel = extractor.params().parallel;
+    options.max_threads = extractor.params().max_threads;
+    options.trailing_newline = true;
+    return formatTopologyJson(map, options);
+}
+
+std::vector<std::string> splitTokens(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::istringstream iss(line);
+    std::string t;
+    while (iss >> t) tokens.push_back(t);
+    return tokens;
+}
+
+std::string oneLine(std::string s) {
+    std::replace(s.begin(), s.end(), '\n', ' ');
+    return s;
+}
+
+// Gives back an admitted request's queue slot and GRID bytes
+class Admission {
+public:
+    Admission(std::atomic<int>& pending, std::atomic<uint64_t>& grid_bytes, uint64_t bytes)
+        : pending_(pending), grid_bytes_(grid_bytes), bytes_(bytes) {}
+    ~Admission() {
+        grid_bytes_ -= bytes_;
+        --pending_;
+    }
+    Admission(const Admission&) = delete;
+    Admission& operator=(const Admission&) = delete;
+
+private:
+    std::atomic<int>& pending_;
+    std::atomic<uint64_t>& grid_bytes_;
+    uint64_t bytes_;
+};
+
+} // namespace
+
+struct DaemonServer::Connection {
+    int fd {-1};
+    std::thread thread;
+    std::atomic<bool> done {false};
+
+    ~Connection() {
+        if (thread.joinable()) thread.join();
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+DaemonServer::DaemonServer(const ConfigOptions& defaults, const Options& options)
+    : defaults_(defaults), options_(options) {
+    if (options_.workers <= 0) {
+        options_.workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    options_.queue_depth = std::max(0, options_.queue_depth);
+    options_.max_connections = std::max(1, options_.max_connections);
+
+    const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threads_per_request_ = std::max(1, hw / options_.workers);
+    if (defaults_.processing.max_threads > 0) {
+        threads_per_request_ = std::min(threads_per_request_, defaults_.processing.max_threads);
+    }
+    GvdGenerator::Params gvd_params;
+    gvd_params.use_opencv = defaults_.processing.use_opencv;
+    gvd_params.parallel = defaults_.processing.use_parallel_processing;
+    gvd_params.max_threads = threads_per_request_;
+    generator_ = std::make_unique<GvdGenerator>(gvd_params);
+    TopologyExtractor::Params topo_params;
+    topo_params.record_clearance_profile = defaults_.processing.clearance_profile;
+    topo_params.parallel = gvd_params.parallel;
+    topo_params.max_threads = threads_per_request_;
+    extractor_ = std::make_unique<TopologyExtractor>(topo_params);
+}
+
+DaemonServer::~DaemonServer() {
+    stop();
+    reapConnections(true);
+}
+
+DaemonServer::Stats DaemonServer::stats() const {
+    Stats s;
+    s.served = served_.load();
+    s.rejected = rejected_.load();
+    s.failed = failed_.load();
+    return s;
+}
+
+void DaemonServer::serve() {
+    const std::string& path = options_.socket_path;
+    sockaddr_un addr {};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Invalid daemon socket path: " + path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    // A socket left behind by a previous daemon is replaced; anything else is not touched
+    struct stat st {};
+    if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) throw std::runtime_error("Not a socket, refusing to replace: " + path);
+        ::unlink(path.c_str());
+    }
+
+    const int listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) throw std::runtime_error("Cannot create socket: " + std::string(std::strerror(errno)));
+    if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd, options_.max_connections) != 0) {
+        const std::string err = std::strerror(errno);
+        ::close(listen_fd);
+        throw std::runtime_error("Cannot listen on " + path + ": " + err);
+    }
+
+    pool_ = std::make_unique<ThreadPool>(options_.workers);
+    struct sigaction action {};
+    struct sigaction old_int {};
+    struct sigaction old_term {};
+    action.sa_handler = onStopSignal;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, &old_int);
+    ::sigaction(SIGTERM, &action, &old_term);
+
+    std::cout << "Listening on " << path << " (" << options_.workers << " workers, queue "
+              << options_.queue_depth << ")" << std::endl;
+
+    while (!stop_requested_ && !g_signal_stop) {
+        pollfd pfd {listen_fd, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, kPollMs);
+        reapConnections(false);
+        if (ready <= 0 || !(pfd.revents & POLLIN)) continue;
+        const int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) continue;
+
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (connections_.size() >= static_cast<size_t>(options_.max_connections)) {
+            sendLine(fd, "BUSY " + std::to_string(pending_.load()));
+            ::close(fd);
+            ++rejected_;
+            continue;
+        }
+        auto conn = std::make_unique<Connection>();
+        conn->fd = fd;
+        Connection* c = conn.get();
+        connections_.push_back(std::move(conn));
+        c->thread = std::thread([this, c]() {
+            handleConnection(*c);
+            c->done = true;
+        });
+    }
+
+    ::close(listen_fd);
+    ::unlink(path.c_str());
+    {
+        // Wake connection threads blocked in recv; running requests finish first
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto& c : connections_) ::shutdown(c->fd, SHUT_RDWR);
+    }
+    reapConnections(true);
+    pool_.reset();
+    ::sigaction(SIGINT, &old_int, nullptr);
+    ::sigaction(SIGTERM, &old_term, nullptr);
+    g_signal_stop = false;
+    stop_requested_ = false;
+
+    const Stats s = stats();
+    std::cout << "daemon: served=" << s.served << ", rejected=" << s.rejected
+              << ", failed=" << s.failed << std::endl;
+}
+
+void DaemonServer::reapConnections(bool all) {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        if (all || (*it)->done) {
+            it = connections_.erase(it); // joins, then closes the socket
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DaemonServer::handleConnection(Connection& conn) {
+    const int fd = conn.fd;
+    SocketReader reader(fd);
+    std::string line;
+    for (;;) {
+        try {
+            if (!reader.readLine(line)) return;
+        } catch (const std::exception& e) {
+            ++failed_;
+            return; // cannot resynchronise
+        }
+        const std::vector<std::string> tokens = splitTokens(line);
+        if (tokens.empty()) continue;
+        const std::string& cmd = tokens[0];
+
+        if (cmd == "PING") {
+            if (!sendLine(fd, "OK 0 json")) return;
+            continue;
+        }
+        if (cmd == "STATS") {
+            const Stats s = stats();
+            std::ostringstream json;
+            json << "{\"served\": " << s.served << ", \"rejected\": " << s.rejected << ", \"failed\": "
+                 << s.failed << ", \"pending\": " << pending_.load() << ", \"workers\": " << options_.workers
+                 << ", \"queue_depth\": " << options_.queue_depth << ", \"grid_bytes\": " << grid_bytes_.load()
+                 << "}\n";
+            const std::string payload = json.str();
+            if (!sendLine(fd, "OK " + std::to_string(payload.size()) + " json") ||
+                !sendAll(fd, payload.data(), payload.size())) return;
+            continue;
+        }
+
+        // Parse the request line, then admit it before a GRID payload is
+        // allocated or read; turned-away payloads are drained so the stream
+        // stays at the next request line
+        std::string path;
+        RequestOptions req;
+        int grid_width = 0;
+        int grid_height = 0;
+        uint64_t payload_bytes = 0;
+        try {
+            if (cmd == "PROCESS") {
+                if (tokens.size() < 2) throw std::runtime_error("PROCESS needs a path");
+                path = tokens[1];
+                req = parseOptions(tokens, 2, defaults_, extractor_->params());
+            } else if (cmd == "GRID") {
+                long long w = 0;
+                long long h = 0;
+                try {
+                    if (tokens.size() < 3) throw std::runtime_error("GRID needs width and height");
+                    w = std::stoll(tokens[1]);
+                    h = std::stoll(tokens[2]);
+                } catch (const std::exception&) {
+                    w = 0;
+                }
+                if (w <= 0 || h <= 0 || w > kMaxGridCells / h) {
+                    sendLine(fd, "ERR invalid grid size");
+                    ++failed_;
+                    return; // payload length unknown
+                }
+                grid_width = static_cast<int>(w);
+                grid_height = static_cast<int>(h);
+                payload_bytes = static_cast<uint64_t>(w * h);
+                if (payload_bytes > options_.max_grid_bytes) {
+                    throw std::runtime_error("grid exceeds the daemon's " + std::to_string(options_.max_grid_bytes) +
+                                             " byte budget");
+                }
+                req = parseOptions(tokens, 3, defaults_, extractor_->params());
+            } else {
+                throw std::runtime_error("unknown command: " + cmd);
+            }
+        } catch (const std::exception& e) {
+            ++failed_;
+            if (!reader.skip(payload_bytes) || !sendLine(fd, "ERR " + oneLine(e.what()))) return;
+            continue;
+        }
+
+        const int limit = options_.workers + options_.queue_depth;
+        const bool queue_full = pending_.fetch_add(1) >= limit;
+        const bool budget_full = !queue_full && grid_bytes_.fetch_add(payload_bytes) + payload_bytes >
+                                                    options_.max_grid_bytes;
+        if (queue_full || budget_full) {
+            if (budget_full) grid_bytes_ -= payload_bytes;
+            const int now = --pending_;
+            ++rejected_;
+            if (!reader.skip(payload_bytes) || !sendLine(fd, "BUSY " + std::to_string(now))) return;
+            continue;
+        }
+        std::string payload;
+        std::string error;
+        {
+            const Admission admission(pending_, grid_bytes_, payload_bytes);
+            std::shared_ptr<OccupancyGrid> grid;
+            if (payload_bytes > 0) {
+                grid = std::make_shared<OccupancyGrid>(grid_width, grid_height, req.resolution);
+                if (!reader.readExact(grid->data.data(), grid->data.size())) return;
+            }
+            auto deadline = std::make_shared<CancellationToken>();
+            if (req.deadline_ms > 0.0) deadline->setBudget(req.deadline_ms);
+            std::future<std::string> result = pool_->submit([&, grid, path, req, deadline]() {
+                if (grid) return processGrid(*grid, req, defaults_, *generator_, *extractor_, *deadline);
+                const OccupancyGrid loaded = hasYamlExtension(path)
+                    ? YamlLoader::loadFromYaml(path, req.occupancy_threshold)
+                    : OccupancyGrid::loadFromImage(path, req.resolution, req.occupancy_threshold);
+                return processGrid(loaded, req, defaults_, *generator_, *extractor_, *deadline);
+            });
+            try {
+                payload = result.get();
+            } catch (const std::exception& e) {
+                error = oneLine(e.what());
+            }
+        }
+        if (!error.empty()) {
+            ++failed_;
+            if (!sendLine(fd, "ERR " + error)) return;
+            continue;
+        }
+        ++served_;
+        const std::string header = "OK " + std::to_string(payload.size()) + (req.binary ? " binary" : " json");
+        if (!sendLine(fd, header) || !sendAll(fd, payload.data(), payload.size())) return;
+    }
+}
+
+} // namespace gvd_topo
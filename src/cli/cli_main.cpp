@@ -14,7 +14,9 @@ int main(int argc, char** argv) {
     
     // Load configuration from file if specified
     if (!config_manager.getConfig().input.image_file.empty() || 
-        !config_manager.getConfig().input.yaml_file.empty()) {
+        !config_manager.getConfig().input.yaml_file.empty() ||
+        config_manager.getConfig().batch.enabled() ||
+        config_manager.getConfig().daemon.enabled()) {
         // Configuration already loaded from command line
     } else {
         // Try to load from default config file
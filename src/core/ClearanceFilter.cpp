@@ -0,0 +1,45 @@
+#include "gvd_topo/core/ClearanceFilter.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+
+namespace gvd_topo {
+
+std::vector<uint8_t> filterGvdByClearance(const GvdResult& gvd, double radius) {
+    std::vector<uint8_t> mask(gvd.gvd_mask.size(), 0);
+    if (gvd.distance.size() != gvd.gvd_mask.size()) return mask;
+    const float r = static_cast<float>(radius);
+    const uint8_t* src = gvd.gvd_mask.data();
+    const float* dist = gvd.distance.data();
+    uint8_t* dst = mask.data();
+    const long n = static_cast<long>(mask.size());
+    // Branch-free so the compiler can vectorise the compare/select. Radii
+    // already run in parallel, so this stays on the calling thread.
+    #ifdef GVD_TOPO_WITH_OPENMP
+    #pragma omp simd
+    #endif
+    for (long i = 0; i < n; ++i) {
+        dst[i] = static_cast<uint8_t>(src[i] & ((dist[i] >= r) ? 0xFF : 0x00));
+    }
+    return mask;
+}
+
+std::vector<RadiusTopology> extractForRadii(const GvdResult& gvd,
+                                            const std::vector<double>& radii,
+                                            const TopologyExtractor& extractor,
+                                            double resolution) {
+    std::vector<RadiusTopology> out(radii.size());
+    const TopologyExtractor::Params& params = extractor.params();
+    const int threads = params.parallel ? params.max_threads : 1;
+    // One radius per task; each extraction's own loops share the same pool
+    ThreadPool::shared().parallelFor(0, static_cast<int>(radii.size()), threads, [&](int i0, int i1) {
+        for (int i = i0; i < i1; ++i) {
+            RadiusTopology& r = out[i];
+            r.radius = radii[i];
+            r.gvd_mask = filterGvdByClearance(gvd, radii[i]);
+            // Through the GvdResult, so scale and ROI offset place nodes in the map
+            r.map = extractor.run(gvd, r.gvd_mask, resolution);
+        }
+    });
+    return out;
+}
+
+} // namespace gvd_topo
@@ -1,5 +1,14 @@
 #include "gvd_topo/core/GvdGenerator.hpp"
 #include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/utils/Cancellation.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <stdexcept>
 #ifdef GVD_TOPO_WITH_OPENCV
 #include <opencv2/imgproc.hpp>
 #include <opencv2/core.hpp>
@@ -7,18 +16,223 @@
 
 namespace gvd_topo {
 
-GvdGenerator::GvdGenerator() = default;
-GvdGenerator::GvdGenerator(const Params& p) : params_(p) {}
+namespace {
 
-GvdResult GvdGenerator::run(const OccupancyGrid& grid) const {
+constexpr int8_t kOccupied = static_cast<int8_t>(100);
+constexpr float kInf = std::numeric_limits<float>::infinity();
+
+// Pool loops of one run: the thread budget plus optional cancellation and
+// progress. Work is cut into bands of kBand rows (or columns) and the token
+// is polled before each band; once it trips the remaining bands are skipped.
+class Loops {
+public:
+    static constexpr int kBand = 64;
+
+    explicit Loops(int threads, const RunControl* control = nullptr, double total_units = 1.0)
+        : threads_(threads), control_(control), meter_(control, total_units) {}
+
+    // body(lo, hi) over [begin, end); each index is worth `units` of progress
+    template <typename Body>
+    void forBands(int begin, int end, double units, Body&& body) {
+        if (end <= begin) return;
+        const int bands = (end - begin + kBand - 1) / kBand;
+        ThreadPool::shared().parallelFor(0, bands, threads_, [&](int b0, int b1) {
+            for (int b = b0; b < b1; ++b) {
+                if (stopRequested()) return;
+                const int lo = begin + b * kBand;
+                const int hi = std::min(end, lo + kBand);
+                body(lo, hi);
+                meter_.add((hi - lo) * units);
+            }
+        });
+    }
+
+    bool stopRequested() {
+        if (stopped_.load(std::memory_order_relaxed)) return true;
+        if (control_ && control_->stopRequested()) {
+            stopped_.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+    bool stopped() const { return stopped_.load(std::memory_order_relaxed); }
+    int threads() const { return threads_; }
+    void advance(double units) { meter_.add(units); }
+    void finish() { meter_.finish(); }
+
+private:
+    int threads_;
+    const RunControl* control_;
+    ProgressMeter meter_;
+    std::atomic<bool> stopped_ {false};
+};
+
+// First (row-wise) pass of the separable exact EDT: distance in pixels to the
+// nearest occupied cell on the same row, +inf when the row has none
+void rowPass(const int8_t* cells, float* out, int w) {
+    float d = kInf;
+    for (int x = 0; x < w; ++x) {
+        d = (cells[x] == kOccupied) ? 0.0f : d + 1.0f;
+        out[x] = d;
+    }
+    d = kInf;
+    for (int x = w - 1; x >= 0; --x) {
+        d = (cells[x] == kOccupied) ? 0.0f : d + 1.0f;
+        out[x] = std::min(out[x], d);
+    }
+}
+
+void rowPassBand(const int8_t* cells, float* out, int w, int rows, Loops& loops) {
+    loops.forBands(0, rows, w, [=](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            rowPass(cells + static_cast<size_t>(y) * w, out + static_cast<size_t>(y) * w, w);
+        }
+    });
+}
+
+// Second pass (Felzenszwalb & Huttenlocher lower envelope of parabolas) over
+// each column; converts the row distances in place to metric Euclidean distance
+template <typename Result>
+void columnPasses(Result& result, double resolution, Loops& loops) {
+    const int w = result.width;
+    const int h = result.height;
+    // Stand-in for "no obstacle anywhere": longer than any in-map distance
+    const float unbounded = static_cast<float>(std::hypot(w, h) * resolution);
+    float* dist = result.distance.data();
+    loops.forBands(0, w, h, [=](int x0, int x1) {
+        std::vector<double> f(h);
+        std::vector<int> v(h);
+        std::vector<double> z(static_cast<size_t>(h) + 1);
+        for (int x = x0; x < x1; ++x) {
+            int k = -1;
+            for (int q = 0; q < h; ++q) {
+                const float r = dist[static_cast<size_t>(q) * w + x];
+                if (r == kInf) continue;
+                f[q] = static_cast<double>(r) * r;
+                const double fq = f[q] + static_cast<double>(q) * q;
+                if (k < 0) {
+                    k = 0; v[0] = q; z[0] = -std::numeric_limits<double>::infinity();
+                    z[1] = std::numeric_limits<double>::infinity();
+                    continue;
+                }
+                double s = (fq - (f[v[k]] + static_cast<double>(v[k]) * v[k])) / (2.0 * (q - v[k]));
+                while (s <= z[k]) {
+                    --k;
+                    s = (fq - (f[v[k]] + static_cast<double>(v[k]) * v[k])) / (2.0 * (q - v[k]));
+                }
+                ++k;
+                v[k] = q;
+                z[k] = s;
+                z[k + 1] = std::numeric_limits<double>::infinity();
+            }
+            if (k < 0) {
+                for (int q = 0; q < h; ++q) dist[static_cast<size_t>(q) * w + x] = unbounded;
+                continue;
+            }
+            int j = 0;
+            for (int q = 0; q < h; ++q) {
+                while (z[j + 1] < q) ++j;
+                const double dy = static_cast<double>(q - v[j]);
+                const double d2 = dy * dy + f[v[j]];
+                dist[static_cast<size_t>(q) * w + x] = static_cast<float>(std::sqrt(d2) * resolution);
+            }
+        }
+    });
+}
+
+// Row pass straight from 2-bit cells; each chunk unpacks into one row buffer
+void rowPassPacked(const PackedOccupancy& grid, float* out, Loops& loops) {
+    const int w = grid.width;
+    loops.forBands(0, grid.height, w, [&grid, out, w](int y0, int y1) {
+        std::vector<int8_t> cells(static_cast<size_t>(w));
+        for (int y = y0; y < y1; ++y) {
+            grid.unpackRow(y, cells.data());
+            rowPass(cells.data(), out + static_cast<size_t>(y) * w, w);
+        }
+    });
+}
+
+// Ridge detection: 8-neighborhood local maxima on distance map. Rows are
+// split across threads, so mark(x, y) only ever touches its own row.
+template <typename Result, typename Mark>
+void detectRidges(Result& result, Loops& loops, Mark&& mark) {
+    const int w = result.width;
+    const int h = result.height;
+    const float eps = 1e-6f;
+    loops.forBands(1, h - 1, w, [&result, &mark, w, eps](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            for (int x = 1; x < w - 1; ++x) {
+                float c = result.distance[y * w + x];
+                if (c <= eps) continue;
+                bool is_max = true;
+                for (int ddy = -1; ddy <= 1 && is_max; ++ddy) {
+                    for (int ddx = -1; ddx <= 1; ++ddx) {
+                        if (ddx == 0 && ddy == 0) continue;
+                        if (result.distance[(y + ddy) * w + (x + ddx)] > c + eps) { is_max = false; break; }
+                    }
+                }
+                if (is_max) mark(x, y);
+            }
+        }
+    });
+}
+
+void detectRidges(GvdResult& result, Loops& loops) {
+    detectRidges(result, loops, [&result](int x, int y) { result.gvd_mask[y * result.width + x] = 255; });
+}
+
+// Thread budget for the pool loops: 1 runs them inline on the caller
+int loopThreads(const GvdGenerator::Params& params) {
+    return params.parallel ? params.max_threads : 1;
+}
+
+// Anytime fallback level: the native pipeline on a copy of the grid reduced
+// by `factor` per side, where a block is occupied if any of its cells is.
+// Never polls the token, so a fallback always exists.
+GvdResult coarseLevel(const OccupancyGrid& grid, int factor, int threads) {
+    OccupancyGrid coarse((grid.width + factor - 1) / factor, (grid.height + factor - 1) / factor,
+                         grid.resolution * factor);
+    Loops loops(threads);
+    loops.forBands(0, coarse.height, 1.0, [&](int cy0, int cy1) {
+        for (int cy = cy0; cy < cy1; ++cy) {
+            const int y_end = std::min(grid.height, (cy + 1) * factor);
+            for (int cx = 0; cx < coarse.width; ++cx) {
+                const int x_end = std::min(grid.width, (cx + 1) * factor);
+                bool occupied = false;
+                for (int y = cy * factor; y < y_end && !occupied; ++y) {
+                    for (int x = cx * factor; x < x_end; ++x) {
+                        if (grid.data[grid.index(x, y)] == kOccupied) { occupied = true; break; }
+                    }
+                }
+                coarse.data[coarse.index(cx, cy)] = occupied ? kOccupied : 0;
+            }
+        }
+    });
+    GvdResult result;
+    result.width = coarse.width;
+    result.height = coarse.height;
+    result.scale = factor;
+    result.complete = false;
+    result.distance.assign(static_cast<size_t>(coarse.width) * static_cast<size_t>(coarse.height), 0.0f);
+    result.gvd_mask.assign(result.distance.size(), 0);
+    rowPassBand(coarse.data.data(), result.distance.data(), coarse.width, coarse.height, loops);
+    columnPasses(result, coarse.resolution, loops);
+    detectRidges(result, loops);
+    return result;
+}
+
+// run() body on the given loops: OpenCV EDT when enabled, else the native one
+GvdResult generate(const OccupancyGrid& grid, [[maybe_unused]] const GvdGenerator::Params& params, Loops& loops) {
     GvdResult result;
     result.width = grid.width;
     result.height = grid.height;
     result.distance.assign(static_cast<size_t>(grid.width * grid.height), 0.0f);
     result.gvd_mask.assign(static_cast<size_t>(grid.width * grid.height), 0);
+    if (grid.empty()) return result;
     // Simple EDT via OpenCV if available
 #ifdef GVD_TOPO_WITH_OPENCV
-    if (!grid.empty()) {
+    if (params.use_opencv) {
+        if (loops.stopRequested()) return result; // distanceTransform cannot be interrupted
         cv::Mat occ(grid.height, grid.width, CV_8UC1);
         for (int y = 0; y < grid.height; ++y) {
             uint8_t* row = occ.ptr<uint8_t>(y);
@@ -36,35 +250,202 @@ GvdResult GvdGenerator::run(const OccupancyGrid& grid) const {
                 result.distance[grid.index(x, y)] = row[x] * static_cast<float>(grid.resolution);
             }
         }
+        detectRidges(result, loops);
+        return result;
+    }
+#endif
+    // Native exact EDT
+    rowPassBand(grid.data.data(), result.distance.data(), grid.width, grid.height, loops);
+    columnPasses(result, grid.resolution, loops);
+    detectRidges(result, loops);
+    return result;
+}
 
-        // Ridge detection: 8-neighborhood local maxima on distance map
-        const int w = grid.width;
-        const int h = grid.height;
-        const float eps = 1e-6f;
-        #ifdef GVD_TOPO_WITH_OPENMP
-        #pragma omp parallel for schedule(static)
-        #endif
-        for (int y = 1; y < h - 1; ++y) {
-            for (int x = 1; x < w - 1; ++x) {
-                float c = result.distance[y * w + x];
-                if (c <= eps) continue;
-                bool is_max = true;
-                for (int ddy = -1; ddy <= 1 && is_max; ++ddy) {
-                    for (int ddx = -1; ddx <= 1; ++ddx) {
-                        if (ddx == 0 && ddy == 0) continue;
-                        if (result.distance[(y + ddy) * w + (x + ddx)] > c + eps) { is_max = false; break; }
-                    }
-                }
-                if (is_max) {
-                    result.gvd_mask[y * w + x] = 255;
-                }
-            }
-        }
+// Copy of the cells of grid inside box (already clipped to it)
+OccupancyGrid cropGrid(const OccupancyGrid& grid, const Roi& box) {
+    OccupancyGrid crop(box.width(), box.height(), grid.resolution);
+    for (int y = 0; y < crop.height; ++y) {
+        std::memcpy(&crop.data[crop.index(0, y)], &grid.data[grid.index(box.x0, box.y0 + y)],
+                    static_cast<size_t>(crop.width));
     }
+    return crop;
+}
+
+} // namespace
+
+Roi Roi::clippedTo(int width, int height) const {
+    return {std::max(x0, 0), std::max(y0, 0), std::min(x1, width), std::min(y1, height)};
+}
+
+Roi Roi::fromWorld(const OccupancyGrid& grid, double min_x, double min_y, double max_x, double max_y) {
+    const double res = grid.resolution;
+    return {static_cast<int>(std::floor((min_x - grid.origin.x) / res)),
+            static_cast<int>(std::floor((min_y - grid.origin.y) / res)),
+            static_cast<int>(std::floor((max_x - grid.origin.x) / res)) + 1,
+            static_cast<int>(std::floor((max_y - grid.origin.y) / res)) + 1};
+}
+
+GvdGenerator::GvdGenerator() = default;
+GvdGenerator::GvdGenerator(const Params& p) : params_(p) {}
+
+bool GvdGenerator::usesOpenCvEdt(const Params& p) {
+#ifdef GVD_TOPO_WITH_OPENCV
+    return p.use_opencv;
+#else
+    (void)p;
+    return false;
 #endif
+}
+
+GvdResult GvdGenerator::run(const OccupancyGrid& grid) const {
+    Loops loops(loopThreads(params_));
+    return generate(grid, params_, loops);
+}
+
+GvdResult GvdGenerator::run(const OccupancyGrid& grid, const RunControl& control) const {
+    const double cells = static_cast<double>(grid.width) * static_cast<double>(grid.height);
+    const int factor = std::max(2, params_.anytime_factor);
+    // Three passes of one unit per cell, plus the coarse level in anytime mode
+    const double coarse_units = control.anytime ? 3.0 * cells / (factor * factor) : 0.0;
+    Loops loops(loopThreads(params_), &control, coarse_units + 3.0 * cells);
+    GvdResult coarse;
+    if (control.anytime && !grid.empty()) {
+        coarse = coarseLevel(grid, factor, loops.threads());
+        loops.advance(coarse_units);
+    }
+    GvdResult result = generate(grid, params_, loops);
+    if (!loops.stopped()) {
+        loops.finish();
+        return result;
+    }
+    if (!control.anytime) throw Cancelled("GVD generation stopped before completion");
+    return coarse;
+}
+
+GvdResult GvdGenerator::run(const OccupancyGrid& grid, const Roi& roi) const {
+    const Roi box = roi.clippedTo(grid.width, grid.height);
+    GvdResult result;
+    result.offset_x = box.x0;
+    result.offset_y = box.y0;
+    if (grid.empty() || box.empty()) return result;
+    result.width = box.width();
+    result.height = box.height();
+
+    // Ridge detection reads the 8-neighbours, so distances must be exact one
+    // cell beyond the ROI as well
+    const Roi exact = box.grown(1).clippedTo(grid.width, grid.height);
+    Loops loops(loopThreads(params_));
+    constexpr int kInitialMargin = 32;
+    int margin = kInitialMargin;
+    GvdResult area;
+    Roi crop_box;
+    for (;;) {
+        crop_box = exact.grown(margin).clippedTo(grid.width, grid.height);
+        const OccupancyGrid crop = cropGrid(grid, crop_box);
+        area.width = crop.width;
+        area.height = crop.height;
+        area.distance.assign(static_cast<size_t>(crop.width) * static_cast<size_t>(crop.height), 0.0f);
+        rowPassBand(crop.data.data(), area.distance.data(), crop.width, crop.height, loops);
+        columnPasses(area, crop.resolution, loops);
+        // Obstacles the crop leaves out only make its distances too long. A
+        // cell whose crop distance is within the margin is exact: any closer
+        // obstacle would lie inside the crop too. Otherwise the largest crop
+        // distance bounds the true one and becomes the next margin; with no
+        // obstacle in reach at all the margin quadruples.
+        float worst = 0.0f;
+        for (int y = exact.y0; y < exact.y1; ++y) {
+            const float* row = &area.distance[static_cast<size_t>(y - crop_box.y0) * crop.width];
+            for (int x = exact.x0; x < exact.x1; ++x) worst = std::max(worst, row[x - crop_box.x0]);
+        }
+        const bool whole_map = crop_box.x0 == 0 && crop_box.y0 == 0 && crop_box.x1 == grid.width &&
+                               crop_box.y1 == grid.height;
+        if (whole_map || worst <= static_cast<float>(margin * grid.resolution)) break;
+        margin = std::isfinite(worst) ? static_cast<int>(std::ceil(worst / grid.resolution)) + 1
+                                      : 4 * margin;
+    }
+    area.gvd_mask.assign(area.distance.size(), 0);
+    detectRidges(area, loops);
+
+    result.distance.resize(static_cast<size_t>(result.width) * static_cast<size_t>(result.height));
+    result.gvd_mask.resize(result.distance.size());
+    for (int y = 0; y < result.height; ++y) {
+        const size_t src = static_cast<size_t>(box.y0 + y - crop_box.y0) * area.width + (box.x0 - crop_box.x0);
+        const size_t dst = static_cast<size_t>(y) * result.width;
+        std::copy_n(&area.distance[src], result.width, &result.distance[dst]);
+        std::copy_n(&area.gvd_mask[src], result.width, &result.gvd_mask[dst]);
+    }
     return result;
 }
 
-} // namespace gvd_topo
+std::vector<float> GvdGenerator::distanceField(const OccupancyGrid& grid) const {
+    GvdResult result;
+    result.width = grid.width;
+    result.height = grid.height;
+    if (grid.empty()) return std::move(result.distance);
+    result.distance.assign(static_cast<size_t>(grid.width) * static_cast<size_t>(grid.height), 0.0f);
+    Loops loops(loopThreads(params_));
+    rowPassBand(grid.data.data(), result.distance.data(), grid.width, grid.height, loops);
+    columnPasses(result, grid.resolution, loops);
+    return std::move(result.distance);
+}
 
+GvdResult GvdGenerator::runStreaming(RowBandSource& source, OccupancyGrid* grid_out) const {
+    const int w = source.width();
+    const int h = source.height();
+    GvdResult result;
+    result.width = w;
+    result.height = h;
+    if (w <= 0 || h <= 0) return result;
+    result.distance.assign(static_cast<size_t>(w) * static_cast<size_t>(h), 0.0f);
+    result.gvd_mask.assign(static_cast<size_t>(w) * static_cast<size_t>(h), 0);
+    if (grid_out) *grid_out = OccupancyGrid(w, h, source.resolution());
+    Loops loops(loopThreads(params_));
+
+    // Two band buffers: one being decoded while the other feeds the row pass
+    const int band_rows = std::max(1, params_.stream_band_rows);
+    std::vector<int8_t> bands[2];
+    bands[0].resize(static_cast<size_t>(band_rows) * w);
+    bands[1].resize(static_cast<size_t>(band_rows) * w);
+    auto fetch = [&source, &bands, band_rows](int slot) {
+        return source.readBand(bands[slot].data(), band_rows);
+    };
+
+    std::future<int> pending = std::async(std::launch::async, fetch, 0);
+    int slot = 0;
+    int y = 0;
+    while (y < h) {
+        const int rows = std::min(pending.get(), h - y);
+        if (rows <= 0) break;
+        if (y + rows < h) pending = std::async(std::launch::async, fetch, slot ^ 1);
+        const int8_t* cells = bands[slot].data();
+        rowPassBand(cells, result.distance.data() + static_cast<size_t>(y) * w, w, rows, loops);
+        if (grid_out) {
+            std::memcpy(grid_out->data.data() + static_cast<size_t>(y) * w, cells, static_cast<size_t>(rows) * w);
+        }
+        y += rows;
+        slot ^= 1;
+    }
+    if (y < h) {
+        throw std::runtime_error("Row band source ended before the last row");
+    }
 
+    columnPasses(result, source.resolution(), loops);
+    detectRidges(result, loops);
+    return result;
+}
+
+PackedGvdResult GvdGenerator::runPacked(const PackedOccupancy& grid) const {
+    PackedGvdResult result;
+    result.width = grid.width;
+    result.height = grid.height;
+    result.gvd_mask = PackedMask(grid.width, grid.height);
+    if (grid.empty()) return result;
+    result.distance.assign(static_cast<size_t>(grid.width) * static_cast<size_t>(grid.height), 0.0f);
+    Loops loops(loopThreads(params_));
+    rowPassPacked(grid, result.distance.data(), loops);
+    columnPasses(result, grid.resolution, loops);
+    detectRidges(result, loops, [&result](int x, int y) { result.gvd_mask.set(x, y); });
+    return result;
+}
+
+} // namespace gvd_topo
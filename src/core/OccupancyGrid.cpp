@@ -1,4 +1,5 @@
 #include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/io/PgmLoader.hpp"
 #include <fstream>
 #include <stdexcept>
 #include <random>
@@ -14,6 +15,10 @@ OccupancyGrid::OccupancyGrid(int w, int h, double res)
     : width(w), height(h), resolution(res), data(static_cast<size_t>(w) * static_cast<size_t>(h), static_cast<int8_t>(-1)) {}
 
 OccupancyGrid OccupancyGrid::loadFromImage(const std::string& path, double res, int occ_threshold) {
+    // Binary PGM goes through the native mmap loader (same threshold rule)
+    if (PgmLoader::isPgm(path)) {
+        return PgmLoader::load(path, res, occ_threshold);
+    }
 #ifdef GVD_TOPO_WITH_OPENCV
     cv::Mat img = cv::imread(path, cv::IMREAD_GRAYSCALE);
     if (img.empty()) {
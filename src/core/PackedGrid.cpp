@@ -0,0 +1,181 @@
+#include "gvd_topo/core/PackedGrid.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace gvd_topo {
+
+namespace {
+
+// SWAR helpers: eight byte lanes per 64-bit word
+constexpr uint64_t kLow7 = 0x7F7F7F7F7F7F7F7Full;
+constexpr uint64_t kHigh = 0x8080808080808080ull;
+constexpr uint64_t kOnes = 0x0101010101010101ull;
+
+// High bit of each lane set iff the lane is non-zero (exact, no carries)
+inline uint64_t nonzeroLanes(uint64_t x) { return (((x & kLow7) + kLow7) | x) & kHigh; }
+
+// Lane high bits -> 8-bit mask, lane i to bit i
+inline uint32_t gatherLanes(uint64_t high_bits) {
+    return static_cast<uint32_t>(((high_bits >> 7) * 0x0102040810204080ull) >> 56);
+}
+
+// 8-bit mask -> 0x01 in each lane whose bit is set
+inline uint64_t spreadLanes(uint32_t bits) {
+    const uint64_t m = (static_cast<uint64_t>(bits & 0xFFu) * kOnes) & 0x8040201008040201ull;
+    return nonzeroLanes(m) >> 7;
+}
+
+// 8 bits -> even bit positions of 16, and back
+inline uint32_t interleaveZero(uint32_t x) {
+    x = (x | (x << 4)) & 0x0F0Fu;
+    x = (x | (x << 2)) & 0x3333u;
+    return (x | (x << 1)) & 0x5555u;
+}
+inline uint32_t compactEven(uint32_t x) {
+    x &= 0x5555u;
+    x = (x | (x >> 1)) & 0x3333u;
+    x = (x | (x >> 2)) & 0x0F0Fu;
+    return (x | (x >> 4)) & 0x00FFu;
+}
+
+inline uint64_t load8(const void* p, size_t n) {
+    uint64_t v = 0;
+    std::memcpy(&v, p, n);
+    return v;
+}
+
+inline void store8(void* p, uint64_t v, size_t n) { std::memcpy(p, &v, n); }
+
+// Rows are independent; blocks of them run on the shared pool
+template <typename Fn>
+void forRows(int rows, Fn&& fn) {
+    ThreadPool::shared().parallelFor(0, rows, 0, [&](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) fn(y);
+    }, 64);
+}
+
+} // namespace
+
+PackedOccupancy::PackedOccupancy(int w, int h, double res)
+    : width(w), height(h), resolution(res) {
+    // 0xAA.. = every 2-bit code set to kUnknown
+    words.assign(wordsPerRow() * static_cast<size_t>(std::max(h, 0)), 0xAAAAAAAAAAAAAAAAull);
+}
+
+PackedOccupancy PackedOccupancy::fromGrid(const OccupancyGrid& grid) {
+    PackedOccupancy packed(grid.width, grid.height, grid.resolution);
+    packed.origin = grid.origin;
+    if (grid.empty()) return packed;
+    forRows(grid.height, [&](int y) { packed.packRow(y, grid.data.data() + static_cast<size_t>(y) * grid.width); });
+    return packed;
+}
+
+OccupancyGrid PackedOccupancy::toGrid() const {
+    OccupancyGrid grid(width, height, resolution);
+    grid.origin = origin;
+    if (empty()) return grid;
+    forRows(height, [&](int y) { unpackRow(y, grid.data.data() + static_cast<size_t>(y) * width); });
+    return grid;
+}
+
+Cell PackedOccupancy::get(int x, int y) const {
+    const uint64_t code = (row(y)[x / kCellsPerWord] >> (2 * (x % kCellsPerWord))) & 3u;
+    if (code == kOccupied) return Cell::Occupied;
+    if (code == kFree) return Cell::Free;
+    return Cell::Unknown;
+}
+
+void PackedOccupancy::set(int x, int y, Cell c) {
+    const uint64_t code = c == Cell::Occupied ? kOccupied : (c == Cell::Free ? kFree : kUnknown);
+    uint64_t& word = row(y)[x / kCellsPerWord];
+    const int shift = 2 * (x % kCellsPerWord);
+    word = (word & ~(uint64_t(3) << shift)) | (code << shift);
+}
+
+void PackedOccupancy::packRow(int y, const int8_t* in) {
+    uint64_t* out = row(y);
+    const uint64_t occupied_lanes = kOnes * static_cast<uint8_t>(Cell::Occupied);
+    for (size_t w = 0; w < wordsPerRow(); ++w) {
+        uint64_t word = 0;
+        const size_t base = w * kCellsPerWord;
+        for (int g = 0; g < 4 && base + 8 * g < static_cast<size_t>(width); ++g) {
+            const size_t start = base + 8 * static_cast<size_t>(g);
+            const size_t n = std::min<size_t>(8, static_cast<size_t>(width) - start);
+            // Lanes past the row end load as 0 and pack as free
+            const uint64_t lanes = load8(in + start, n);
+            const uint32_t occ = gatherLanes(~nonzeroLanes(lanes ^ occupied_lanes) & kHigh);
+            const uint32_t unk = gatherLanes(lanes & kHigh);
+            word |= static_cast<uint64_t>(interleaveZero(occ) | (interleaveZero(unk) << 1)) << (16 * g);
+        }
+        out[w] = word;
+    }
+}
+
+void PackedOccupancy::unpackRow(int y, int8_t* out) const {
+    const uint64_t* in = row(y);
+    const uint64_t occupied_value = static_cast<uint8_t>(Cell::Occupied);
+    const uint64_t unknown_value = static_cast<uint8_t>(Cell::Unknown);
+    for (size_t w = 0; w < wordsPerRow(); ++w) {
+        const uint64_t word = in[w];
+        const size_t base = w * kCellsPerWord;
+        for (int g = 0; g < 4 && base + 8 * g < static_cast<size_t>(width); ++g) {
+            const uint32_t codes = static_cast<uint32_t>(word >> (16 * g)) & 0xFFFFu;
+            const uint64_t lanes = spreadLanes(compactEven(codes)) * occupied_value |
+                                   spreadLanes(compactEven(codes >> 1)) * unknown_value;
+            const size_t start = base + 8 * static_cast<size_t>(g);
+            store8(out + start, lanes, std::min<size_t>(8, static_cast<size_t>(width) - start));
+        }
+    }
+}
+
+PackedMask::PackedMask(int w, int h) : width(w), height(h) {
+    words.assign(wordsPerRow() * static_cast<size_t>(std::max(h, 0)), 0);
+}
+
+PackedMask PackedMask::fromBytes(const std::vector<uint8_t>& mask, int w, int h) {
+    PackedMask packed(w, h);
+    if (mask.size() < static_cast<size_t>(w) * static_cast<size_t>(h)) return packed;
+    forRows(h, [&](int y) { packed.packRow(y, mask.data() + static_cast<size_t>(y) * w); });
+    return packed;
+}
+
+std::vector<uint8_t> PackedMask::toBytes() const {
+    std::vector<uint8_t> out(static_cast<size_t>(width) * static_cast<size_t>(height));
+    forRows(height, [&](int y) { unpackRow(y, out.data() + static_cast<size_t>(y) * width); });
+    return out;
+}
+
+size_t PackedMask::count() const {
+    size_t n = 0;
+    for (uint64_t w : words) n += static_cast<size_t>(__builtin_popcountll(w));
+    return n;
+}
+
+void PackedMask::packRow(int y, const uint8_t* in) {
+    uint64_t* out = row(y);
+    for (size_t w = 0; w < wordsPerRow(); ++w) {
+        uint64_t word = 0;
+        const size_t base = w * 64;
+        for (int g = 0; g < 8 && base + 8 * g < static_cast<size_t>(width); ++g) {
+            const size_t start = base + 8 * static_cast<size_t>(g);
+            const size_t n = std::min<size_t>(8, static_cast<size_t>(width) - start);
+            word |= static_cast<uint64_t>(gatherLanes(nonzeroLanes(load8(in + start, n)))) << (8 * g);
+        }
+        out[w] = word;
+    }
+}
+
+void PackedMask::unpackRow(int y, uint8_t* out) const {
+    const uint64_t* in = row(y);
+    for (size_t w = 0; w < wordsPerRow(); ++w) {
+        const size_t base = w * 64;
+        for (int g = 0; g < 8 && base + 8 * g < static_cast<size_t>(width); ++g) {
+            const size_t start = base + 8 * static_cast<size_t>(g);
+            const uint64_t lanes = spreadLanes(static_cast<uint32_t>(in[w] >> (8 * g))) * 0xFFu;
+            store8(out + start, lanes, std::min<size_t>(8, static_cast<size_t>(width) - start));
+        }
+    }
+}
+
+} // namespace gvd_topo
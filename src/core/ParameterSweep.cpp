@@ -0,0 +1,90 @@
+#include "gvd_topo/core/ParameterSweep.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include "gvd_topo/utils/Timer.hpp"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace gvd_topo {
+
+std::vector<double> parseSweepValues(const std::string& spec) {
+    std::vector<double> values;
+    if (spec.empty()) return values;
+    if (spec.find(':') != std::string::npos) {
+        std::istringstream iss(spec);
+        std::string a, b, c;
+        std::getline(iss, a, ':');
+        std::getline(iss, b, ':');
+        std::getline(iss, c, ':');
+        const double start = std::stod(a);
+        const double stop = std::stod(b);
+        const double step = c.empty() ? 1.0 : std::stod(c);
+        if (step <= 0.0) throw std::invalid_argument("Sweep step must be positive: " + spec);
+        // Integer stepping avoids accumulating floating-point drift
+        const long count = static_cast<long>(std::floor((stop - start) / step + 1e-9)) + 1;
+        for (long i = 0; i < count; ++i) values.push_back(start + static_cast<double>(i) * step);
+        return values;
+    }
+    std::istringstream iss(spec);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        if (token.find_first_not_of(" \t") == std::string::npos) continue;
+        values.push_back(std::stod(token));
+    }
+    return values;
+}
+
+std::vector<TopologyExtractor::Params> makeSweepGrid(const std::vector<double>& prune_min_lengths,
+                                                     const std::vector<double>& merge_radii,
+                                                     const TopologyExtractor::Params& base) {
+    const std::vector<double> prunes = prune_min_lengths.empty() ? std::vector<double>{base.prune_min_length} : prune_min_lengths;
+    const std::vector<double> merges = merge_radii.empty() ? std::vector<double>{base.merge_radius} : merge_radii;
+    std::vector<TopologyExtractor::Params> grid;
+    grid.reserve(prunes.size() * merges.size());
+    for (double p : prunes) {
+        for (double m : merges) {
+            TopologyExtractor::Params params = base;
+            params.prune_min_length = p;
+            params.merge_radius = m;
+            grid.push_back(params);
+        }
+    }
+    return grid;
+}
+
+std::vector<SweepResult> runParameterSweep(const GvdResult& gvd,
+                                           const std::vector<TopologyExtractor::Params>& params,
+                                           double resolution,
+                                           const SweepOptions& options) {
+    std::vector<SweepResult> results(params.size());
+    const int threads = options.parallel ? options.max_threads : 1;
+    // One combination per task; each extraction's own loops share the same pool
+    ThreadPool::shared().parallelFor(0, static_cast<int>(params.size()), threads, [&](int i0, int i1) {
+        for (int i = i0; i < i1; ++i) {
+            SweepResult& r = results[i];
+            r.params = params[i];
+            Timer timer;
+            TopologyExtractor extractor(params[i]);
+            TopologicalMap map = extractor.run(gvd, resolution);
+            r.elapsed_ms = timer.ms();
+            r.node_count = map.nodes.size();
+            r.edge_count = map.edges.size();
+            if (options.keep_maps) r.map = std::move(map);
+        }
+    });
+    return results;
+}
+
+void printSweepSummary(std::ostream& os, const std::vector<SweepResult>& results) {
+    os << std::left << std::setw(10) << "prune" << std::setw(10) << "merge"
+       << std::setw(8) << "nodes" << std::setw(8) << "edges" << "ms" << "\n";
+    for (const auto& r : results) {
+        std::ostringstream ms;
+        ms << std::fixed << std::setprecision(3) << r.elapsed_ms;
+        os << std::left << std::setw(10) << r.params.prune_min_length << std::setw(10) << r.params.merge_radius
+           << std::setw(8) << r.node_count << std::setw(8) << r.edge_count << ms.str() << "\n";
+    }
+}
+
+} // namespace gvd_topo
@@ -0,0 +1,510 @@
+#include "gvd_topo/core/RollingGvd.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/SkeletonTrace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace gvd_topo {
+
+namespace {
+
+constexpr float kEps = 1e-6f;
+using skeleton::kDx8;
+using skeleton::kDy8;
+
+inline int wrap(int v, int n) {
+    const int m = v % n;
+    return m < 0 ? m + n : m;
+}
+
+template <typename Fn>
+void forCells(int x0, int y0, int x1, int y1, Fn&& fn) {
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) fn(x, y);
+    }
+}
+
+} // namespace
+
+RollingGvd::RollingGvd(const OccupancyGrid& map, const Params& params)
+    : map_(map), params_(params), w_(params.window_width), h_(params.window_height) {
+    if (w_ < 3 || h_ < 3) throw std::runtime_error("RollingGvd: window must be at least 3x3 cells");
+    if (!(params_.max_distance > 0.0)) throw std::runtime_error("RollingGvd: max_distance must be positive");
+    GvdGenerator::Params edt_params;
+    edt_params.parallel = params_.parallel;
+    edt_params.max_threads = params_.max_threads;
+    edt_.setParams(edt_params);
+    cap_ = static_cast<float>(params_.max_distance);
+    margin_ = static_cast<int>(std::ceil(params_.max_distance / map_.resolution)) + 1;
+    merge_cells_ = static_cast<int>(std::ceil(params_.merge_radius / map_.resolution));
+    const size_t cells = static_cast<size_t>(w_) * static_cast<size_t>(h_);
+    dist_.assign(cells, 0.0f);
+    mask_.assign(cells, 0);
+    raw_.assign(cells, 0);
+    cluster_.assign(cells, -1);
+    label_.assign(cells, -1);
+    edge_of_.assign(cells, -1);
+    flood_.assign(cells, 0);
+}
+
+size_t RollingGvd::slot(int x, int y) const {
+    return static_cast<size_t>(wrap(y, h_)) * static_cast<size_t>(w_) + static_cast<size_t>(wrap(x, w_));
+}
+
+bool RollingGvd::inWindow(int x, int y) const {
+    return x >= origin_x_ && y >= origin_y_ && x < origin_x_ + w_ && y < origin_y_ + h_;
+}
+
+RollingGvd::Rect RollingGvd::clip(Rect r) const {
+    const Rect win = window();
+    return {std::max(r.x0, win.x0), std::max(r.y0, win.y0), std::min(r.x1, win.x1), std::min(r.y1, win.y1)};
+}
+
+const RollingGvd::UpdateStats& RollingGvd::moveTo(double x, double y) {
+    return moveToCell(static_cast<int>(std::floor((x - map_.origin.x) / map_.resolution)),
+                      static_cast<int>(std::floor((y - map_.origin.y) / map_.resolution)));
+}
+
+const RollingGvd::UpdateStats& RollingGvd::moveToCell(int cx, int cy) {
+    const int nx = cx - w_ / 2;
+    const int ny = cy - h_ / 2;
+    const bool full = !initialised_ || std::abs(nx - origin_x_) >= w_ || std::abs(ny - origin_y_) >= h_;
+    if (!full && nx == origin_x_ && ny == origin_y_) {
+        stats_ = UpdateStats{};
+        stats_.edges_kept = edges_.size();
+        return stats_;
+    }
+    stats_ = UpdateStats{};
+    stats_.full = full;
+
+    const Rect old = window();
+    origin_x_ = nx;
+    origin_y_ = ny;
+    initialised_ = true;
+    const Rect win = window();
+
+    // New window minus old one: a column strip, then a row strip over the
+    // remaining columns
+    std::vector<Rect> exposed;
+    if (full) {
+        exposed.push_back(win);
+    } else {
+        if (win.x0 > old.x0) exposed.push_back({old.x1, win.y0, win.x1, win.y1});
+        if (win.x0 < old.x0) exposed.push_back({win.x0, win.y0, old.x0, win.y1});
+        const int kept_x0 = std::max(win.x0, old.x0);
+        const int kept_x1 = std::min(win.x1, old.x1);
+        if (win.y0 > old.y0) exposed.push_back({kept_x0, old.y1, kept_x1, win.y1});
+        if (win.y0 < old.y0) exposed.push_back({kept_x0, win.y0, kept_x1, old.y0});
+    }
+
+    std::vector<int> doomed_nodes;
+    std::vector<int> doomed_edges;
+    if (full) {
+        std::fill(mask_.begin(), mask_.end(), 0);
+        std::fill(raw_.begin(), raw_.end(), 0);
+        std::fill(cluster_.begin(), cluster_.end(), -1);
+        std::fill(label_.begin(), label_.end(), -1);
+        std::fill(edge_of_.begin(), edge_of_.end(), -1);
+        nodes_.clear();
+        edges_.clear();
+    } else {
+        // Exposed slots still hold the cells that scrolled out: whatever
+        // lived there goes, then the slots start empty
+        for (const Rect& r : exposed) {
+            forCells(r.x0, r.y0, r.x1, r.y1, [&](int x, int y) {
+                const size_t s = slot(x, y);
+                if (cluster_[s] >= 0) doomed_nodes.push_back(cluster_[s]);
+                if (label_[s] >= 0) doomed_nodes.push_back(label_[s]);
+                if (edge_of_[s] >= 0) doomed_edges.push_back(edge_of_[s]);
+                mask_[s] = 0;
+                raw_[s] = 0;
+                cluster_[s] = label_[s] = edge_of_[s] = -1;
+            });
+        }
+    }
+
+    for (const Rect& r : exposed) {
+        computeDistances(r);
+        stats_.cells_computed += static_cast<size_t>(r.x1 - r.x0) * static_cast<size_t>(r.y1 - r.y0);
+    }
+
+    // Ridges read a 3x3 neighbourhood and never sit on the window border;
+    // node status reads the ridges around it
+    std::vector<Rect> ridge_dirty;
+    for (const Rect& r : exposed) ridge_dirty.push_back(clip({r.x0 - 1, r.y0 - 1, r.x1 + 1, r.y1 + 1}));
+    if (!full) {
+        ridge_dirty.push_back({win.x0, win.y0, win.x1, win.y0 + 1});
+        ridge_dirty.push_back({win.x0, win.y1 - 1, win.x1, win.y1});
+        ridge_dirty.push_back({win.x0, win.y0, win.x0 + 1, win.y1});
+        ridge_dirty.push_back({win.x1 - 1, win.y0, win.x1, win.y1});
+    }
+    std::vector<Rect> node_dirty;
+    for (const Rect& r : ridge_dirty) {
+        forCells(r.x0, r.y0, r.x1, r.y1, [&](int x, int y) { mask_[slot(x, y)] = isRidge(x, y) ? 255 : 0; });
+        node_dirty.push_back(clip({r.x0 - 1, r.y0 - 1, r.x1 + 1, r.y1 + 1}));
+    }
+    auto skel = [this](int x, int y) { return onSkeleton(x, y); };
+    for (const Rect& r : node_dirty) {
+        forCells(r.x0, r.y0, r.x1, r.y1, [&](int x, int y) { raw_[slot(x, y)] = skeleton::isRawNode(skel, x, y) ? 1 : 0; });
+        stats_.cells_refreshed += static_cast<size_t>(r.x1 - r.x0) * static_cast<size_t>(r.y1 - r.y0);
+    }
+
+    // Clusters within merge range of a changed cell re-form; edges through a
+    // changed cell are retraced. Nodes near the change seed the new traces.
+    std::vector<int> seeds;
+    for (const Rect& r : node_dirty) {
+        const Rect near = clip({r.x0 - merge_cells_, r.y0 - merge_cells_, r.x1 + merge_cells_, r.y1 + merge_cells_});
+        forCells(near.x0, near.y0, near.x1, near.y1, [&](int x, int y) {
+            const int32_t c = cluster_[slot(x, y)];
+            if (c >= 0) doomed_nodes.push_back(c);
+        });
+        forCells(r.x0, r.y0, r.x1, r.y1, [&](int x, int y) {
+            const int32_t e = edge_of_[slot(x, y)];
+            if (e >= 0) doomed_edges.push_back(e);
+        });
+        // Traces start up to 3 cells away from a node's position
+        const Rect seed_area = clip({r.x0 - 4, r.y0 - 4, r.x1 + 4, r.y1 + 4});
+        forCells(seed_area.x0, seed_area.y0, seed_area.x1, seed_area.y1, [&](int x, int y) {
+            const int32_t n = label_[slot(x, y)];
+            if (n >= 0) seeds.push_back(n);
+        });
+    }
+
+    // Dropping cascades: a node takes its edges along, an edge its traced
+    // dead end. Surviving raw members of dropped clusters are re-merged.
+    std::vector<std::pair<int,int>> orphans;
+    auto cascade = [&]() {
+        while (!doomed_nodes.empty() || !doomed_edges.empty()) {
+            if (!doomed_edges.empty()) {
+                const int e = doomed_edges.back();
+                doomed_edges.pop_back();
+                if (edges_.count(e)) dropEdge(e, doomed_nodes, seeds);
+            } else {
+                const int n = doomed_nodes.back();
+                doomed_nodes.pop_back();
+                if (nodes_.count(n)) dropNode(n, doomed_edges, orphans);
+            }
+        }
+    };
+    cascade();
+
+    // Raw cells without a cluster: the changed area plus the orphans, marked
+    // -2 while pending so each is taken once
+    std::vector<std::pair<int,int>> pending;
+    auto take = [&](int x, int y) {
+        const size_t s = slot(x, y);
+        if (raw_[s] && cluster_[s] == -1) {
+            cluster_[s] = -2;
+            pending.emplace_back(x, y);
+        }
+    };
+    for (const auto& o : orphans) {
+        if (inWindow(o.first, o.second)) take(o.first, o.second);
+    }
+    for (const Rect& r : node_dirty) forCells(r.x0, r.y0, r.x1, r.y1, take);
+
+    // Same merge rule as TopologyExtractor: union of raw nodes within merge_radius
+    for (const auto& g : skeleton::mergeCells(pending, params_.merge_radius / map_.resolution)) {
+        const int id = next_node_++;
+        Node node;
+        node.x = g.x;
+        node.y = g.y;
+        for (int i : g.members) {
+            node.members.push_back(pending[i]);
+            cluster_[slot(pending[i].first, pending[i].second)] = id;
+        }
+        // A node landing on a kept edge or traced dead end splits it
+        const size_t s = slot(node.x, node.y);
+        if (edge_of_[s] >= 0) doomed_edges.push_back(edge_of_[s]);
+        if (label_[s] >= 0) doomed_nodes.push_back(label_[s]);
+        nodes_.emplace(id, std::move(node));
+        cascade();
+        label_[s] = id;
+        seeds.push_back(id);
+    }
+
+    // A walk may not enter a cell an earlier walk visited, so which edges
+    // come out depends on the tracing order. Every skeleton component reached
+    // by a seed or a changed cell is therefore retraced whole, in the same
+    // row-major seed order as a fresh build; the other components' edges
+    // are kept. Walks never leave their component, so the two agree.
+    std::vector<std::pair<int,int>> reached;
+    auto flood = [&](int x, int y) {
+        if (!inWindow(x, y) || !mask_[slot(x, y)] || flood_[slot(x, y)]) return;
+        flood_[slot(x, y)] = 1;
+        size_t head = reached.size();
+        reached.emplace_back(x, y);
+        for (; head < reached.size(); ++head) {
+            const auto c = reached[head];
+            for (int k = 0; k < 8; ++k) {
+                const int nx = c.first + kDx8[k];
+                const int ny = c.second + kDy8[k];
+                if (!inWindow(nx, ny) || !mask_[slot(nx, ny)] || flood_[slot(nx, ny)]) continue;
+                flood_[slot(nx, ny)] = 1;
+                reached.emplace_back(nx, ny);
+            }
+        }
+    };
+    for (int id : seeds) {
+        auto it = nodes_.find(id);
+        if (it == nodes_.end()) continue;
+        const auto start = startCell(it->second);
+        flood(start.first, start.second);
+    }
+    for (const Rect& r : node_dirty) forCells(r.x0, r.y0, r.x1, r.y1, flood);
+    for (const auto& c : reached) {
+        const int32_t e = edge_of_[slot(c.first, c.second)];
+        if (e >= 0) doomed_edges.push_back(e);
+    }
+    cascade();
+
+    seeds.clear();
+    for (const auto& n : nodes_) {
+        // Dead ends are only ever reached, as in TopologyExtractor, which
+        // never traces the nodes it appends; any left here are outside the
+        // retraced components
+        if (n.second.traced) continue;
+        const auto start = startCell(n.second);
+        if (inWindow(start.first, start.second) && flood_[slot(start.first, start.second)]) seeds.push_back(n.first);
+    }
+    for (const auto& c : reached) flood_[slot(c.first, c.second)] = 0;
+    std::sort(seeds.begin(), seeds.end(), [this](int a, int b) {
+        const Node& na = nodes_.at(a);
+        const Node& nb = nodes_.at(b);
+        if (na.y != nb.y) return na.y < nb.y;
+        if (na.x != nb.x) return na.x < nb.x;
+        return a < b;
+    });
+
+    stats_.edges_kept = edges_.size();
+    for (int id : seeds) trace(id);
+    stats_.edges_traced = edges_.size() - stats_.edges_kept;
+    return stats_;
+}
+
+void RollingGvd::computeDistances(const Rect& r) {
+    // Obstacles further than the cap cannot matter, so the EDT only needs the
+    // map within margin_ of the strip; off-map cells are free
+    OccupancyGrid crop(r.x1 - r.x0 + 2 * margin_, r.y1 - r.y0 + 2 * margin_, map_.resolution);
+    const int cx0 = r.x0 - margin_;
+    const int cy0 = r.y0 - margin_;
+    for (int y = 0; y < crop.height; ++y) {
+        const int my = cy0 + y;
+        if (my < 0 || my >= map_.height) continue;
+        const int mx0 = std::max(cx0, 0);
+        const int mx1 = std::min(cx0 + crop.width, map_.width);
+        if (mx0 >= mx1) continue;
+        std::memcpy(&crop.data[crop.index(mx0 - cx0, y)], &map_.data[map_.index(mx0, my)],
+                    static_cast<size_t>(mx1 - mx0));
+    }
+    const std::vector<float> d = edt_.distanceField(crop);
+    forCells(r.x0, r.y0, r.x1, r.y1, [&](int x, int y) {
+        dist_[slot(x, y)] = std::min(d[crop.index(x - cx0, y - cy0)], cap_);
+    });
+}
+
+bool RollingGvd::isRidge(int x, int y) const {
+    if (x <= origin_x_ || y <= origin_y_ || x >= origin_x_ + w_ - 1 || y >= origin_y_ + h_ - 1) return false;
+    const float c = dist_[slot(x, y)];
+    // Saturated cells are a plateau, not a ridge
+    if (c <= kEps || c >= cap_ - kEps) return false;
+    for (int k = 0; k < 8; ++k) {
+        if (dist_[slot(x + kDx8[k], y + kDy8[k])] > c + kEps) return false;
+    }
+    return true;
+}
+
+void RollingGvd::dropEdge(int id, std::vector<int>& doomed_nodes, std::vector<int>& reseed) {
+    auto it = edges_.find(id);
+    for (const auto& c : it->second.cells) {
+        if (!inWindow(c.first, c.second)) continue; // slot already reused
+        int32_t& e = edge_of_[slot(c.first, c.second)];
+        if (e == id) e = -1;
+    }
+    for (int end : {it->second.u, it->second.v}) {
+        auto n = nodes_.find(end);
+        if (n == nodes_.end()) continue;
+        auto& incident = n->second.edges;
+        incident.erase(std::remove(incident.begin(), incident.end(), id), incident.end());
+        if (n->second.traced && incident.empty()) {
+            doomed_nodes.push_back(end);
+        } else {
+            reseed.push_back(end);
+        }
+    }
+    edges_.erase(it);
+}
+
+void RollingGvd::dropNode(int id, std::vector<int>& doomed_edges, std::vector<std::pair<int,int>>& orphans) {
+    auto it = nodes_.find(id);
+    Node& node = it->second;
+    if (inWindow(node.x, node.y)) {
+        int32_t& l = label_[slot(node.x, node.y)];
+        if (l == id) l = -1;
+    }
+    for (const auto& m : node.members) {
+        if (!inWindow(m.first, m.second)) continue;
+        int32_t& c = cluster_[slot(m.first, m.second)];
+        if (c == id) {
+            c = -1;
+            orphans.push_back(m);
+        }
+    }
+    doomed_edges.insert(doomed_edges.end(), node.edges.begin(), node.edges.end());
+    nodes_.erase(it);
+}
+
+std::pair<int,int> RollingGvd::startCell(const Node& node) const {
+    return skeleton::startCell([this](int x, int y) { return onSkeleton(x, y); }, node.x, node.y);
+}
+
+// Same walk as TopologyExtractor: from the node into each unvisited skeleton
+// neighbour, until another node or a dead end
+void RollingGvd::trace(int node_id) {
+    auto skel = [this](int x, int y) { return onSkeleton(x, y); };
+    auto visited = [this](int x, int y) { return edge_of_[slot(x, y)] >= 0; };
+    const auto start = startCell(nodes_.at(node_id));
+    const int sx = start.first;
+    const int sy = start.second;
+
+    for (int k = 0; k < 8; ++k) {
+        const int nx = sx + kDx8[k];
+        const int ny = sy + kDy8[k];
+        if (!skel(nx, ny) || visited(nx, ny)) continue;
+
+        const int id = next_edge_++;
+        Edge edge;
+        edge.u = node_id;
+        edge.v = node_id;
+        edge.dir = k;
+        edge.ghost = true;
+        edge.min_clearance = std::numeric_limits<float>::max();
+        auto visit = [&](int cx, int cy) {
+            const size_t s = slot(cx, cy);
+            edge_of_[s] = id;
+            edge.cells.emplace_back(cx, cy);
+            edge.min_clearance = std::min(edge.min_clearance, dist_[s]);
+            edge.clearance_sum += dist_[s];
+        };
+        auto isNode = [this](int x, int y) { return label_[slot(x, y)] >= 0; };
+        const skeleton::Walk w = skeleton::walk(skel, visited, isNode, visit, sx, sy, nx, ny, map_.resolution,
+                                                static_cast<long>(w_) * h_);
+        edge.length = w.length;
+        if (w.end == skeleton::WalkEnd::Node) {
+            edge.v = label_[slot(w.x, w.y)];
+            edge.ghost = false;
+        } else if (w.end == skeleton::WalkEnd::DeadEnd) {
+            // Dead end (including the window border): it becomes a node
+            const int end = next_node_++;
+            Node dead;
+            dead.x = w.x;
+            dead.y = w.y;
+            dead.traced = true;
+            nodes_.emplace(end, std::move(dead));
+            label_[slot(w.x, w.y)] = end;
+            edge.v = end;
+            edge.ghost = false;
+        }
+        nodes_.at(edge.u).edges.push_back(id);
+        if (edge.v != edge.u) nodes_.at(edge.v).edges.push_back(id);
+        edges_.emplace(id, std::move(edge));
+    }
+}
+
+GvdResult RollingGvd::gvd() const {
+    GvdResult result;
+    result.width = w_;
+    result.height = h_;
+    result.offset_x = origin_x_;
+    result.offset_y = origin_y_;
+    result.distance.resize(dist_.size());
+    result.gvd_mask.resize(mask_.size());
+    for (int y = 0; y < h_; ++y) {
+        for (int x = 0; x < w_; ++x) {
+            const size_t s = slot(origin_x_ + x, origin_y_ + y);
+            result.distance[static_cast<size_t>(y) * w_ + x] = dist_[s];
+            result.gvd_mask[static_cast<size_t>(y) * w_ + x] = mask_[s];
+        }
+    }
+    return result;
+}
+
+TopologicalMap RollingGvd::topology() const {
+    const double res = map_.resolution;
+    TopologicalMap topo;
+    topo.has_clearance = true;
+
+    // Output in TopologyExtractor's order, so the result equals
+    // TopologyExtractor::run on gvd(): untraced nodes row-major (the tracing
+    // order), then the dead ends in the order their edges were traced; edges
+    // by tracing node, then by the direction they leave it. Edge ids count
+    // pruned edges, as the extractor's do.
+    std::vector<int> seed_ids;
+    for (const auto& n : nodes_) {
+        if (!n.second.traced) seed_ids.push_back(n.first);
+    }
+    std::sort(seed_ids.begin(), seed_ids.end(), [this](int a, int b) {
+        const Node& na = nodes_.at(a);
+        const Node& nb = nodes_.at(b);
+        if (na.y != nb.y) return na.y < nb.y;
+        if (na.x != nb.x) return na.x < nb.x;
+        return a < b;
+    });
+    std::unordered_map<int, int> rank;
+    for (size_t i = 0; i < seed_ids.size(); ++i) rank[seed_ids[i]] = static_cast<int>(i);
+
+    std::vector<int> edge_ids;
+    std::unordered_map<int, int> degree;
+    for (const auto& e : edges_) {
+        if (e.second.ghost) continue;
+        edge_ids.push_back(e.first);
+        ++degree[e.second.u];
+        if (e.second.v != e.second.u) ++degree[e.second.v];
+    }
+    std::sort(edge_ids.begin(), edge_ids.end(), [&](int a, int b) {
+        const Edge& ea = edges_.at(a);
+        const Edge& eb = edges_.at(b);
+        const int ra = rank.at(ea.u);
+        const int rb = rank.at(eb.u);
+        return ra != rb ? ra < rb : ea.dir < eb.dir;
+    });
+
+    std::unordered_map<int, int> index;
+    auto emit = [&](int id) {
+        const Node& n = nodes_.at(id);
+        TopoNode out;
+        out.id = static_cast<int>(topo.nodes.size());
+        out.x = n.x * res;
+        out.y = n.y * res;
+        index[id] = out.id;
+        topo.nodes.push_back(out);
+    };
+    for (int id : seed_ids) emit(id);
+    // A traced dead end is created by the first edge reaching it
+    for (int id : edge_ids) {
+        const int v = edges_.at(id).v;
+        if (!index.count(v)) emit(v);
+    }
+
+    for (size_t i = 0; i < edge_ids.size(); ++i) {
+        const Edge& e = edges_.at(edge_ids[i]);
+        // Same pruning rule as TopologyExtractor: short edges between two dead ends
+        if (skeleton::prunable(e.length, params_.prune_min_length, degree[e.u], degree[e.v])) continue;
+        TopoEdge out;
+        out.id = static_cast<int>(i);
+        out.u = index.at(e.u);
+        out.v = index.at(e.v);
+        out.length = e.length;
+        out.polyline.reserve(e.cells.size());
+        for (const auto& c : e.cells) out.polyline.emplace_back(c.first * res, c.second * res);
+        out.min_clearance = e.min_clearance;
+        out.mean_clearance = e.cells.empty() ? 0.0 : e.clearance_sum / static_cast<double>(e.cells.size());
+        topo.edges.push_back(std::move(out));
+    }
+    return topo;
+}
+
+} // namespace gvd_topo
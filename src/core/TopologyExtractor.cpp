@@ -1,9 +1,16 @@
 #include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/PackedGrid.hpp"
+#include "gvd_topo/core/SkeletonTrace.hpp"
+#include "gvd_topo/io/JsonWriter.hpp"
+#include "gvd_topo/utils/Cancellation.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <queue>
 #include <cmath>
 #include <limits>
-#include <sstream>
+#include <unordered_map>
 
 namespace gvd_topo {
 
@@ -12,241 +19,276 @@ TopologyExtractor::TopologyExtractor(const Params& p) : params_(p) {}
 
 static inline int idx(int x, int y, int w) { return y * w + x; }
 
+namespace {
+
+struct ByteSkeleton {
+    const uint8_t* cells;
+    int width;
+    bool operator()(int x, int y) const { return cells[idx(x, y, width)] != 0; }
+};
+
+struct BitSkeleton {
+    const PackedMask& mask;
+    bool operator()(int x, int y) const { return mask.test(x, y); }
+};
+
+} // namespace
+
 TopologicalMap TopologyExtractor::run(const std::vector<uint8_t>& gvd_mask, int width, int height, double resolution) const {
+    if (gvd_mask.empty()) return TopologicalMap{};
+    return extract(ByteSkeleton{gvd_mask.data(), width}, nullptr, width, height, resolution);
+}
+
+TopologicalMap TopologyExtractor::run(const std::vector<uint8_t>& gvd_mask, const std::vector<float>& distance,
+                                      int width, int height, double resolution) const {
+    if (gvd_mask.empty()) return TopologicalMap{};
+    const bool usable = distance.size() == gvd_mask.size();
+    return extract(ByteSkeleton{gvd_mask.data(), width}, usable ? distance.data() : nullptr, width, height, resolution);
+}
+
+TopologicalMap TopologyExtractor::run(const GvdResult& gvd, double resolution) const {
+    return run(gvd, gvd.gvd_mask, resolution);
+}
+
+TopologicalMap TopologyExtractor::run(const GvdResult& gvd, const std::vector<uint8_t>& gvd_mask,
+                                      double resolution) const {
+    if (gvd_mask.empty() || gvd_mask.size() != gvd.gvd_mask.size()) return TopologicalMap{};
+    const bool usable = gvd.distance.size() == gvd_mask.size();
+    TopologicalMap topo = extract(ByteSkeleton{gvd_mask.data(), gvd.width}, usable ? gvd.distance.data() : nullptr,
+                                  gvd.width, gvd.height, resolution * gvd.scale, gvd.offset_x, gvd.offset_y);
+    topo.complete = topo.complete && gvd.complete;
+    return topo;
+}
+
+TopologicalMap TopologyExtractor::run(const GvdResult& gvd, double resolution, const Roi& roi) const {
+    // roi in result cells (a coarse GVD covers scale x scale map cells each),
+    // clipped to the part of the map gvd covers
+    const int s = std::max(1, gvd.scale);
+    auto down = [s](int v) { return v >= 0 ? v / s : -((-v + s - 1) / s); };
+    const Roi box = Roi{down(roi.x0) - gvd.offset_x, down(roi.y0) - gvd.offset_y,
+                        down(roi.x1 + s - 1) - gvd.offset_x, down(roi.y1 + s - 1) - gvd.offset_y}
+                        .clippedTo(gvd.width, gvd.height);
+    if (box.empty() || gvd.gvd_mask.empty()) return TopologicalMap{};
+    GvdResult part;
+    part.width = box.width();
+    part.height = box.height();
+    part.scale = gvd.scale;
+    part.complete = gvd.complete;
+    part.offset_x = gvd.offset_x + box.x0;
+    part.offset_y = gvd.offset_y + box.y0;
+    const bool usable = gvd.distance.size() == gvd.gvd_mask.size();
+    part.gvd_mask.resize(static_cast<size_t>(part.width) * static_cast<size_t>(part.height));
+    if (usable) part.distance.resize(part.gvd_mask.size());
+    for (int y = 0; y < part.height; ++y) {
+        const size_t src = static_cast<size_t>(box.y0 + y) * gvd.width + box.x0;
+        const size_t dst = static_cast<size_t>(y) * part.width;
+        std::copy_n(&gvd.gvd_mask[src], part.width, &part.gvd_mask[dst]);
+        if (usable) std::copy_n(&gvd.distance[src], part.width, &part.distance[dst]);
+    }
+    return run(part, resolution);
+}
+
+TopologicalMap TopologyExtractor::run(const GvdResult& gvd, double resolution, const RunControl& control) const {
+    if (gvd.gvd_mask.empty()) return TopologicalMap{};
+    const bool usable = gvd.distance.size() == gvd.gvd_mask.size();
+    // A coarse GVD is already the fallback of an expired deadline, and cheap
+    // to trace: finish it rather than returning next to nothing
+    RunControl unbounded;
+    unbounded.progress = control.progress;
+    const RunControl& effective = gvd.scale > 1 ? unbounded : control;
+    TopologicalMap topo = extract(ByteSkeleton{gvd.gvd_mask.data(), gvd.width}, usable ? gvd.distance.data() : nullptr,
+                                  gvd.width, gvd.height, resolution * gvd.scale, gvd.offset_x, gvd.offset_y,
+                                  &effective);
+    topo.complete = topo.complete && gvd.complete;
+    return topo;
+}
+
+TopologicalMap TopologyExtractor::run(const PackedMask& gvd_mask, const float* distance, double resolution) const {
+    if (gvd_mask.words.empty()) return TopologicalMap{};
+    return extract(BitSkeleton{gvd_mask}, distance, gvd_mask.width, gvd_mask.height, resolution);
+}
+
+TopologicalMap TopologyExtractor::run(const PackedGvdResult& gvd, double resolution) const {
+    const size_t cells = static_cast<size_t>(gvd.width) * static_cast<size_t>(gvd.height);
+    return run(gvd.gvd_mask, gvd.distance.size() == cells ? gvd.distance.data() : nullptr, resolution);
+}
+
+TopologicalMap TopologyExtractor::run(const PackedGvdResult& gvd, double resolution, const RunControl& control) const {
+    if (gvd.gvd_mask.words.empty()) return TopologicalMap{};
+    const size_t cells = static_cast<size_t>(gvd.width) * static_cast<size_t>(gvd.height);
+    return extract(BitSkeleton{gvd.gvd_mask}, gvd.distance.size() == cells ? gvd.distance.data() : nullptr,
+                   gvd.width, gvd.height, resolution, 0, 0, &control);
+}
+
+template <typename Skeleton>
+TopologicalMap TopologyExtractor::extract(const Skeleton& skel, const float* distance,
+                                          int width, int height, double resolution,
+                                          int offset_x, int offset_y,
+                                          const RunControl* control) const {
     TopologicalMap topo;
-    if (gvd_mask.empty() || width <= 0 || height <= 0) return topo;
+    if (width <= 0 || height <= 0) return topo;
+    topo.has_clearance = (distance != nullptr);
+
+    // Progress weights: scans 0.2, node merge 0.1, tracing 0.6, pruning 0.1
+    ProgressMeter meter(control, 1.0);
+    std::atomic<bool> stopped {false};
+    auto stopRequested = [&]() {
+        if (stopped.load(std::memory_order_relaxed)) return true;
+        if (control && control->stopRequested()) {
+            stopped.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    };
+    // Anytime: whatever has been traced so far, flagged incomplete
+    auto partial = [&]() {
+        if (!control->anytime) throw Cancelled("topology extraction stopped before completion");
+        topo.complete = false;
+        return topo;
+    };
 
     auto inBounds = [&](int x, int y) { return x >= 0 && y >= 0 && x < width && y < height; };
+    auto onSkeleton = [&](int x, int y) { return inBounds(x, y) && skel(x, y); };
 
-    // Compute degrees for each skeleton pixel (8-neighborhood)
-    std::vector<uint8_t> is_skel = gvd_mask;
-    std::vector<uint8_t> degree(static_cast<size_t>(width * height), 0);
-    const int dx8[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
-    const int dy8[8] = { -1,-1,-1,  0, 0,  1, 1, 1 };
-    #ifdef GVD_TOPO_WITH_OPENMP
-    #pragma omp parallel for schedule(static)
-    #endif
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            if (!is_skel[idx(x,y,width)]) continue;
-            int deg = 0;
-            for (int k = 0; k < 8; ++k) {
-                int nx = x + dx8[k];
-                int ny = y + dy8[k];
-                if (inBounds(nx,ny) && is_skel[idx(nx,ny,width)]) ++deg;
-            }
-            degree[idx(x,y,width)] = static_cast<uint8_t>(deg);
-        }
-    }
+    ThreadPool& pool = ThreadPool::shared();
+    const int threads = params_.parallel ? params_.max_threads : 1;
 
-    // Identify raw nodes (endpoints degree==1, junctions degree>=3)
-    struct NodePix { int x; int y; };
-    std::vector<NodePix> raw_nodes;
-    raw_nodes.reserve(1024);
+    // Identify raw nodes (endpoints degree==1, junctions degree>=3). Skeleton
+    // degrees are counted where needed rather than stored: a per-cell degree
+    // array would outweigh a packed skeleton 8:1. Each block of rows collects
+    // into its own list; concatenating them in block order keeps raw_nodes
+    // row-major whatever the thread count.
+    std::vector<std::pair<int,int>> raw_nodes;
     {
-        std::vector<NodePix> local_nodes;
-        local_nodes.reserve(1024);
-        #ifdef GVD_TOPO_WITH_OPENMP
-        #pragma omp parallel private(local_nodes)
-        {
-            local_nodes.clear();
-            #pragma omp for nowait schedule(static)
-            for (int y = 1; y < height-1; ++y) {
-                for (int x = 1; x < width-1; ++x) {
-                    if (!is_skel[idx(x,y,width)]) continue;
-                    int d = degree[idx(x,y,width)];
-                    if (d == 1 || d >= 3) local_nodes.push_back({x,y});
+        constexpr int kBlockRows = 32;
+        const int blocks = std::max(0, (height - 2 + kBlockRows - 1) / kBlockRows);
+        std::vector<std::vector<std::pair<int,int>>> block_nodes(static_cast<size_t>(blocks));
+        pool.parallelFor(0, blocks, threads, [&](int b0, int b1) {
+            for (int b = b0; b < b1; ++b) {
+                if (stopRequested()) return;
+                const int y_end = std::min(height - 1, 1 + (b + 1) * kBlockRows);
+                for (int y = 1 + b * kBlockRows; y < y_end; ++y) {
+                    for (int x = 1; x < width-1; ++x) {
+                        if (skeleton::isRawNode(onSkeleton, x, y)) block_nodes[b].emplace_back(x, y);
+                    }
                 }
+                meter.add(0.2 / blocks);
             }
-            #pragma omp critical
-            raw_nodes.insert(raw_nodes.end(), local_nodes.begin(), local_nodes.end());
-        }
-        #else
-        for (int y = 1; y < height-1; ++y) {
-            for (int x = 1; x < width-1; ++x) {
-                if (!is_skel[idx(x,y,width)]) continue;
-                int d = degree[idx(x,y,width)];
-                if (d == 1 || d >= 3) raw_nodes.push_back({x,y});
-            }
-        }
-        #endif
+        });
+        if (stopped) return partial();
+        size_t total = 0;
+        for (const auto& nodes : block_nodes) total += nodes.size();
+        raw_nodes.reserve(total);
+        for (const auto& nodes : block_nodes) raw_nodes.insert(raw_nodes.end(), nodes.begin(), nodes.end());
     }
 
-    // Merge nearby nodes within merge_radius (pixels)
-    const double merge_radius_px = params_.merge_radius / resolution;
-    const double merge_radius_px2 = merge_radius_px * merge_radius_px;
-    std::vector<int> parent(raw_nodes.size());
-    for (size_t i = 0; i < parent.size(); ++i) parent[i] = static_cast<int>(i);
-    auto findp = [&](int a){ while (parent[a] != a) a = parent[a] = parent[parent[a]]; return a; };
-    auto un = [&](int a, int b){ a = findp(a); b = findp(b); if (a!=b) parent[b]=a; };
-    for (size_t i = 0; i < raw_nodes.size(); ++i) {
-        for (size_t j = i+1; j < raw_nodes.size(); ++j) {
-            double dx = static_cast<double>(raw_nodes[i].x - raw_nodes[j].x);
-            double dy = static_cast<double>(raw_nodes[i].y - raw_nodes[j].y);
-            if (dx*dx + dy*dy <= merge_radius_px2) un(static_cast<int>(i), static_cast<int>(j));
-        }
-    }
-    // Compute representatives and average positions
-    std::vector<std::vector<int>> groups(raw_nodes.size());
-    for (size_t i = 0; i < raw_nodes.size(); ++i) groups[findp(static_cast<int>(i))].push_back(static_cast<int>(i));
-    std::vector<int> label(width*height, -1);
+    // Merge nearby nodes within merge_radius (pixels); the groups come out
+    // row-major, which is the tracing order
+    const std::vector<skeleton::NodeGroup> groups =
+        skeleton::mergeCells(raw_nodes, params_.merge_radius / resolution, stopRequested);
+    if (stopped && !control->anytime) return partial(); // throws Cancelled
+    meter.add(0.1);
+    // Nodes are few: a bit per cell marks them, their ids live in a map
+    PackedMask node_cells(width, height);
+    std::unordered_map<int, int> label;
+    auto markNode = [&](int x, int y, int id) {
+        node_cells.set(x, y);
+        label[idx(x,y,width)] = id;
+    };
     int node_id = 0;
-    for (const auto& g : groups) if (!g.empty()) {
-        double sx=0, sy=0; for (int id : g){ sx += raw_nodes[id].x; sy += raw_nodes[id].y; }
-        int cx = static_cast<int>(std::round(sx / static_cast<double>(g.size())));
-        int cy = static_cast<int>(std::round(sy / static_cast<double>(g.size())));
-        TopoNode n; n.id = node_id; n.x = cx * resolution; n.y = cy * resolution;
+    for (const auto& g : groups) {
+        TopoNode n; n.id = node_id; n.x = (g.x + offset_x) * resolution; n.y = (g.y + offset_y) * resolution;
         topo.nodes.push_back(n);
-        label[idx(cx,cy,width)] = node_id;
+        markNode(g.x, g.y, node_id);
         ++node_id;
     }
 
     // Edge tracing: from each node, follow skeleton until another node or endpoint
-    std::vector<uint8_t> visited(width*height, 0);
-    auto isNode = [&](int x, int y){ int id = label[idx(x,y,width)]; return id >= 0; };
-
-    for (const auto& n : topo.nodes) {
-        int sx = static_cast<int>(std::round(n.x / resolution));
-        int sy = static_cast<int>(std::round(n.y / resolution));
-        
-        // Check if start position is on skeleton
-        if (!inBounds(sx, sy) || !is_skel[idx(sx, sy, width)]) {
-            // Find nearest skeleton pixel
-            int best_x = sx, best_y = sy, best_dist = 1000;
-            for (int dy = -3; dy <= 3; ++dy) {
-                for (int dx = -3; dx <= 3; ++dx) {
-                    int nx = sx + dx, ny = sy + dy;
-                    if (inBounds(nx, ny) && is_skel[idx(nx, ny, width)]) {
-                        int dist = dx*dx + dy*dy;
-                        if (dist < best_dist) {
-                            best_dist = dist;
-                            best_x = nx; best_y = ny;
-                        }
-                    }
-                }
-            }
-            sx = best_x; sy = best_y;
-        }
-        
+    PackedMask visited(width, height);
+    auto isVisited = [&](int x, int y){ return visited.test(x, y); };
+    auto isNode = [&](int x, int y){ return node_cells.test(x, y); };
+    const long max_steps = static_cast<long>(width) * static_cast<long>(height);
+
+    // Dead ends found while tracing append to topo.nodes, so iterate the seed
+    // nodes by index and copy each one (a reference would dangle on growth)
+    const size_t seed_count = topo.nodes.size();
+    for (size_t ni = 0; ni < seed_count; ++ni) {
+        // Checked per seed, so every edge in a partial map is fully traced
+        if (stopRequested()) return partial();
+        meter.add(0.6 / static_cast<double>(seed_count));
+        const TopoNode n = topo.nodes[ni];
+        const auto start = skeleton::startCell(onSkeleton, groups[ni].x, groups[ni].y);
+        const int sx = start.first;
+        const int sy = start.second;
+
         for (int k = 0; k < 8; ++k) {
-            int nx = sx + dx8[k];
-            int ny = sy + dy8[k];
-            if (!inBounds(nx,ny) || !is_skel[idx(nx,ny,width)]) continue;
-            if (visited[idx(nx,ny,width)]) continue;
-            
-            // trace path
+            int nx = sx + skeleton::kDx8[k];
+            int ny = sy + skeleton::kDy8[k];
+            if (!onSkeleton(nx, ny) || visited.test(nx, ny)) continue;
+
             std::vector<std::pair<double,double>> poly;
-            int px = sx; int py = sy; int cx = nx; int cy = ny;
-            double length = 0.0;
-            int steps = 0;
-            while (steps < width * height) { // Reduced limit
-                visited[idx(cx,cy,width)] = 1;
-                poly.emplace_back(cx * resolution, cy * resolution);
-                
-                if (isNode(cx,cy) && !(cx == sx && cy == sy)) {
-                    int to_id = label[idx(cx,cy,width)];
-                    TopoEdge e; e.id = static_cast<int>(topo.edges.size()); e.u = n.id; e.v = to_id; e.length = length; e.polyline = poly;
-                    topo.edges.push_back(std::move(e));
-                    break;
-                }
-                
-                // prevent cycling back to start node
-                if (cx == sx && cy == sy) {
-                    break;
+            std::vector<float> profile;
+            float clear_min = std::numeric_limits<float>::max();
+            double clear_sum = 0.0;
+            // Ridges never lie on the map border, so skeleton on the grid
+            // border means the grid is part of the map and the edge goes on
+            bool clipped = false;
+            auto visit = [&](int cx, int cy) {
+                visited.set(cx, cy);
+                poly.emplace_back((cx + offset_x) * resolution, (cy + offset_y) * resolution);
+                clipped = clipped || cx == 0 || cy == 0 || cx == width - 1 || cy == height - 1;
+                if (distance) {
+                    // Sampled on the pixel just visited, so no second pass over the field
+                    const float c = distance[idx(cx,cy,width)];
+                    clear_min = std::min(clear_min, c);
+                    clear_sum += c;
+                    if (params_.record_clearance_profile) profile.push_back(c);
                 }
-                
-                // choose next neighbor (avoid returning to previous pixel)
-                int nextx = -1, nexty = -1, choices = 0;
-                for (int kk = 0; kk < 8; ++kk) {
-                    int tx = cx + dx8[kk];
-                    int ty = cy + dy8[kk];
-                    if (!inBounds(tx,ty) || !is_skel[idx(tx,ty,width)]) continue;
-                    if (tx == px && ty == py) continue;
-                    if (visited[idx(tx,ty,width)]) continue; // avoid cycles
-                    ++choices; nextx = tx; nexty = ty;
-                }
-                
-                if (choices == 0) {
-                    // dead end -> create node if not exist
-                    if (!isNode(cx,cy)) {
-                        TopoNode m; m.id = node_id; m.x = cx * resolution; m.y = cy * resolution; 
-                        topo.nodes.push_back(m); 
-                        label[idx(cx,cy,width)] = node_id; 
-                        ++node_id;
-                        int to_id = label[idx(cx,cy,width)];
-                        TopoEdge e; e.id = static_cast<int>(topo.edges.size()); e.u = n.id; e.v = to_id; e.length = length; e.polyline = poly;
-                        topo.edges.push_back(std::move(e));
-                    }
-                    break;
-                }
-                
-                length += std::hypot(static_cast<double>(nextx - cx) * resolution, static_cast<double>(nexty - cy) * resolution);
-                px = cx; py = cy; cx = nextx; cy = nexty;
-                ++steps;
+            };
+            const skeleton::Walk w = skeleton::walk(onSkeleton, isVisited, isNode, visit,
+                                                    sx, sy, nx, ny, resolution, max_steps);
+            int to_id = -1;
+            if (w.end == skeleton::WalkEnd::Node) {
+                to_id = label.at(idx(w.x,w.y,width));
+            } else if (w.end == skeleton::WalkEnd::DeadEnd) {
+                TopoNode m; m.id = node_id; m.x = (w.x + offset_x) * resolution; m.y = (w.y + offset_y) * resolution;
+                topo.nodes.push_back(m);
+                markNode(w.x, w.y, node_id);
+                to_id = node_id++;
+            } else {
+                continue; // looped back to the start or ran too long
+            }
+            TopoEdge e; e.id = static_cast<int>(topo.edges.size()); e.u = n.id; e.v = to_id; e.length = w.length;
+            e.clipped = clipped;
+            if (distance && !poly.empty()) {
+                e.min_clearance = clear_min;
+                e.mean_clearance = clear_sum / static_cast<double>(poly.size());
+                if (params_.record_clearance_profile) e.clearance = std::move(profile);
             }
+            e.polyline = std::move(poly);
+            topo.edges.push_back(std::move(e));
         }
     }
 
-    // Pruning: remove edges shorter than threshold
-    const double min_len = params_.prune_min_length;
+    // Pruning: remove short edges between two dead ends
+    std::unordered_map<int, int> degree;
+    for (const auto& e : topo.edges) {
+        ++degree[e.u];
+        if (e.v != e.u) ++degree[e.v];
+    }
     std::vector<TopoEdge> kept;
     kept.reserve(topo.edges.size());
     for (auto& e : topo.edges) {
-        // Only prune if edge is very short AND connects to degree-1 nodes (endpoints)
-        bool should_keep = true;
-        if (e.length < min_len) {
-            // Check if both endpoints are degree-1 nodes (dead ends)
-            bool u_is_endpoint = false, v_is_endpoint = false;
-            for (const auto& node : topo.nodes) {
-                if (node.id == e.u) {
-                    // Count edges connected to this node
-                    int degree = 0;
-                    for (const auto& other_edge : topo.edges) {
-                        if (other_edge.u == e.u || other_edge.v == e.u) degree++;
-                    }
-                    u_is_endpoint = (degree <= 1);
-                }
-                if (node.id == e.v) {
-                    int degree = 0;
-                    for (const auto& other_edge : topo.edges) {
-                        if (other_edge.u == e.v || other_edge.v == e.v) degree++;
-                    }
-                    v_is_endpoint = (degree <= 1);
-                }
-            }
-            // Only prune if both endpoints are dead ends
-            should_keep = !(u_is_endpoint && v_is_endpoint);
-        }
-        if (should_keep) kept.push_back(std::move(e));
+        if (!skeleton::prunable(e.length, params_.prune_min_length, degree[e.u], degree[e.v])) kept.push_back(std::move(e));
     }
     topo.edges.swap(kept);
+    meter.finish();
 
     return topo;
 }
 
 std::string toJson(const TopologicalMap& map) {
-    std::ostringstream os;
-    os << "{\n  \"nodes\": [\n";
-    for (size_t i = 0; i < map.nodes.size(); ++i) {
-        const auto& n = map.nodes[i];
-        os << "    {\"id\": " << n.id << ", \"x\": " << n.x << ", \"y\": " << n.y << "}";
-        if (i + 1 < map.nodes.size()) os << ",";
-        os << "\n";
-    }
-    os << "  ],\n  \"edges\": [\n";
-    for (size_t i = 0; i < map.edges.size(); ++i) {
-        const auto& e = map.edges[i];
-        os << "    {\"id\": " << e.id << ", \"u\": " << e.u << ", \"v\": " << e.v << ", \"length\": " << e.length << ", \"polyline\": [";
-        for (size_t j = 0; j < e.polyline.size(); ++j) {
-            os << "[" << e.polyline[j].first << ", " << e.polyline[j].second << "]";
-            if (j + 1 < e.polyline.size()) os << ", ";
-        }
-        os << "]}";
-        if (i + 1 < map.edges.size()) os << ",";
-        os << "\n";
-    }
-    os << "  ]\n}";
-    return os.str();
+    return formatTopologyJson(map);
 }
 
 } // namespace gvd_topo
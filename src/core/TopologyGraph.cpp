@@ -0,0 +1,335 @@
+#include "gvd_topo/core/TopologyGraph.hpp"
+#include "gvd_topo/core/TopologyOverlay.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace gvd_topo {
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+inline uint64_t fnv1a(uint64_t h, const void* data, size_t n) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    return h;
+}
+template <typename T>
+inline uint64_t fnv1a(uint64_t h, const T& v) { return fnv1a(h, &v, sizeof(T)); }
+
+std::vector<int> denseIndex(const std::vector<int>& ids) {
+    int max_id = -1;
+    for (int id : ids) {
+        if (id < 0) return {};
+        max_id = std::max(max_id, id);
+    }
+    // Sparse id spaces fall back to a linear scan in lookups
+    if (static_cast<size_t>(max_id + 1) > 4 * ids.size() + 1024) return {};
+    std::vector<int> index(static_cast<size_t>(max_id + 1), -1);
+    for (size_t i = 0; i < ids.size(); ++i) index[ids[i]] = static_cast<int>(i);
+    return index;
+}
+
+int lookup(const std::vector<int>& dense, const std::vector<int>& ids, int id) {
+    if (!dense.empty()) return (id >= 0 && id < static_cast<int>(dense.size())) ? dense[id] : -1;
+    auto it = std::find(ids.begin(), ids.end(), id);
+    return it == ids.end() ? -1 : static_cast<int>(it - ids.begin());
+}
+
+// Reusable per-thread Dijkstra workspace; stamps avoid clearing per search
+struct SearchState {
+    std::vector<double> dist;
+    std::vector<int> pred;
+    std::vector<uint32_t> stamp;
+    std::vector<std::pair<double,int>> heap;
+    uint32_t current {0};
+
+    void reset(int nodes) {
+        if (static_cast<int>(dist.size()) != nodes) {
+            dist.assign(nodes, kInf);
+            pred.assign(nodes, -1);
+            stamp.assign(nodes, 0);
+            current = 0;
+        }
+        if (++current == 0) { std::fill(stamp.begin(), stamp.end(), 0); current = 1; }
+        heap.clear();
+    }
+    double get(int n) const { return stamp[n] == current ? dist[n] : kInf; }
+    void relax(int n, double d, int via) {
+        if (d < get(n)) {
+            stamp[n] = current; dist[n] = d; pred[n] = via;
+            heap.emplace_back(d, n);
+            std::push_heap(heap.begin(), heap.end(), std::greater<>());
+        }
+    }
+};
+
+inline double edgeCost(const TopologyGraph& g, const TopologyOverlay* overlay, int e) {
+    if (!overlay) return g.edgeLength(e);
+    // Checked first: a zero-length edge times +inf would be NaN, not blocked
+    const double factor = overlay->edgeFactor(e);
+    return factor == kInf ? kInf : g.edgeLength(e) * factor;
+}
+
+void runSearch(const TopologyGraph& g, const GraphLocation& src, const TopologyOverlay* overlay, SearchState& st) {
+    st.reset(g.nodeCount());
+    if (src.node >= 0) {
+        if (!overlay || !overlay->nodeBlocked(src.node)) st.relax(src.node, 0.0, -1);
+    } else if (src.edge >= 0) {
+        const double cost = edgeCost(g, overlay, src.edge);
+        if (cost != kInf) {
+            st.relax(g.edgeU(src.edge), src.fraction * cost, -1);
+            st.relax(g.edgeV(src.edge), (1.0 - src.fraction) * cost, -1);
+        }
+    }
+    while (!st.heap.empty()) {
+        std::pop_heap(st.heap.begin(), st.heap.end(), std::greater<>());
+        auto [d, n] = st.heap.back();
+        st.heap.pop_back();
+        if (d > st.get(n)) continue;
+        for (const auto* a = g.arcsBegin(n); a != g.arcsEnd(n); ++a) {
+            const double cost = edgeCost(g, overlay, a->edge);
+            if (cost != kInf) st.relax(a->to, d + cost, a->edge);
+        }
+    }
+}
+
+// Cost to reach `dst`; `via_node` receives the node the path enters through
+// (-1 for a direct run along a shared edge)
+double distanceTo(const TopologyGraph& g, const GraphLocation& src, const GraphLocation& dst,
+                  const TopologyOverlay* overlay, const SearchState& st, int* via_node = nullptr) {
+    if (via_node) *via_node = dst.node;
+    if (dst.node >= 0) return st.get(dst.node);
+    if (dst.edge < 0) return kInf;
+    const double cost = edgeCost(g, overlay, dst.edge);
+    if (cost == kInf) return kInf;
+    const int u = g.edgeU(dst.edge), v = g.edgeV(dst.edge);
+    const double du = st.get(u) + dst.fraction * cost;
+    const double dv = st.get(v) + (1.0 - dst.fraction) * cost;
+    double d = du <= dv ? du : dv;
+    if (via_node) *via_node = du <= dv ? u : v;
+    if (src.edge == dst.edge) {
+        const double direct = std::abs(src.fraction - dst.fraction) * cost;
+        if (direct <= d) { d = direct; if (via_node) *via_node = -1; }
+    }
+    return d;
+}
+
+uint64_t queryKey(const TopologyGraph& graph,
+                  const std::vector<GraphLocation>& sources,
+                  const std::vector<GraphLocation>& targets,
+                  const DistanceMatrixOptions& options) {
+    uint64_t h = fnv1a(1469598103934665603ull, graph.fingerprint());
+    for (const auto* list : { &sources, &targets }) {
+        h = fnv1a(h, list->size());
+        for (const auto& l : *list) {
+            h = fnv1a(h, l.node); h = fnv1a(h, l.edge); h = fnv1a(h, l.fraction);
+        }
+    }
+    h = fnv1a(h, options.compute_predecessors);
+    h = fnv1a(h, options.overlay);
+    return fnv1a(h, options.overlay ? options.overlay->revision() : 0);
+}
+
+} // namespace
+
+TopologyGraph::TopologyGraph(const TopologicalMap& map) {
+    const size_t n = map.nodes.size();
+    node_ids_.reserve(n); node_x_.reserve(n); node_y_.reserve(n);
+    uint64_t h = 1469598103934665603ull;
+    for (const auto& node : map.nodes) {
+        node_ids_.push_back(node.id);
+        node_x_.push_back(node.x);
+        node_y_.push_back(node.y);
+        h = fnv1a(h, node.id); h = fnv1a(h, node.x); h = fnv1a(h, node.y);
+    }
+    node_index_by_id_ = denseIndex(node_ids_);
+
+    std::vector<size_t> degree(n + 1, 0);
+    geom_offsets_.push_back(0);
+    for (const auto& e : map.edges) {
+        const int u = nodeIndex(e.u);
+        const int v = nodeIndex(e.v);
+        if (u < 0 || v < 0) continue; // dangling edge; not routable
+        edge_ids_.push_back(e.id);
+        edge_u_.push_back(u);
+        edge_v_.push_back(v);
+        edge_length_.push_back(std::max(0.0, e.length));
+        h = fnv1a(h, e.id); h = fnv1a(h, e.u); h = fnv1a(h, e.v); h = fnv1a(h, e.length);
+
+        geom_.push_back(node_x_[u]); geom_.push_back(node_y_[u]);
+        for (const auto& p : e.polyline) { geom_.push_back(p.first); geom_.push_back(p.second); }
+        geom_.push_back(node_x_[v]); geom_.push_back(node_y_[v]);
+        geom_offsets_.push_back(geom_.size());
+
+        if (u != v) { ++degree[u]; ++degree[v]; }
+    }
+    edge_index_by_id_ = denseIndex(edge_ids_);
+    fingerprint_ = h;
+
+    arc_offsets_.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) arc_offsets_[i + 1] = arc_offsets_[i] + degree[i];
+    arcs_.resize(arc_offsets_[n]);
+    std::vector<size_t> fill(arc_offsets_.begin(), arc_offsets_.end() - 1);
+    for (int e = 0; e < edgeCount(); ++e) {
+        const int u = edge_u_[e], v = edge_v_[e];
+        if (u == v) continue;
+        arcs_[fill[u]++] = Arc{v, e};
+        arcs_[fill[v]++] = Arc{u, e};
+    }
+}
+
+int TopologyGraph::nodeIndex(int node_id) const { return lookup(node_index_by_id_, node_ids_, node_id); }
+int TopologyGraph::edgeIndex(int edge_id) const { return lookup(edge_index_by_id_, edge_ids_, edge_id); }
+
+std::pair<const double*, size_t> TopologyGraph::edgeGeometry(int index) const {
+    const size_t begin = geom_offsets_[index];
+    return { geom_.data() + begin, (geom_offsets_[index + 1] - begin) / 2 };
+}
+
+GraphLocation TopologyGraph::snap(double x, double y) const {
+    GraphLocation best;
+    double best_d2 = kInf;
+    for (int e = 0; e < edgeCount(); ++e) {
+        auto [pts, count] = edgeGeometry(e);
+        // Arc length is measured on the polyline and then rescaled to the
+        // edge's reported length so costs stay consistent with TopoEdge::length
+        double total = 0.0;
+        for (size_t i = 1; i < count; ++i) {
+            total += std::hypot(pts[2*i] - pts[2*i-2], pts[2*i+1] - pts[2*i-1]);
+        }
+        double walked = 0.0;
+        for (size_t i = 1; i < count; ++i) {
+            const double ax = pts[2*i-2], ay = pts[2*i-1];
+            const double bx = pts[2*i], by = pts[2*i+1];
+            const double sx = bx - ax, sy = by - ay;
+            const double seg2 = sx * sx + sy * sy;
+            double t = seg2 > 0.0 ? ((x - ax) * sx + (y - ay) * sy) / seg2 : 0.0;
+            t = std::clamp(t, 0.0, 1.0);
+            const double px = ax + t * sx - x, py = ay + t * sy - y;
+            const double d2 = px * px + py * py;
+            const double seg = std::sqrt(seg2);
+            if (d2 < best_d2) {
+                best_d2 = d2;
+                best.node = -1;
+                best.edge = e;
+                best.fraction = total > 0.0 ? (walked + t * seg) / total : 0.0;
+            }
+            walked += seg;
+        }
+    }
+    for (int n = 0; n < nodeCount(); ++n) {
+        if (arc_offsets_[n] != arc_offsets_[n + 1]) continue; // covered by its edges
+        const double dx = node_x_[n] - x, dy = node_y_[n] - y;
+        const double d2 = dx * dx + dy * dy;
+        if (d2 < best_d2) { best_d2 = d2; best = GraphLocation{}; best.node = n; }
+    }
+    if (best.valid()) best.snap_distance = std::sqrt(best_d2);
+    return best;
+}
+
+std::vector<GraphLocation> TopologyGraph::snap(const std::vector<std::pair<double,double>>& points) const {
+    std::vector<GraphLocation> out(points.size());
+    const int count = static_cast<int>(points.size());
+    ThreadPool::shared().parallelFor(0, count, 0, [&](int i0, int i1) {
+        for (int i = i0; i < i1; ++i) out[i] = snap(points[i].first, points[i].second);
+    }, 8);
+    return out;
+}
+
+DistanceMatrix computeDistanceMatrix(const TopologyGraph& graph,
+                                     const std::vector<GraphLocation>& sources,
+                                     const std::vector<GraphLocation>& targets,
+                                     const DistanceMatrixOptions& options) {
+    DistanceMatrix m;
+    m.rows = sources.size();
+    m.cols = targets.size();
+    m.values.assign(m.rows * m.cols, kInf);
+    if (options.compute_predecessors) m.predecessors.resize(m.rows);
+
+    const int rows = static_cast<int>(m.rows);
+    auto solveRow = [&](int r, SearchState& st) {
+        const GraphLocation& src = sources[r];
+        if (!src.valid()) return;
+        runSearch(graph, src, options.overlay, st);
+        double* out = m.values.data() + static_cast<size_t>(r) * m.cols;
+        for (size_t c = 0; c < m.cols; ++c) out[c] = distanceTo(graph, src, targets[c], options.overlay, st);
+        if (options.compute_predecessors) {
+            auto& tree = m.predecessors[r];
+            tree.resize(graph.nodeCount());
+            for (int n = 0; n < graph.nodeCount(); ++n) tree[n] = st.stamp[n] == st.current ? st.pred[n] : -1;
+        }
+    };
+
+    // One workspace per chunk of sources
+    const int threads = options.use_parallel ? options.max_threads : 1;
+    ThreadPool::shared().parallelFor(0, rows, threads, [&](int r0, int r1) {
+        SearchState st;
+        for (int r = r0; r < r1; ++r) solveRow(r, st);
+    });
+    return m;
+}
+
+GraphPath shortestPath(const TopologyGraph& graph, const GraphLocation& from, const GraphLocation& to,
+                       const TopologyOverlay* overlay) {
+    GraphPath path;
+    path.cost = kInf;
+    if (!from.valid() || !to.valid()) return path;
+    SearchState st;
+    runSearch(graph, from, overlay, st);
+    int via = -1;
+    path.cost = distanceTo(graph, from, to, overlay, st, &via);
+    if (path.cost == kInf) return path;
+    for (int n = via, guard = 0; n >= 0 && st.pred[n] >= 0 && st.stamp[n] == st.current && guard < graph.nodeCount(); ++guard) {
+        const int e = st.pred[n];
+        path.edges.push_back(e);
+        n = graph.edgeU(e) == n ? graph.edgeV(e) : graph.edgeU(e);
+    }
+    std::reverse(path.edges.begin(), path.edges.end());
+    // Partial edges at either end of an along-edge location
+    if (from.edge >= 0 && (path.edges.empty() || path.edges.front() != from.edge) && via >= 0) {
+        path.edges.insert(path.edges.begin(), from.edge);
+    }
+    if (to.edge >= 0 && (path.edges.empty() || path.edges.back() != to.edge)) path.edges.push_back(to.edge);
+    return path;
+}
+
+std::vector<int> tracePredecessors(const TopologyGraph& graph, const std::vector<int>& predecessors, int node) {
+    std::vector<int> path;
+    if (node < 0 || node >= static_cast<int>(predecessors.size())) return path;
+    // Bounded walk guards against a malformed tree
+    for (int guard = 0; predecessors[node] >= 0 && guard < graph.nodeCount(); ++guard) {
+        const int e = predecessors[node];
+        path.push_back(e);
+        node = graph.edgeU(e) == node ? graph.edgeV(e) : graph.edgeU(e);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::shared_ptr<const DistanceMatrix> DistanceMatrixCache::get(const TopologyGraph& graph,
+                                                               const std::vector<GraphLocation>& sources,
+                                                               const std::vector<GraphLocation>& targets,
+                                                               const DistanceMatrixOptions& options) {
+    const uint64_t key = queryKey(graph, sources, targets, options);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cached_ && key_ == key) return cached_;
+    }
+    auto result = std::make_shared<const DistanceMatrix>(computeDistanceMatrix(graph, sources, targets, options));
+    std::lock_guard<std::mutex> lock(mutex_);
+    key_ = key;
+    cached_ = result;
+    return result;
+}
+
+void DistanceMatrixCache::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cached_.reset();
+    key_ = 0;
+}
+
+} // namespace gvd_topo
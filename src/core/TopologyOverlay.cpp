@@ -0,0 +1,171 @@
+#include "gvd_topo/core/TopologyOverlay.hpp"
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+namespace gvd_topo {
+
+namespace {
+
+bool pointInPolygon(const Polygon2D& poly, double x, double y) {
+    bool inside = false;
+    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+        const auto& a = poly[i];
+        const auto& b = poly[j];
+        if ((a.second > y) != (b.second > y) &&
+            x < (b.first - a.first) * (y - a.second) / (b.second - a.second) + a.first) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+double cross(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+bool segmentsIntersect(double ax, double ay, double bx, double by,
+                       double cx, double cy, double dx, double dy) {
+    const double d1 = cross(cx, cy, dx, dy, ax, ay);
+    const double d2 = cross(cx, cy, dx, dy, bx, by);
+    const double d3 = cross(ax, ay, bx, by, cx, cy);
+    const double d4 = cross(ax, ay, bx, by, dx, dy);
+    return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+bool geometryEntersPolygon(const double* pts, size_t count, const Polygon2D& poly) {
+    for (size_t i = 0; i < count; ++i) {
+        if (pointInPolygon(poly, pts[2*i], pts[2*i+1])) return true;
+    }
+    for (size_t i = 1; i < count; ++i) {
+        for (size_t k = 0, j = poly.size() - 1; k < poly.size(); j = k++) {
+            if (segmentsIntersect(pts[2*i-2], pts[2*i-1], pts[2*i], pts[2*i+1],
+                                  poly[j].first, poly[j].second, poly[k].first, poly[k].second)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TopologyOverlay::TopologyOverlay(const TopologyGraph& graph)
+    : graph_(&graph)
+    , edge_blocked_(static_cast<size_t>(graph.edgeCount()), 0)
+    , node_blocked_(static_cast<size_t>(graph.nodeCount()), 0)
+    , edge_scale_(static_cast<size_t>(graph.edgeCount()), 1.0) {}
+
+bool TopologyOverlay::blockEdge(int edge_id) {
+    const int e = graph_->edgeIndex(edge_id);
+    if (e < 0) return false;
+    edge_blocked_[e] = 1; ++revision_;
+    return true;
+}
+
+bool TopologyOverlay::unblockEdge(int edge_id) {
+    const int e = graph_->edgeIndex(edge_id);
+    if (e < 0) return false;
+    edge_blocked_[e] = 0; ++revision_;
+    return true;
+}
+
+bool TopologyOverlay::blockNode(int node_id) {
+    const int n = graph_->nodeIndex(node_id);
+    if (n < 0) return false;
+    node_blocked_[n] = 1; ++revision_;
+    return true;
+}
+
+bool TopologyOverlay::unblockNode(int node_id) {
+    const int n = graph_->nodeIndex(node_id);
+    if (n < 0) return false;
+    node_blocked_[n] = 0; ++revision_;
+    return true;
+}
+
+bool TopologyOverlay::scaleEdgeCost(int edge_id, double factor) {
+    const int e = graph_->edgeIndex(edge_id);
+    if (e < 0 || !(factor >= 0.0)) return false;
+    edge_scale_[e] = factor; ++revision_;
+    return true;
+}
+
+template <typename Fn>
+size_t TopologyOverlay::forEachInPolygon(const Polygon2D& polygon, Fn&& on_edge, bool nodes_blocked) {
+    if (polygon.size() < 3) return 0;
+    size_t touched = 0;
+    for (int e = 0; e < graph_->edgeCount(); ++e) {
+        auto [pts, count] = graph_->edgeGeometry(e);
+        if (geometryEntersPolygon(pts, count, polygon)) { on_edge(e); ++touched; }
+    }
+    for (int n = 0; n < graph_->nodeCount(); ++n) {
+        if (pointInPolygon(polygon, graph_->nodeX(n), graph_->nodeY(n))) node_blocked_[n] = nodes_blocked ? 1 : 0;
+    }
+    ++revision_;
+    return touched;
+}
+
+size_t TopologyOverlay::blockPolygon(const Polygon2D& polygon) {
+    return forEachInPolygon(polygon, [&](int e) { edge_blocked_[e] = 1; }, true);
+}
+
+size_t TopologyOverlay::unblockPolygon(const Polygon2D& polygon) {
+    return forEachInPolygon(polygon, [&](int e) { edge_blocked_[e] = 0; }, false);
+}
+
+size_t TopologyOverlay::scalePolygon(const Polygon2D& polygon, double factor) {
+    if (!(factor >= 0.0) || polygon.size() < 3) return 0;
+    size_t touched = 0;
+    for (int e = 0; e < graph_->edgeCount(); ++e) {
+        auto [pts, count] = graph_->edgeGeometry(e);
+        if (geometryEntersPolygon(pts, count, polygon)) { edge_scale_[e] = factor; ++touched; }
+    }
+    ++revision_;
+    return touched;
+}
+
+void TopologyOverlay::clear() {
+    std::fill(edge_blocked_.begin(), edge_blocked_.end(), 0);
+    std::fill(node_blocked_.begin(), node_blocked_.end(), 0);
+    std::fill(edge_scale_.begin(), edge_scale_.end(), 1.0);
+    ++revision_;
+}
+
+double TopologyOverlay::edgeFactor(int edge_index) const {
+    if (edge_blocked_[edge_index] ||
+        node_blocked_[graph_->edgeU(edge_index)] ||
+        node_blocked_[graph_->edgeV(edge_index)]) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return edge_scale_[edge_index];
+}
+
+TopologicalMap applyOverlay(const TopologicalMap& map, const TopologyOverlay& overlay) {
+    const TopologyGraph& g = overlay.graph();
+    TopologicalMap out;
+    out.has_clearance = map.has_clearance; // edges keep their clearance data
+    out.complete = map.complete;           // an anytime map stays flagged partial
+    std::unordered_set<int> dropped_nodes;
+    out.nodes.reserve(map.nodes.size());
+    for (const auto& n : map.nodes) {
+        const int idx = g.nodeIndex(n.id);
+        if (idx >= 0 && overlay.nodeBlocked(idx)) { dropped_nodes.insert(n.id); continue; }
+        out.nodes.push_back(n);
+    }
+    out.edges.reserve(map.edges.size());
+    for (const auto& e : map.edges) {
+        // Edges the graph does not index (e.g. dangling ones) still must not
+        // point at a node removed above
+        if (dropped_nodes.count(e.u) || dropped_nodes.count(e.v)) continue;
+        const int idx = g.edgeIndex(e.id);
+        if (idx < 0) { out.edges.push_back(e); continue; }
+        const double factor = overlay.edgeFactor(idx);
+        if (factor == std::numeric_limits<double>::infinity()) continue;
+        out.edges.push_back(e);
+        out.edges.back().length = e.length * factor;
+    }
+    return out;
+}
+
+} // namespace gvd_topo
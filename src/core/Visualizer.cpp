@@ -1,8 +1,11 @@
 #include "gvd_topo/core/Visualizer.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/GvdGenerator.hpp"
 #include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 
 #ifdef GVD_TOPO_WITH_OPENCV
 #include <opencv2/imgcodecs.hpp>
@@ -129,4 +132,64 @@ void Visualizer::saveTopologicalMapAsImage(const TopologicalMap& map,
     saveTopologicalMapAsImage(map, output_path, options);
 }
 
+void Visualizer::saveGvdOverlay(const OccupancyGrid& grid, const GvdResult& gvd,
+                                const TopologicalMap& map, double resolution,
+                                const std::string& output_path) {
+#ifdef GVD_TOPO_WITH_OPENCV
+    cv::Mat vis(grid.height, grid.width, CV_8UC3);
+
+    // Create base visualization
+    for (int y = 0; y < grid.height; ++y) {
+        for (int x = 0; x < grid.width; ++x) {
+            int8_t c = grid.data[grid.index(x, y)];
+            uint8_t v = 127;
+            if (c == static_cast<int8_t>(100)) v = 0; // occupied -> black
+            else if (c == static_cast<int8_t>(0)) v = 255; // free -> white
+            vis.at<cv::Vec3b>(y,x) = cv::Vec3b(v,v,v);
+        }
+    }
+
+    // Overlay GVD; a coarse anytime result covers scale x scale grid cells per
+    // cell, and an ROI result starts at its offset (both in result cells)
+    const int s = std::max(1, gvd.scale);
+    for (int y = 0; y < gvd.height; ++y) {
+        const int y0 = (y + gvd.offset_y) * s;
+        for (int x = 0; x < gvd.width; ++x) {
+            if (!gvd.gvd_mask[y * gvd.width + x]) continue;
+            const int x0 = (x + gvd.offset_x) * s;
+            for (int gy = std::max(0, y0); gy < std::min(grid.height, y0 + s); ++gy) {
+                for (int gx = std::max(0, x0); gx < std::min(grid.width, x0 + s); ++gx) {
+                    vis.at<cv::Vec3b>(gy,gx) = cv::Vec3b(255,0,0); // GVD -> red
+                }
+            }
+        }
+    }
+
+    // Draw edges
+    for (const auto& edge : map.edges) {
+        for (size_t i = 1; i < edge.polyline.size(); ++i) {
+            cv::Point p0(static_cast<int>(std::round(edge.polyline[i-1].first / resolution)),
+                         static_cast<int>(std::round(edge.polyline[i-1].second / resolution)));
+            cv::Point p1(static_cast<int>(std::round(edge.polyline[i].first / resolution)),
+                         static_cast<int>(std::round(edge.polyline[i].second / resolution)));
+            cv::line(vis, p0, p1, cv::Scalar(0,0,255), 1); // edges -> blue
+        }
+    }
+
+    // Draw nodes
+    for (const auto& node : map.nodes) {
+        cv::Point p(static_cast<int>(std::round(node.x / resolution)),
+                    static_cast<int>(std::round(node.y / resolution)));
+        cv::circle(vis, p, 2, cv::Scalar(0,255,0), -1); // nodes -> green
+    }
+
+    if (!cv::imwrite(output_path, vis)) {
+        throw std::runtime_error("Failed to write " + output_path);
+    }
+#else
+    (void)grid; (void)gvd; (void)map; (void)resolution; (void)output_path;
+    throw std::runtime_error("OpenCV is required for the GVD overlay");
+#endif
+}
+
 } // namespace gvd_topo
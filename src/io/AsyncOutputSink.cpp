@@ -0,0 +1,137 @@
+#include "gvd_topo/io/AsyncOutputSink.hpp"
+#include "gvd_topo/core/Visualizer.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include "gvd_topo/utils/Timer.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace gvd_topo {
+
+namespace {
+
+// Shared by the tasks of one request; the last one to finish reports
+struct PendingRequest {
+    std::shared_ptr<const OccupancyGrid> grid;
+    std::shared_ptr<const GvdResult> gvd;
+    std::shared_ptr<const TopologicalMap> map;
+    OutputRequest request;
+    AsyncOutputSink::Callback on_done;
+    OutputReport report;
+    std::atomic<size_t> remaining {0};
+    std::promise<OutputReport> promise;
+};
+
+void writeOne(const PendingRequest& req, OutputResult& out) {
+    switch (out.kind) {
+    case OutputKind::MapJson:
+        writeTopologyJson(*req.map, out.path, req.request.json);
+        break;
+    case OutputKind::MapBinary:
+        writeTopologyBinary(*req.map, out.path);
+        break;
+    case OutputKind::DistanceField:
+        out.distance = writeDistanceField(*req.gvd, out.path, req.request.distance);
+        break;
+    case OutputKind::GvdOverlay:
+        if (!req.grid) throw std::runtime_error("GVD overlay requested without a grid");
+        Visualizer::saveGvdOverlay(*req.grid, *req.gvd, *req.map, req.request.resolution, out.path);
+        break;
+    case OutputKind::TopologyImage:
+        Visualizer::saveTopologicalMapAsImage(*req.map, out.path, req.request.topo_image_width,
+                                              req.request.topo_image_height);
+        break;
+    }
+}
+
+} // namespace
+
+AsyncOutputSink::AsyncOutputSink(int threads)
+    : pool_(std::make_unique<ThreadPool>(std::max(1, threads))) {}
+
+AsyncOutputSink::~AsyncOutputSink() {
+    flush();
+}
+
+std::future<OutputReport> AsyncOutputSink::submit(std::shared_ptr<const OccupancyGrid> grid,
+                                                  std::shared_ptr<const GvdResult> gvd,
+                                                  std::shared_ptr<const TopologicalMap> map,
+                                                  OutputRequest request,
+                                                  Callback on_done) {
+    auto req = std::make_shared<PendingRequest>();
+    req->grid = std::move(grid);
+    req->gvd = std::move(gvd);
+    req->map = std::move(map);
+    req->request = std::move(request);
+    req->on_done = std::move(on_done);
+    std::future<OutputReport> result = req->promise.get_future();
+
+    const std::pair<OutputKind, const std::string*> wanted[] = {
+        {OutputKind::MapJson, &req->request.map_file},
+        {OutputKind::MapBinary, &req->request.map_binary_file},
+        {OutputKind::DistanceField, &req->request.distance_file},
+        {OutputKind::GvdOverlay, &req->request.gvd_image},
+        {OutputKind::TopologyImage, &req->request.topo_image},
+    };
+    for (const auto& w : wanted) {
+        if (w.second->empty()) continue;
+        OutputResult r;
+        r.kind = w.first;
+        r.path = *w.second;
+        req->report.outputs.push_back(std::move(r));
+    }
+    if (req->report.outputs.empty()) {
+        if (req->on_done) req->on_done(req->report);
+        req->promise.set_value(req->report);
+        return result;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++pending_;
+    }
+    req->remaining = req->report.outputs.size();
+    for (size_t i = 0; i < req->report.outputs.size(); ++i) {
+        pool_->submit([this, req, i]() {
+            OutputResult& out = req->report.outputs[i];
+            Timer timer;
+            try {
+                writeOne(*req, out);
+            } catch (const std::exception& e) {
+                out.error = e.what();
+            }
+            out.ms = timer.ms();
+            if (req->remaining.fetch_sub(1) != 1) return;
+            // Last output of the request: release the results before reporting
+            req->grid.reset();
+            req->gvd.reset();
+            req->map.reset();
+            if (req->on_done) {
+                try {
+                    req->on_done(req->report);
+                } catch (...) {
+                }
+            }
+            req->promise.set_value(std::move(req->report));
+            finished();
+        });
+    }
+    return result;
+}
+
+void AsyncOutputSink::finished() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) idle_.notify_all();
+}
+
+void AsyncOutputSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return pending_ == 0; });
+}
+
+size_t AsyncOutputSink::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+} // namespace gvd_topo
@@ -0,0 +1,472 @@
+#include "gvd_topo/io/BatchLoader.hpp"
+#include "gvd_topo/io/PgmLoader.hpp"
+#include "gvd_topo/io/YamlLoader.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include "gvd_topo/utils/Timer.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <set>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef GVD_TOPO_WITH_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace gvd_topo {
+
+namespace {
+
+// Largest single read request; longer files are read in several rounds
+constexpr size_t kMaxReadChunk = size_t(1) << 30;
+
+bool hasYamlExtension(const std::string& path) {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".yaml" || ext == ".yml";
+}
+
+std::string errnoMessage(int err) { return std::strerror(err); }
+
+#ifdef GVD_TOPO_WITH_IO_URING
+
+// Minimal io_uring driver over the raw syscalls (no liburing dependency):
+// one submission per read, completions reaped by the consuming thread.
+class UringReader {
+public:
+    ~UringReader() { release(); }
+
+    bool init(unsigned entries) {
+        io_uring_params p {};
+        p.flags = IORING_SETUP_CQSIZE;
+        p.cq_entries = entries * 2;
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+        if (ring_fd_ < 0) return false;
+
+        sq_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        sq_ptr_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) { sq_ptr_ = nullptr; release(); return false; }
+        if (single) {
+            cq_ptr_ = sq_ptr_;
+        } else {
+            cq_ptr_ = ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+            if (cq_ptr_ == MAP_FAILED) { cq_ptr_ = nullptr; release(); return false; }
+        }
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) { release(); return false; }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<uint8_t*>(sq_ptr_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        auto* cq = static_cast<uint8_t*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    // The caller keeps at most `entries` reads outstanding
+    bool submitRead(int fd, void* buf, unsigned len, uint64_t offset, void* tag) {
+        const unsigned tail = *sq_tail_;
+        const unsigned idx = tail & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[idx];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(buf);
+        sqe->len = len;
+        sqe->off = offset;
+        sqe->user_data = reinterpret_cast<uint64_t>(tag);
+        sq_array_[idx] = idx;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        for (;;) {
+            const long r = ::syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0);
+            if (r >= 0) return r == 1;
+            if (errno != EINTR) return false;
+        }
+    }
+
+    // Blocks for one completion; returns its result (bytes or -errno)
+    int waitCompletion(void*& tag) {
+        for (;;) {
+            const unsigned head = *cq_head_;
+            if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                tag = reinterpret_cast<void*>(cqe.user_data);
+                const int res = cqe.res;
+                __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+                return res;
+            }
+            const long r = ::syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (r < 0 && errno != EINTR) {
+                throw std::runtime_error("io_uring_enter failed: " + errnoMessage(errno));
+            }
+        }
+    }
+
+private:
+    int ring_fd_ {-1};
+    void* sq_ptr_ {nullptr};
+    void* cq_ptr_ {nullptr};
+    size_t sq_size_ {0};
+    size_t cq_size_ {0};
+    size_t sqes_size_ {0};
+    io_uring_sqe* sqes_ {nullptr};
+    unsigned* sq_tail_ {nullptr};
+    unsigned* sq_array_ {nullptr};
+    unsigned sq_mask_ {0};
+    unsigned* cq_head_ {nullptr};
+    unsigned* cq_tail_ {nullptr};
+    unsigned cq_mask_ {0};
+    io_uring_cqe* cqes_ {nullptr};
+
+    void release() {
+        if (sqes_) ::munmap(sqes_, sqes_size_);
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_size_);
+        if (sq_ptr_) ::munmap(sq_ptr_, sq_size_);
+        if (ring_fd_ >= 0) ::close(ring_fd_);
+        sqes_ = nullptr; cq_ptr_ = sq_ptr_ = nullptr; ring_fd_ = -1;
+    }
+};
+
+#endif // GVD_TOPO_WITH_IO_URING
+
+} // namespace
+
+struct BatchLoader::Impl {
+    // A map whose image read is in flight
+    struct Slot {
+        size_t index {0};
+        std::string path;
+        std::string image_path;
+        MapInfo info;
+        bool from_yaml {false};
+        int fd {-1};
+        std::unique_ptr<uint8_t[]> buffer; // uninitialised; filled by the read
+        size_t size {0};
+        size_t done {0};
+        bool complete {false};
+        std::string error;
+        Timer timer;
+        double read_ms {0.0};
+        std::future<void> pending; // pread backend
+    };
+
+    std::vector<std::string> paths;
+    BatchLoaderOptions options;
+    size_t next_index {0};
+    std::deque<std::unique_ptr<Slot>> window;
+    std::unique_ptr<ThreadPool> pool;
+#ifdef GVD_TOPO_WITH_IO_URING
+    // Buffers of reads abandoned on a ring failure; declared before the ring
+    // so they outlive it and any late completion still has memory to land in
+    std::vector<std::unique_ptr<uint8_t[]>> orphaned;
+    UringReader ring;
+    bool use_ring {false};
+    int ring_inflight {0};
+#endif
+
+    Impl(std::vector<std::string> p, const BatchLoaderOptions& o) : paths(std::move(p)), options(o) {
+        options.prefetch = std::max(1, options.prefetch);
+#ifdef GVD_TOPO_WITH_IO_URING
+        if (options.use_io_uring) {
+            unsigned entries = 1;
+            while (entries < static_cast<unsigned>(options.prefetch)) entries <<= 1;
+            use_ring = ring.init(entries);
+        }
+#endif
+    }
+
+    ~Impl() {
+        // Reads still own their buffers: let them land before freeing anything
+#ifdef GVD_TOPO_WITH_IO_URING
+        while (ring_inflight > 0) {
+            void* tag = nullptr;
+            try { ring.waitCompletion(tag); } catch (const std::exception&) { break; }
+            --ring_inflight;
+        }
+#endif
+        for (auto& s : window) {
+            if (s->pending.valid()) s->pending.wait();
+            if (s->fd >= 0) ::close(s->fd);
+        }
+    }
+
+    bool ringActive() const {
+#ifdef GVD_TOPO_WITH_IO_URING
+        return use_ring;
+#else
+        return false;
+#endif
+    }
+
+    void fill() {
+        while (window.size() < static_cast<size_t>(options.prefetch) && next_index < paths.size()) {
+            auto slot = std::make_unique<Slot>();
+            slot->index = next_index;
+            slot->path = paths[next_index];
+            ++next_index;
+            start(*slot);
+            window.push_back(std::move(slot));
+        }
+    }
+
+    void start(Slot& s) {
+        try {
+            s.image_path = s.path;
+            if (hasYamlExtension(s.path)) {
+                s.info = YamlLoader::loadMapInfo(s.path);
+                s.from_yaml = true;
+                s.image_path = (std::filesystem::path(s.path).parent_path() / s.info.image_file).string();
+            }
+            s.fd = ::open(s.image_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (s.fd < 0) throw std::runtime_error("Cannot open file: " + s.image_path);
+            struct stat st {};
+            if (::fstat(s.fd, &st) != 0) throw std::runtime_error("Cannot stat file: " + s.image_path);
+            if (!S_ISREG(st.st_mode)) throw std::runtime_error("Not a regular file: " + s.image_path);
+            s.size = static_cast<size_t>(st.st_size);
+            s.buffer.reset(new uint8_t[std::max<size_t>(s.size, 1)]);
+        } catch (const std::exception& e) {
+            s.error = e.what();
+            s.complete = true;
+            return;
+        }
+        s.timer.reset();
+        if (s.size == 0) { s.complete = true; return; }
+#ifdef GVD_TOPO_WITH_IO_URING
+        if (use_ring) {
+            if (submitRing(s)) return;
+            use_ring = false; // ring refused the request: pread from here on
+        }
+#endif
+        submitPread(s);
+    }
+
+    void submitPread(Slot& s) {
+        if (!pool) pool = std::make_unique<ThreadPool>(std::max(1, options.io_threads));
+        Slot* sp = &s;
+        s.pending = pool->submit([sp]() {
+            while (sp->done < sp->size) {
+                const ssize_t r = ::pread(sp->fd, sp->buffer.get() + sp->done,
+                                          std::min(sp->size - sp->done, kMaxReadChunk),
+                                          static_cast<off_t>(sp->done));
+                if (r < 0 && errno == EINTR) continue;
+                if (r < 0) { sp->error = "Read failed: " + sp->image_path + ": " + errnoMessage(errno); break; }
+                if (r == 0) { sp->error = "Unexpected end of file: " + sp->image_path; break; }
+                sp->done += static_cast<size_t>(r);
+            }
+            sp->read_ms = sp->timer.ms();
+        });
+    }
+
+#ifdef GVD_TOPO_WITH_IO_URING
+    bool submitRing(Slot& s) {
+        const size_t len = std::min(s.size - s.done, kMaxReadChunk);
+        if (!ring.submitRead(s.fd, s.buffer.get() + s.done, static_cast<unsigned>(len), s.done, &s)) return false;
+        ++ring_inflight;
+        return true;
+    }
+
+    // current: the slot being waited for, already taken out of the window
+    void reapOne(Slot& current) {
+        void* tag = nullptr;
+        int res = 0;
+        try {
+            res = ring.waitCompletion(tag);
+        } catch (const std::exception&) {
+            abandonRing(current);
+            return;
+        }
+        --ring_inflight;
+        Slot& s = *static_cast<Slot*>(tag);
+        if (res == -EINVAL || res == -EOPNOTSUPP) {
+            // Kernel without IORING_OP_READ: finish this read and the rest with pread
+            use_ring = false;
+            submitPread(s);
+            return;
+        }
+        if (res < 0) {
+            s.error = "Read failed: " + s.image_path + ": " + errnoMessage(-res);
+        } else if (res == 0) {
+            s.error = "Unexpected end of file: " + s.image_path;
+        } else {
+            s.done += static_cast<size_t>(res);
+            if (s.done < s.size) {
+                if (submitRing(s)) return;
+                use_ring = false;
+                submitPread(s);
+                return;
+            }
+        }
+        s.read_ms = s.timer.ms();
+        s.complete = true;
+    }
+
+    // Completions can no longer be waited for: every map with a ring read in
+    // flight is read again with pread into a fresh buffer
+    void abandonRing(Slot& current) {
+        use_ring = false;
+        ring_inflight = 0;
+        auto reread = [this](Slot& s) {
+            if (s.complete || s.pending.valid()) return;
+            orphaned.push_back(std::move(s.buffer));
+            s.buffer.reset(new uint8_t[std::max<size_t>(s.size, 1)]);
+            s.done = 0;
+            submitPread(s);
+        };
+        reread(current);
+        for (auto& s : window) reread(*s);
+    }
+#endif
+
+    void waitFor(Slot& s) {
+#ifdef GVD_TOPO_WITH_IO_URING
+        while (!s.complete && !s.pending.valid()) reapOne(s);
+#endif
+        if (s.pending.valid()) {
+            s.pending.get();
+            s.complete = true;
+        }
+    }
+
+    void parse(Slot& s, BatchMap& out) {
+        Timer timer;
+        if (PgmLoader::isPgm(s.buffer.get(), s.done)) {
+            const double res = s.from_yaml ? s.info.resolution : options.resolution;
+            CellThresholds t;
+            if (s.from_yaml) {
+                PgmThreshold threshold;
+                threshold.occupied_thresh = s.info.occupied_thresh;
+                threshold.free_thresh = s.info.free_thresh;
+                threshold.negate = s.info.negate;
+                t = CellThresholds::fromMapServer(threshold, PgmLoader::parseHeader(s.buffer.get(), s.done).maxval);
+            } else {
+                t = CellThresholds::fromBinary(options.occupancy_threshold);
+            }
+            out.grid = PgmLoader::fromBuffer(s.buffer.get(), s.done, res, t);
+        } else {
+            s.buffer.reset(); // the image decoder reads the file itself
+            out.grid = OccupancyGrid::loadFromImage(s.image_path,
+                                                   s.from_yaml ? s.info.resolution : options.resolution,
+                                                   options.occupancy_threshold);
+        }
+        if (s.from_yaml) {
+            out.grid.origin.x = s.info.origin_x;
+            out.grid.origin.y = s.info.origin_y;
+            out.grid.origin.theta = s.info.origin_theta;
+        }
+        out.parse_ms = timer.ms();
+    }
+};
+
+BatchLoader::BatchLoader(std::vector<std::string> paths, const BatchLoaderOptions& options)
+    : impl_(std::make_unique<Impl>(std::move(paths), options)) {
+    impl_->fill();
+}
+
+BatchLoader::~BatchLoader() = default;
+
+bool BatchLoader::next(BatchMap& out) {
+    Impl& im = *impl_;
+    if (im.window.empty()) return false;
+    std::unique_ptr<Impl::Slot> slot = std::move(im.window.front());
+    im.window.pop_front();
+    im.waitFor(*slot);
+    if (slot->fd >= 0) { ::close(slot->fd); slot->fd = -1; }
+    // Keep the window full while the caller works on this map
+    im.fill();
+
+    out = BatchMap{};
+    out.index = slot->index;
+    out.path = slot->path;
+    out.image_path = slot->image_path;
+    out.bytes = slot->size;
+    out.read_ms = slot->read_ms;
+    out.error = slot->error;
+    if (out.ok()) {
+        try {
+            im.parse(*slot, out);
+        } catch (const std::exception& e) {
+            out.grid = OccupancyGrid{};
+            out.error = e.what();
+        }
+    }
+    return true;
+}
+
+size_t BatchLoader::size() const { return impl_->paths.size(); }
+
+const char* BatchLoader::backend() const { return impl_->ringActive() ? "io_uring" : "pread"; }
+
+std::vector<std::string> BatchLoader::collectInputs(const std::string& dir_or_manifest) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> inputs;
+    const fs::path root(dir_or_manifest);
+    std::error_code ec;
+    if (fs::is_directory(root, ec)) {
+        std::vector<fs::path> yamls;
+        std::vector<fs::path> images;
+        for (const auto& entry : fs::directory_iterator(root)) {
+            if (!entry.is_regular_file()) continue;
+            if (hasYamlExtension(entry.path().string())) {
+                yamls.push_back(entry.path());
+            } else if (PgmLoader::isPgm(entry.path().string())) {
+                images.push_back(entry.path());
+            }
+        }
+        // Only YAMLs that describe a map (tool configs live alongside them)
+        std::set<fs::path> referenced;
+        for (const auto& y : yamls) {
+            MapInfo info;
+            try {
+                info = YamlLoader::loadMapInfo(y.string());
+            } catch (const std::exception&) {
+                continue;
+            }
+            if (info.image_file.empty()) continue;
+            inputs.push_back(y.string());
+            referenced.insert((root / info.image_file).lexically_normal());
+        }
+        for (const auto& img : images) {
+            if (!referenced.count(img.lexically_normal())) inputs.push_back(img.string());
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    std::ifstream manifest(dir_or_manifest);
+    if (!manifest.is_open()) {
+        throw std::runtime_error("Cannot open batch input: " + dir_or_manifest);
+    }
+    const fs::path base = root.parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty()) continue;
+        const fs::path p(line);
+        inputs.push_back(p.is_absolute() ? line : (base / p).string());
+    }
+    return inputs;
+}
+
+} // namespace gvd_topo
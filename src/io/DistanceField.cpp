@@ -0,0 +1,343 @@
+#include "gvd_topo/io/DistanceField.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__F16C__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace gvd_topo {
+
+namespace {
+
+constexpr char kMagic[8] = {'G','V','D','D','I','S','T','\0'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+constexpr uint64_t kDataOffset = 64; // cache-line aligned cells
+constexpr char kNpyMagic[6] = {'\x93','N','U','M','P','Y'};
+constexpr size_t kChunkCells = 1 << 20;
+constexpr double kFixedMax = 65535.0;
+constexpr double kHalfMax = 65504.0;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t format;
+    int32_t width;
+    int32_t height;
+    uint32_t reserved;
+    double quantum;
+    uint64_t data_offset;
+    uint64_t data_size;
+};
+static_assert(std::is_trivially_copyable<Header>::value, "Header must be POD");
+static_assert(sizeof(Header) <= kDataOffset, "Header must fit before the cells");
+
+inline uint32_t floatBits(float f) { uint32_t u; std::memcpy(&u, &f, sizeof(u)); return u; }
+inline float bitsFloat(uint32_t u) { float f; std::memcpy(&f, &u, sizeof(f)); return f; }
+
+// Round-to-nearest-even float -> half without F16C
+uint16_t halfFromFloat(float value) {
+    const uint32_t f32_infinity = 255u << 23;
+    const uint32_t f16_max = (127u + 16u) << 23;
+    const uint32_t denorm_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+    uint32_t x = floatBits(value);
+    const uint32_t sign = x & 0x80000000u;
+    x ^= sign;
+    uint16_t out;
+    if (x >= f16_max) {
+        out = (x > f32_infinity) ? 0x7E00 : 0x7C00; // NaN : Inf
+    } else if (x < (113u << 23)) {
+        // Subnormal: let the FPU do the rounding
+        out = static_cast<uint16_t>(floatBits(bitsFloat(x) + bitsFloat(denorm_magic)) - denorm_magic);
+    } else {
+        const uint32_t mant_odd = (x >> 13) & 1u;
+        x += ((15u - 127u) << 23) + 0xFFFu;
+        x += mant_odd;
+        out = static_cast<uint16_t>(x >> 13);
+    }
+    return static_cast<uint16_t>(out | (sign >> 16));
+}
+
+float floatFromHalf(uint16_t h) {
+    const uint32_t magic = 113u << 23;
+    const uint32_t shifted_exp = 0x7C00u << 13;
+    uint32_t o = (h & 0x7FFFu) << 13;
+    const uint32_t exp = shifted_exp & o;
+    o += (127u - 15u) << 23;
+    if (exp == shifted_exp) {
+        o += (128u - 16u) << 23; // Inf / NaN
+    } else if (exp == 0) {
+        o += 1u << 23;           // subnormal: renormalise
+        o = floatBits(bitsFloat(o) - bitsFloat(magic));
+    }
+    return bitsFloat(o | (static_cast<uint32_t>(h & 0x8000u) << 16));
+}
+
+std::string npyHeader(const char* descr, int width, int height) {
+    std::string dict = std::string("{'descr': '") + descr + "', 'fortran_order': False, 'shape': (" +
+                       std::to_string(height) + ", " + std::to_string(width) + "), }";
+    // magic(6) + version(2) + length(2) + dict, padded to 64 bytes, ending in '\n'
+    const size_t unpadded = 10 + dict.size() + 1;
+    dict.append((64 - unpadded % 64) % 64, ' ');
+    dict.push_back('\n');
+    std::string out(kNpyMagic, sizeof(kNpyMagic));
+    out.push_back('\x01');
+    out.push_back('\x00');
+    out.push_back(static_cast<char>(dict.size() & 0xFF));
+    out.push_back(static_cast<char>((dict.size() >> 8) & 0xFF));
+    return out + dict;
+}
+
+// Value of a quoted ('...') or bare key in a .npy header dict
+std::string npyField(const std::string& dict, const std::string& key) {
+    const size_t k = dict.find("'" + key + "'");
+    if (k == std::string::npos) return {};
+    size_t p = dict.find(':', k);
+    if (p == std::string::npos) return {};
+    p = dict.find_first_not_of(' ', p + 1);
+    if (p == std::string::npos) return {};
+    if (dict[p] == '\'') {
+        const size_t e = dict.find('\'', p + 1);
+        return e == std::string::npos ? std::string() : dict.substr(p + 1, e - p - 1);
+    }
+    if (dict[p] == '(') {
+        const size_t e = dict.find(')', p);
+        return e == std::string::npos ? std::string() : dict.substr(p + 1, e - p - 1);
+    }
+    const size_t e = dict.find_first_of(",}", p);
+    return dict.substr(p, e - p);
+}
+
+// One non-negative dimension of a .npy shape, surrounding spaces allowed
+bool parseNpyDim(const std::string& text, int& out) {
+    const size_t b = text.find_first_not_of(' ');
+    const size_t e = text.find_last_not_of(' ');
+    if (b == std::string::npos) return false;
+    const char* first = text.data() + b;
+    const char* last = text.data() + e + 1;
+    const auto result = std::from_chars(first, last, out);
+    return result.ec == std::errc() && result.ptr == last && out >= 0;
+}
+
+} // namespace
+
+DistanceFormat parseDistanceFormat(const std::string& name) {
+    if (name == "fixed16") return DistanceFormat::Fixed16;
+    if (name == "float16") return DistanceFormat::Float16;
+    if (name == "npy") return DistanceFormat::Npy;
+    throw std::runtime_error("Unknown distance format: " + name + " (expected fixed16, float16 or npy)");
+}
+
+const char* distanceFormatName(DistanceFormat format) {
+    switch (format) {
+        case DistanceFormat::Fixed16: return "fixed16";
+        case DistanceFormat::Float16: return "float16";
+        case DistanceFormat::Npy: return "npy";
+    }
+    return "unknown";
+}
+
+void quantizeFixed16(const float* src, uint16_t* dst, size_t n, double quantum) {
+    const float inv = static_cast<float>(1.0 / quantum);
+    const float max_q = static_cast<float>(kFixedMax);
+    // Branch-free clamp + round-half-up; vectorised by the compiler
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        const float q = std::min(std::max(src[i] * inv, 0.0f), max_q);
+        dst[i] = static_cast<uint16_t>(q + 0.5f);
+    }
+}
+
+void dequantizeFixed16(const uint16_t* src, float* dst, size_t n, double quantum) {
+    const float q = static_cast<float>(quantum);
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) dst[i] = static_cast<float>(src[i]) * q;
+}
+
+void floatToHalf(const float* src, uint16_t* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+#endif
+    for (; i < n; ++i) dst[i] = halfFromFloat(src[i]);
+}
+
+void halfToFloat(const uint16_t* src, float* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    for (; i < n; ++i) dst[i] = floatFromHalf(src[i]);
+}
+
+DistanceExportReport writeDistanceField(const GvdResult& gvd, const std::string& path,
+                                        const DistanceExportOptions& options) {
+    const size_t cells = static_cast<size_t>(gvd.width) * static_cast<size_t>(gvd.height);
+    if (gvd.width <= 0 || gvd.height <= 0 || gvd.distance.size() != cells) {
+        throw std::runtime_error("Distance field is empty or does not match its dimensions");
+    }
+    if (options.format == DistanceFormat::Fixed16 && !(options.quantum > 0.0)) {
+        throw std::runtime_error("Distance quantum must be positive");
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot create distance file: " + path);
+    }
+
+    DistanceExportReport report;
+    const float* src = gvd.distance.data();
+    if (options.format == DistanceFormat::Npy) {
+        const std::string header = npyHeader("<f4", gvd.width, gvd.height);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file.write(reinterpret_cast<const char*>(src), static_cast<std::streamsize>(cells * sizeof(float)));
+        report.bytes = header.size() + cells * sizeof(float);
+    } else {
+        Header h {};
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.version = kVersion;
+        h.byte_order = kByteOrderMark;
+        h.format = static_cast<uint32_t>(options.format);
+        h.width = gvd.width;
+        h.height = gvd.height;
+        h.quantum = options.format == DistanceFormat::Fixed16 ? options.quantum : 0.0;
+        h.data_offset = kDataOffset;
+        h.data_size = cells * sizeof(uint16_t);
+        char head[kDataOffset] = {};
+        std::memcpy(head, &h, sizeof(h));
+        file.write(head, sizeof(head));
+
+        // Encode in chunks and decode each chunk back to measure the error
+        std::vector<uint16_t> encoded(std::min(cells, kChunkCells));
+        std::vector<float> decoded(encoded.size());
+        const double limit = options.format == DistanceFormat::Fixed16 ? kFixedMax * options.quantum : kHalfMax;
+        float max_value = 0.0f;
+        for (size_t begin = 0; begin < cells; begin += kChunkCells) {
+            const size_t n = std::min(kChunkCells, cells - begin);
+            if (options.format == DistanceFormat::Fixed16) {
+                quantizeFixed16(src + begin, encoded.data(), n, options.quantum);
+                dequantizeFixed16(encoded.data(), decoded.data(), n, options.quantum);
+            } else {
+                floatToHalf(src + begin, encoded.data(), n);
+                halfToFloat(encoded.data(), decoded.data(), n);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const float v = src[begin + i];
+                if (v > limit) { ++report.saturated; continue; }
+                max_value = std::max(max_value, v);
+                report.max_error = std::max(report.max_error, static_cast<double>(std::fabs(decoded[i] - v)));
+            }
+            file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(n * sizeof(uint16_t)));
+        }
+        report.bytes = kDataOffset + h.data_size;
+        if (options.format == DistanceFormat::Fixed16) {
+            // Half a step, plus float32 rounding of the scaled value
+            report.error_bound = 0.5 * options.quantum + kFixedMax * options.quantum * std::numeric_limits<float>::epsilon();
+        } else {
+            // Half an ulp: 2^-11 relative for normals, 2^-25 absolute for subnormals
+            report.error_bound = std::max(std::ldexp(static_cast<double>(max_value), -11), std::ldexp(1.0, -25));
+        }
+    }
+    if (!file.flush()) {
+        throw std::runtime_error("Failed to write distance file: " + path);
+    }
+    return report;
+}
+
+MappedDistanceField::MappedDistanceField(const std::string& path) : file_(path) {
+    const uint8_t* data = file_.data();
+    const size_t size = file_.size();
+    uint64_t offset = 0;
+    if (size >= 10 && std::memcmp(data, kNpyMagic, sizeof(kNpyMagic)) == 0) {
+        const size_t header_len = data[8] | (static_cast<size_t>(data[9]) << 8);
+        if (data[6] != 1 || 10 + header_len > size) {
+            throw std::runtime_error("Unsupported or truncated .npy file: " + path);
+        }
+        const std::string dict(reinterpret_cast<const char*>(data) + 10, header_len);
+        const std::string descr = npyField(dict, "descr");
+        const std::string shape = npyField(dict, "shape");
+        if (npyField(dict, "fortran_order") != "False" || (descr != "<f4" && descr != "<f2")) {
+            throw std::runtime_error("Distance .npy must be C-ordered little-endian float32 or float16: " + path);
+        }
+        const size_t comma = shape.find(',');
+        if (comma == std::string::npos || shape.find_first_not_of(' ', comma + 1) == std::string::npos) {
+            throw std::runtime_error("Distance .npy must be two-dimensional: " + path);
+        }
+        if (!parseNpyDim(shape.substr(0, comma), height_) || !parseNpyDim(shape.substr(comma + 1), width_)) {
+            throw std::runtime_error("Invalid .npy shape (" + shape + "): " + path);
+        }
+        format_ = DistanceFormat::Npy;
+        cells_type_ = descr == "<f4" ? Cells::Single : Cells::Half;
+        element_size_ = descr == "<f4" ? sizeof(float) : sizeof(uint16_t);
+        offset = 10 + header_len;
+    } else {
+        Header h {};
+        if (size < kDataOffset) {
+            throw std::runtime_error("Truncated distance file: " + path);
+        }
+        std::memcpy(&h, data, sizeof(h));
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion ||
+            h.byte_order != kByteOrderMark ||
+            (h.format != static_cast<uint32_t>(DistanceFormat::Fixed16) &&
+             h.format != static_cast<uint32_t>(DistanceFormat::Float16))) {
+            throw std::runtime_error("Not a distance field file: " + path);
+        }
+        width_ = h.width;
+        height_ = h.height;
+        format_ = static_cast<DistanceFormat>(h.format);
+        cells_type_ = format_ == DistanceFormat::Fixed16 ? Cells::Fixed16 : Cells::Half;
+        element_size_ = sizeof(uint16_t);
+        quantum_ = h.quantum;
+        offset = h.data_offset;
+    }
+    if (width_ < 0 || height_ < 0 || offset % element_size_ != 0 ||
+        offset > size || this->size() > (size - offset) / element_size_) {
+        throw std::runtime_error("Truncated distance file: " + path);
+    }
+    cells_ = data + offset;
+}
+
+float MappedDistanceField::at(size_t index) const {
+    switch (cells_type_) {
+        case Cells::Fixed16: return static_cast<float>(static_cast<const uint16_t*>(cells_)[index] * quantum_);
+        case Cells::Half: return floatFromHalf(static_cast<const uint16_t*>(cells_)[index]);
+        case Cells::Single: return static_cast<const float*>(cells_)[index];
+    }
+    return 0.0f;
+}
+
+void MappedDistanceField::decode(size_t begin, size_t count, float* dst) const {
+    switch (cells_type_) {
+        case Cells::Fixed16:
+            dequantizeFixed16(static_cast<const uint16_t*>(cells_) + begin, dst, count, quantum_);
+            break;
+        case Cells::Half:
+            halfToFloat(static_cast<const uint16_t*>(cells_) + begin, dst, count);
+            break;
+        case Cells::Single:
+            std::memcpy(dst, static_cast<const float*>(cells_) + begin, count * sizeof(float));
+            break;
+    }
+}
+
+std::vector<float> MappedDistanceField::toVector() const {
+    std::vector<float> out(size());
+    decode(0, out.size(), out.data());
+    return out;
+}
+
+} // namespace gvd_topo
@@ -0,0 +1,183 @@
+#include "gvd_topo/io/JsonWriter.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace gvd_topo {
+
+namespace {
+
+// Appends numbers with std::to_chars; general format with N significant
+// digits is specified as printf("%.Ng"), i.e. what iostreams produce
+class Formatter {
+public:
+    Formatter(std::string& out, int precision) : out_(out), precision_(precision) {}
+
+    Formatter& operator<<(const char* s) { out_.append(s); return *this; }
+    Formatter& operator<<(int v) {
+        char buf[16];
+        auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        out_.append(buf, r.ptr);
+        return *this;
+    }
+    Formatter& operator<<(double v) {
+        char buf[64];
+        auto r = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::general, precision_);
+        out_.append(buf, r.ptr);
+        return *this;
+    }
+
+private:
+    std::string& out_;
+    int precision_;
+};
+
+void formatNode(Formatter& f, const TopoNode& n, bool last) {
+    f << "    {\"id\": " << n.id << ", \"x\": " << n.x << ", \"y\": " << n.y << "}" << (last ? "\n" : ",\n");
+}
+
+void formatEdge(Formatter& f, const TopoEdge& e, bool has_clearance, bool last) {
+    f << "    {\"id\": " << e.id << ", \"u\": " << e.u << ", \"v\": " << e.v << ", \"length\": " << e.length;
+    if (has_clearance) {
+        f << ", \"min_clearance\": " << e.min_clearance << ", \"mean_clearance\": " << e.mean_clearance;
+    }
+    if (e.clipped) f << ", \"clipped\": true"; // cut at an ROI border
+    f << ", \"polyline\": [";
+    for (size_t j = 0; j < e.polyline.size(); ++j) {
+        f << "[" << e.polyline[j].first << ", " << e.polyline[j].second << "]";
+        if (j + 1 < e.polyline.size()) f << ", ";
+    }
+    f << "]";
+    if (has_clearance && !e.clearance.empty()) {
+        f << ", \"clearance\": [";
+        for (size_t j = 0; j < e.clearance.size(); ++j) {
+            f << static_cast<double>(e.clearance[j]);
+            if (j + 1 < e.clearance.size()) f << ", ";
+        }
+        f << "]";
+    }
+    f << "}" << (last ? "\n" : ",\n");
+}
+
+class FdSink {
+public:
+    FdSink(int fd, size_t capacity) : fd_(fd) { buffer_.reserve(std::max<size_t>(capacity, 4096)); }
+    void append(const std::string& s) {
+        if (buffer_.size() + s.size() > buffer_.capacity()) {
+            flush();
+            if (s.size() >= buffer_.capacity()) { writeAll(s.data(), s.size()); return; }
+        }
+        buffer_.append(s);
+    }
+    void flush() {
+        writeAll(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+private:
+    int fd_;
+    std::string buffer_;
+
+    void writeAll(const char* p, size_t n) {
+        while (n > 0) {
+            const ssize_t w = ::write(fd_, p, n);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("JSON write failed: ") + std::strerror(errno));
+            }
+            p += w;
+            n -= static_cast<size_t>(w);
+        }
+    }
+};
+
+// `emit` drains `head` and then appends the chunk, if any
+template <typename Emit>
+void formatTopology(const TopologicalMap& map, const JsonWriteOptions& options, std::string& head, Emit&& emit) {
+    Formatter f(head, options.precision);
+    f << "{\n";
+    if (!map.complete) f << "  \"complete\": false,\n"; // anytime result
+    f << "  \"nodes\": [\n";
+    for (size_t i = 0; i < map.nodes.size(); ++i) {
+        formatNode(f, map.nodes[i], i + 1 == map.nodes.size());
+        if (head.size() >= (1u << 16)) emit(nullptr);
+    }
+    f << "  ],\n  \"edges\": [\n";
+    emit(nullptr);
+
+    // Edges dominate the output (per-pixel polylines): format a wave of
+    // chunks in parallel, then emit them in order
+    const size_t per_chunk = std::max<size_t>(options.edges_per_chunk, 1);
+    const size_t chunk_count = (map.edges.size() + per_chunk - 1) / per_chunk;
+    ThreadPool& pool = ThreadPool::shared();
+    const int threads = !options.parallel ? 1
+                      : options.max_threads > 0 ? std::min(options.max_threads, pool.size()) : pool.size();
+    const size_t wave = static_cast<size_t>(threads) * 4;
+    std::vector<std::string> chunks(std::min(wave, chunk_count));
+    for (size_t base = 0; base < chunk_count; base += wave) {
+        const int count = static_cast<int>(std::min(wave, chunk_count - base));
+        pool.parallelFor(0, count, threads, [&](int c0, int c1) {
+            for (int c = c0; c < c1; ++c) {
+                std::string& out = chunks[c];
+                out.clear();
+                Formatter cf(out, options.precision);
+                const size_t begin = (base + c) * per_chunk;
+                const size_t end = std::min(begin + per_chunk, map.edges.size());
+                for (size_t i = begin; i < end; ++i) {
+                    formatEdge(cf, map.edges[i], map.has_clearance, i + 1 == map.edges.size());
+                }
+            }
+        });
+        for (int c = 0; c < count; ++c) emit(&chunks[c]);
+    }
+    head.append("  ]\n}");
+    if (options.trailing_newline) head.push_back('\n');
+    emit(nullptr);
+}
+
+} // namespace
+
+void writeTopologyJson(const TopologicalMap& map, int fd, const JsonWriteOptions& options) {
+    FdSink sink(fd, options.buffer_bytes);
+    std::string head;
+    formatTopology(map, options, head, [&](const std::string* chunk) {
+        if (!head.empty()) { sink.append(head); head.clear(); }
+        if (chunk) sink.append(*chunk);
+    });
+    sink.flush();
+}
+
+void writeTopologyJson(const TopologicalMap& map, const std::string& path, const JsonWriteOptions& options) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create JSON file: " + path);
+    }
+    try {
+        writeTopologyJson(map, fd, options);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close JSON file: " + path);
+    }
+}
+
+std::string formatTopologyJson(const TopologicalMap& map, const JsonWriteOptions& options) {
+    std::string out;
+    std::string head;
+    formatTopology(map, options, head, [&](const std::string* chunk) {
+        out.append(head);
+        head.clear();
+        if (chunk) out.append(*chunk);
+    });
+    return out;
+}
+
+} // namespace gvd_topo
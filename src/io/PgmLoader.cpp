@@ -0,0 +1,199 @@
+#include "gvd_topo/io/PgmLoader.hpp"
+#include "gvd_topo/io/MappedFile.hpp"
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace gvd_topo {
+
+namespace {
+
+constexpr int kRowsPerBand = 64;
+
+// Classification as done by ROS map_server (trinary mode)
+int8_t classify(double p, const PgmThreshold& t) {
+    if (p > t.occupied_thresh) return static_cast<int8_t>(Cell::Occupied);
+    if (p < t.free_thresh) return static_cast<int8_t>(Cell::Free);
+    return static_cast<int8_t>(Cell::Unknown);
+}
+
+size_t skipSpaceAndComments(const uint8_t* data, size_t size, size_t pos) {
+    while (pos < size) {
+        if (data[pos] == '#') {
+            while (pos < size && data[pos] != '\n') ++pos;
+        } else if (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\n' || data[pos] == '\r') {
+            ++pos;
+        } else {
+            break;
+        }
+    }
+    return pos;
+}
+
+int parseHeaderInt(const uint8_t* data, size_t size, size_t& pos) {
+    pos = skipSpaceAndComments(data, size, pos);
+    if (pos >= size || data[pos] < '0' || data[pos] > '9') {
+        throw std::runtime_error("Malformed PGM header");
+    }
+    long v = 0;
+    while (pos < size && data[pos] >= '0' && data[pos] <= '9') {
+        v = v * 10 + (data[pos] - '0');
+        if (v > (1L << 30)) throw std::runtime_error("PGM dimension out of range");
+        ++pos;
+    }
+    return static_cast<int>(v);
+}
+
+} // namespace
+
+CellThresholds CellThresholds::fromMapServer(const PgmThreshold& t, int maxval) {
+    CellThresholds c;
+    c.invert = t.negate ? 0xFF : 0x00;
+    c.any_occupied = false;
+    c.any_free = false;
+    const double mv = static_cast<double>(std::max(1, maxval));
+    // p is monotonically decreasing in v' = v ^ invert, so occupied pixels
+    // form a prefix and free pixels a suffix of the 0..255 range
+    for (int vp = 0; vp <= 255; ++vp) {
+        const int v = t.negate ? 255 - vp : vp;
+        const double p = std::clamp(t.negate ? v / mv : (mv - v) / mv, 0.0, 1.0);
+        const int8_t cell = classify(p, t);
+        if (cell == static_cast<int8_t>(Cell::Occupied)) {
+            c.occupied_max = static_cast<uint8_t>(vp);
+            c.any_occupied = true;
+        } else if (cell == static_cast<int8_t>(Cell::Free) && !c.any_free) {
+            c.free_min = static_cast<uint8_t>(vp);
+            c.any_free = true;
+        }
+    }
+    return c;
+}
+
+CellThresholds CellThresholds::fromBinary(int occ_threshold) {
+    CellThresholds c;
+    c.any_occupied = occ_threshold >= 0;
+    c.occupied_max = static_cast<uint8_t>(std::clamp(occ_threshold, 0, 255));
+    c.any_free = occ_threshold < 255;
+    c.free_min = static_cast<uint8_t>(std::clamp(occ_threshold + 1, 0, 255));
+    return c;
+}
+
+void thresholdPixels(const uint8_t* src, int8_t* dst, size_t n, const CellThresholds& t) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    {
+        const __m256i inv = _mm256_set1_epi8(static_cast<char>(t.invert));
+        const __m256i omax = _mm256_set1_epi8(static_cast<char>(t.occupied_max));
+        const __m256i fmin = _mm256_set1_epi8(static_cast<char>(t.free_min));
+        const __m256i occ_en = _mm256_set1_epi8(static_cast<char>(t.any_occupied ? 0xFF : 0x00));
+        const __m256i free_en = _mm256_set1_epi8(static_cast<char>(t.any_free ? 0xFF : 0x00));
+        const __m256i occ_val = _mm256_set1_epi8(static_cast<char>(Cell::Occupied));
+        const __m256i ones = _mm256_set1_epi8(static_cast<char>(0xFF));
+        for (; i + 32 <= n; i += 32) {
+            const __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), inv);
+            const __m256i occ = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(v, omax), v), occ_en);
+            const __m256i fre = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, fmin), v), free_en);
+            // Occupied -> 100, free -> 0, neither -> -1 (0xFF)
+            const __m256i out = _mm256_or_si256(_mm256_and_si256(occ, occ_val),
+                                                _mm256_andnot_si256(_mm256_or_si256(occ, fre), ones));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128i inv = _mm_set1_epi8(static_cast<char>(t.invert));
+        const __m128i omax = _mm_set1_epi8(static_cast<char>(t.occupied_max));
+        const __m128i fmin = _mm_set1_epi8(static_cast<char>(t.free_min));
+        const __m128i occ_en = _mm_set1_epi8(static_cast<char>(t.any_occupied ? 0xFF : 0x00));
+        const __m128i free_en = _mm_set1_epi8(static_cast<char>(t.any_free ? 0xFF : 0x00));
+        const __m128i occ_val = _mm_set1_epi8(static_cast<char>(Cell::Occupied));
+        const __m128i ones = _mm_set1_epi8(static_cast<char>(0xFF));
+        for (; i + 16 <= n; i += 16) {
+            const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), inv);
+            const __m128i occ = _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(v, omax), v), occ_en);
+            const __m128i fre = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, fmin), v), free_en);
+            const __m128i out = _mm_or_si128(_mm_and_si128(occ, occ_val),
+                                             _mm_andnot_si128(_mm_or_si128(occ, fre), ones));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+        }
+    }
+#endif
+    // Scalar tail (and portable fallback); branch-free so it vectorises elsewhere
+    for (; i < n; ++i) {
+        const uint8_t v = static_cast<uint8_t>(src[i] ^ t.invert);
+        const bool occ = t.any_occupied && v <= t.occupied_max;
+        const bool fre = t.any_free && v >= t.free_min;
+        dst[i] = occ ? static_cast<int8_t>(Cell::Occupied) : (fre ? static_cast<int8_t>(Cell::Free) : static_cast<int8_t>(Cell::Unknown));
+    }
+}
+
+bool PgmLoader::isPgm(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    char magic[2] = {0, 0};
+    ifs.read(magic, 2);
+    return ifs.gcount() == 2 && magic[0] == 'P' && magic[1] == '5';
+}
+
+bool PgmLoader::isPgm(const uint8_t* data, size_t size) {
+    return size >= 2 && data[0] == 'P' && data[1] == '5';
+}
+
+PgmHeader PgmLoader::parseHeader(const uint8_t* data, size_t size, bool require_raster) {
+    if (size < 2 || data[0] != 'P' || data[1] != '5') {
+        throw std::runtime_error("Not a binary (P5) PGM image");
+    }
+    PgmHeader h;
+    size_t pos = 2;
+    h.width = parseHeaderInt(data, size, pos);
+    h.height = parseHeaderInt(data, size, pos);
+    h.maxval = parseHeaderInt(data, size, pos);
+    if (h.maxval <= 0 || h.maxval > 255) {
+        throw std::runtime_error("Only 8-bit PGM images are supported");
+    }
+    // Exactly one whitespace byte separates the header from the raster
+    if (pos >= size) throw std::runtime_error("Truncated PGM header");
+    h.data_offset = pos + 1;
+    const size_t needed = static_cast<size_t>(h.width) * static_cast<size_t>(h.height);
+    if (h.width <= 0 || h.height <= 0) {
+        throw std::runtime_error("Invalid PGM dimensions");
+    }
+    if (require_raster && size - h.data_offset < needed) {
+        throw std::runtime_error("Truncated PGM raster");
+    }
+    return h;
+}
+
+OccupancyGrid PgmLoader::fromBuffer(const uint8_t* data, size_t size, double resolution, const CellThresholds& t) {
+    const PgmHeader h = parseHeader(data, size);
+    OccupancyGrid grid(h.width, h.height, resolution);
+    const uint8_t* raster = data + h.data_offset;
+    const size_t w = static_cast<size_t>(h.width);
+    const int bands = (h.height + kRowsPerBand - 1) / kRowsPerBand;
+    ThreadPool::shared().parallelFor(0, bands, 0, [&](int b0, int b1) {
+        for (int b = b0; b < b1; ++b) {
+            const size_t y0 = static_cast<size_t>(b) * kRowsPerBand;
+            const size_t rows = std::min<size_t>(kRowsPerBand, static_cast<size_t>(h.height) - y0);
+            thresholdPixels(raster + y0 * w, grid.data.data() + y0 * w, rows * w, t);
+        }
+    });
+    return grid;
+}
+
+OccupancyGrid PgmLoader::load(const std::string& path, double resolution, const PgmThreshold& t) {
+    MappedFile file(path);
+    const PgmHeader h = parseHeader(file.data(), file.size());
+    return fromBuffer(file.data(), file.size(), resolution, CellThresholds::fromMapServer(t, h.maxval));
+}
+
+OccupancyGrid PgmLoader::load(const std::string& path, double resolution, int occ_threshold) {
+    MappedFile file(path);
+    return fromBuffer(file.data(), file.size(), resolution, CellThresholds::fromBinary(occ_threshold));
+}
+
+} // namespace gvd_topo
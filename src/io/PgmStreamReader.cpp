@@ -0,0 +1,73 @@
+#include "gvd_topo/io/PgmStreamReader.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gvd_topo {
+
+namespace {
+
+constexpr size_t kMaxHeaderBytes = 4096;
+
+bool preadFully(int fd, uint8_t* dst, size_t n, off_t offset) {
+    while (n > 0) {
+        const ssize_t got = ::pread(fd, dst, n, offset);
+        if (got <= 0) return false;
+        dst += got;
+        n -= static_cast<size_t>(got);
+        offset += got;
+    }
+    return true;
+}
+
+} // namespace
+
+PgmStreamReader::PgmStreamReader(const std::string& path, double resolution, const CellThresholds& thresholds)
+    : resolution_(resolution), thresholds_(thresholds) {
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    struct stat st {};
+    uint8_t head[kMaxHeaderBytes];
+    const ssize_t got = ::pread(fd_, head, sizeof(head), 0);
+    if (::fstat(fd_, &st) != 0 || got <= 0) {
+        ::close(fd_);
+        throw std::runtime_error("Cannot read file: " + path);
+    }
+    try {
+        header_ = PgmLoader::parseHeader(head, static_cast<size_t>(got), false);
+    } catch (...) {
+        ::close(fd_);
+        throw;
+    }
+    const size_t needed = static_cast<size_t>(header_.width) * static_cast<size_t>(header_.height);
+    if (static_cast<size_t>(st.st_size) < header_.data_offset + needed) {
+        ::close(fd_);
+        throw std::runtime_error("Truncated PGM raster: " + path);
+    }
+    ::posix_fadvise(fd_, static_cast<off_t>(header_.data_offset), static_cast<off_t>(needed), POSIX_FADV_SEQUENTIAL);
+}
+
+PgmStreamReader::~PgmStreamReader() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+int PgmStreamReader::readBand(int8_t* cells, int max_rows) {
+    const int rows = std::min(max_rows, header_.height - next_row_);
+    if (rows <= 0) return 0;
+    const size_t w = static_cast<size_t>(header_.width);
+    const size_t bytes = static_cast<size_t>(rows) * w;
+    if (raw_.size() < bytes) raw_.resize(bytes);
+    const off_t offset = static_cast<off_t>(header_.data_offset + static_cast<size_t>(next_row_) * w);
+    if (!preadFully(fd_, raw_.data(), bytes, offset)) {
+        throw std::runtime_error("Short read while streaming PGM raster");
+    }
+    thresholdPixels(raw_.data(), cells, bytes, thresholds_);
+    next_row_ += rows;
+    return rows;
+}
+
+} // namespace gvd_topo
@@ -0,0 +1,250 @@
+#include "gvd_topo/io/ResultCache.hpp"
+#include "gvd_topo/io/MappedFile.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+
+namespace gvd_topo {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char kEntryMagic[8] = {'G','V','D','C','A','C','H','E'};
+constexpr uint32_t kEntryVersion = 2; // 2: key hashes the EDT that actually ran
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+constexpr const char* kEntryExtension = ".gvdc";
+
+struct EntryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t key;
+    int32_t width;
+    int32_t height;
+    uint64_t distance_offset;  // width*height floats
+    uint64_t mask_offset;      // width*height bits, LSB first
+    uint64_t topology_offset;  // TopologyBinary image
+    uint64_t topology_size;
+    uint64_t total_size;
+};
+static_assert(std::is_trivially_copyable<EntryHeader>::value, "EntryHeader must be POD");
+static_assert(sizeof(EntryHeader) % 8 == 0, "EntryHeader must keep 8-byte alignment");
+
+inline uint64_t align8(uint64_t v) { return (v + 7u) & ~uint64_t(7); }
+
+inline uint64_t rotl(uint64_t v, int r) { return (v << r) | (v >> (64 - r)); }
+
+inline uint64_t mix(uint64_t h, uint64_t v) {
+    h ^= v * 0x9E3779B97F4A7C15ull;
+    return rotl(h, 31) * 0xBF58476D1CE4E5B9ull;
+}
+
+inline uint64_t finalize(uint64_t h) {
+    h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27; h *= 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+// Four independent lanes over 8-byte words so the multiply chains overlap;
+// grids are hashed at memory bandwidth rather than byte by byte
+uint64_t hashBytes(uint64_t seed, const void* data, size_t n) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    uint64_t lane[4] = {seed, seed + 1, seed + 2, seed + 3};
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint64_t w[4];
+        std::memcpy(w, p + i, sizeof(w));
+        for (int k = 0; k < 4; ++k) lane[k] = mix(lane[k], w[k]);
+    }
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, sizeof(w));
+        lane[0] = mix(lane[0], w);
+    }
+    uint64_t tail = 0;
+    if (n > i) std::memcpy(&tail, p + i, n - i);
+    uint64_t h = mix(seed ^ n, tail);
+    for (uint64_t l : lane) h = mix(h, l);
+    return finalize(h);
+}
+
+template <typename T>
+uint64_t hashValue(uint64_t seed, const T& v) { return hashBytes(seed, &v, sizeof(T)); }
+
+std::string hexKey(uint64_t key) {
+    static const char* digits = "0123456789abcdef";
+    std::string s(16, '0');
+    for (int i = 15; i >= 0; --i, key >>= 4) s[i] = digits[key & 0xF];
+    return s;
+}
+
+} // namespace
+
+ResultCache::ResultCache(const std::string& directory, uint64_t max_bytes)
+    : directory_(directory), max_bytes_(max_bytes) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot create cache directory: " + directory_);
+    }
+}
+
+uint64_t ResultCache::makeKey(const OccupancyGrid& grid,
+                              const GvdGenerator::Params& gvd_params,
+                              const TopologyExtractor::Params& topo_params,
+                              double topology_resolution) {
+    uint64_t h = hashValue(0x6776645F746F706Full, kEntryVersion);
+    h = hashValue(h, grid.width);
+    h = hashValue(h, grid.height);
+    h = hashValue(h, grid.resolution);
+    h = hashBytes(h, grid.data.data(), grid.data.size());
+    // stream_band_rows does not change results and is deliberately left out
+    h = hashValue(h, gvd_params.occ_threshold);
+    h = hashValue(h, gvd_params.morph_kernel);
+    // The EDT that runs, not the one requested: without OpenCV use_opencv
+    // falls back to the exact native EDT, whose results differ
+    h = hashValue(h, GvdGenerator::usesOpenCvEdt(gvd_params));
+    h = hashValue(h, topo_params.prune_min_length);
+    h = hashValue(h, topo_params.merge_radius);
+    h = hashValue(h, topo_params.resolution);
+    h = hashValue(h, topo_params.record_clearance_profile);
+    return hashValue(h, topology_resolution);
+}
+
+std::string ResultCache::entryPath(uint64_t key) const {
+    return (fs::path(directory_) / (hexKey(key) + kEntryExtension)).string();
+}
+
+bool ResultCache::load(uint64_t key, GvdResult& gvd, TopologicalMap& map) {
+    const std::string path = entryPath(key);
+    std::error_code ec;
+    if (!fs::exists(path, ec)) {
+        ++stats_.misses;
+        return false;
+    }
+    try {
+        MappedFile file(path);
+        const uint8_t* data = file.data();
+        EntryHeader h {};
+        if (file.size() < sizeof(h)) throw std::runtime_error("truncated");
+        std::memcpy(&h, data, sizeof(h));
+        const uint64_t cells = static_cast<uint64_t>(std::max(h.width, 0)) * static_cast<uint64_t>(std::max(h.height, 0));
+        if (std::memcmp(h.magic, kEntryMagic, sizeof(kEntryMagic)) != 0 || h.version != kEntryVersion ||
+            h.byte_order != kByteOrderMark || h.key != key || h.total_size != file.size() ||
+            h.distance_offset + cells * sizeof(float) > h.mask_offset ||
+            h.mask_offset + (cells + 7) / 8 > h.topology_offset ||
+            h.topology_offset + h.topology_size > h.total_size) {
+            throw std::runtime_error("corrupt entry");
+        }
+        TopologicalMap loaded = TopologyBinaryView(data + h.topology_offset, h.topology_size).toMap();
+
+        gvd.width = h.width;
+        gvd.height = h.height;
+        gvd.distance.resize(cells);
+        std::memcpy(gvd.distance.data(), data + h.distance_offset, cells * sizeof(float));
+        gvd.gvd_mask.resize(cells);
+        const uint8_t* bits = data + h.mask_offset;
+        for (uint64_t i = 0; i < cells; ++i) {
+            gvd.gvd_mask[i] = ((bits[i >> 3] >> (i & 7)) & 1u) ? 255 : 0;
+        }
+        map = std::move(loaded);
+    } catch (const std::exception&) {
+        fs::remove(path, ec);
+        ++stats_.misses;
+        return false;
+    }
+    // Recency for eviction is the file's modification time
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    ++stats_.hits;
+    return true;
+}
+
+void ResultCache::store(uint64_t key, const GvdResult& gvd, const TopologicalMap& map) {
+    const uint64_t cells = static_cast<uint64_t>(gvd.width) * static_cast<uint64_t>(gvd.height);
+    if (gvd.distance.size() != cells || gvd.gvd_mask.size() != cells) {
+        throw std::runtime_error("ResultCache: GVD result size does not match its dimensions");
+    }
+    EntryHeader h {};
+    std::memcpy(h.magic, kEntryMagic, sizeof(kEntryMagic));
+    h.version = kEntryVersion;
+    h.byte_order = kByteOrderMark;
+    h.key = key;
+    h.width = gvd.width;
+    h.height = gvd.height;
+    h.distance_offset = sizeof(EntryHeader);
+    h.mask_offset = align8(h.distance_offset + cells * sizeof(float));
+    h.topology_offset = align8(h.mask_offset + (cells + 7) / 8);
+    h.topology_size = topologyBinarySize(map);
+    h.total_size = h.topology_offset + h.topology_size;
+    if (h.total_size > max_bytes_) return; // would be evicted immediately
+
+    std::vector<uint8_t> buffer(h.total_size, 0);
+    std::memcpy(buffer.data(), &h, sizeof(h));
+    std::memcpy(buffer.data() + h.distance_offset, gvd.distance.data(), cells * sizeof(float));
+    uint8_t* bits = buffer.data() + h.mask_offset;
+    for (uint64_t i = 0; i < cells; ++i) {
+        if (gvd.gvd_mask[i]) bits[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+    }
+    serializeTopologyBinary(map, buffer.data() + h.topology_offset);
+
+    // Publish atomically so concurrent readers never see a partial entry
+    const std::string path = entryPath(key);
+    const std::string tmp = path + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            throw std::runtime_error("Failed to write cache entry: " + tmp);
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        throw std::runtime_error("Failed to publish cache entry: " + path);
+    }
+    ++stats_.stores;
+    evict(path);
+}
+
+void ResultCache::evict(const std::string& keep) {
+    struct Entry {
+        fs::path path;
+        uint64_t size;
+        fs::file_time_type time;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (const auto& de : fs::directory_iterator(directory_, ec)) {
+        if (!de.is_regular_file(ec) || de.path().extension() != kEntryExtension) continue;
+        const uint64_t size = de.file_size(ec);
+        if (ec) continue;
+        const auto time = de.last_write_time(ec);
+        if (ec) continue;
+        entries.push_back({de.path(), size, time});
+        total += size;
+    }
+    if (total <= max_bytes_) return;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    for (const auto& e : entries) {
+        if (total <= max_bytes_) break;
+        if (e.path == keep) continue;
+        if (fs::remove(e.path, ec)) {
+            total -= e.size;
+            ++stats_.evictions;
+        }
+    }
+}
+
+} // namespace gvd_topo
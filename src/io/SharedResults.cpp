@@ -0,0 +1,273 @@
+#include "gvd_topo/io/SharedResults.hpp"
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gvd_topo {
+
+namespace shared_results {
+
+constexpr char kMagic[8] = {'G','V','D','S','H','M','\0','\0'};
+constexpr uint32_t kVersion = 1;
+
+struct Control {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_count;
+    uint64_t slot_stride;   // bytes between slot headers
+    uint64_t slot_capacity; // payload bytes per slot
+    uint64_t slots_offset;
+    uint64_t segment_size;
+    alignas(64) std::atomic<uint64_t> latest; // newest complete generation
+};
+
+// Sequence: odd while the slot is written, 2 * generation once complete
+struct alignas(64) SlotHeader {
+    std::atomic<uint64_t> seq;
+    int32_t width;
+    int32_t height;
+    uint64_t mask_offset;     // payload-relative; distance starts at 0
+    uint64_t topology_offset;
+    uint64_t topology_size;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared atomics must be lock-free");
+
+} // namespace shared_results
+
+using namespace shared_results;
+
+namespace {
+
+inline uint64_t align8(uint64_t v) { return (v + 7u) & ~uint64_t(7); }
+inline uint64_t align64(uint64_t v) { return (v + 63u) & ~uint64_t(63); }
+
+inline const SlotHeader* slotAt(const uint8_t* base, const Control* c, uint64_t generation) {
+    return reinterpret_cast<const SlotHeader*>(base + c->slots_offset + (generation % c->slot_count) * c->slot_stride);
+}
+
+inline uint64_t payloadSize(uint64_t cells, size_t topology_bytes) {
+    return align8(align8(cells * sizeof(float)) + cells) + topology_bytes;
+}
+
+} // namespace
+
+SharedResultPublisher::SharedResultPublisher(const std::string& name, size_t slot_bytes, int slot_count,
+                                             bool unlink_on_close)
+    : name_(name), unlink_on_close_(unlink_on_close) {
+    if (slot_count < 2) {
+        throw std::runtime_error("SharedResultPublisher needs at least two slots");
+    }
+    // Start from a fresh segment so stale readers of an old one are not confused
+    ::shm_unlink(name_.c_str());
+    const int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create shared memory segment: " + name_);
+    }
+    const uint64_t stride = align64(sizeof(SlotHeader)) + align64(slot_bytes);
+    const uint64_t slots_offset = align64(sizeof(Control));
+    size_ = static_cast<size_t>(slots_offset + stride * static_cast<uint64_t>(slot_count));
+    if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Cannot size shared memory segment: " + name_);
+    }
+    void* p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Cannot map shared memory segment: " + name_);
+    }
+    base_ = static_cast<uint8_t*>(p);
+
+    control_ = new (base_) Control{};
+    control_->version = kVersion;
+    control_->slot_count = static_cast<uint32_t>(slot_count);
+    control_->slot_stride = stride;
+    control_->slot_capacity = align64(slot_bytes);
+    control_->slots_offset = slots_offset;
+    control_->segment_size = size_;
+    for (int i = 0; i < slot_count; ++i) {
+        new (base_ + slots_offset + static_cast<uint64_t>(i) * stride) SlotHeader{};
+    }
+    // Subscribers accept the segment once the magic is visible
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(control_->magic, kMagic, sizeof(kMagic));
+}
+
+SharedResultPublisher::~SharedResultPublisher() {
+    if (base_) ::munmap(base_, size_);
+    if (unlink_on_close_) ::shm_unlink(name_.c_str());
+}
+
+size_t SharedResultPublisher::requiredSlotBytes(const GvdResult& gvd, const TopologicalMap& map) {
+    const uint64_t cells = static_cast<uint64_t>(gvd.width) * static_cast<uint64_t>(gvd.height);
+    return static_cast<size_t>(payloadSize(cells, topologyBinarySize(map)));
+}
+
+uint64_t SharedResultPublisher::publish(const GvdResult& gvd, const TopologicalMap& map) {
+    const uint64_t cells = static_cast<uint64_t>(gvd.width) * static_cast<uint64_t>(gvd.height);
+    if (gvd.distance.size() != cells || gvd.gvd_mask.size() != cells) {
+        throw std::runtime_error("SharedResultPublisher: GVD result size does not match its dimensions");
+    }
+    const size_t topology_bytes = topologyBinarySize(map);
+    if (payloadSize(cells, topology_bytes) > control_->slot_capacity) {
+        throw std::runtime_error("SharedResultPublisher: result exceeds the slot capacity");
+    }
+
+    const uint64_t generation = control_->latest.load(std::memory_order_relaxed) + 1;
+    auto* slot = const_cast<SlotHeader*>(slotAt(base_, control_, generation));
+    uint8_t* payload = reinterpret_cast<uint8_t*>(slot) + align64(sizeof(SlotHeader));
+
+    // Seqlock write: mark busy, then order the payload stores after it
+    slot->seq.store(2 * generation - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->width = gvd.width;
+    slot->height = gvd.height;
+    slot->mask_offset = align8(cells * sizeof(float));
+    slot->topology_offset = align8(slot->mask_offset + cells);
+    slot->topology_size = topology_bytes;
+    std::memcpy(payload, gvd.distance.data(), cells * sizeof(float));
+    std::memcpy(payload + slot->mask_offset, gvd.gvd_mask.data(), cells);
+    serializeTopologyBinary(map, payload + slot->topology_offset);
+
+    slot->seq.store(2 * generation, std::memory_order_release);
+    control_->latest.store(generation, std::memory_order_release);
+    return generation;
+}
+
+SharedResultSubscriber::SharedResultSubscriber(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open shared memory segment: " + name);
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Control)) {
+        ::close(fd);
+        throw std::runtime_error("Shared memory segment is not initialised: " + name);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("Cannot map shared memory segment: " + name);
+    }
+    base_ = static_cast<const uint8_t*>(p);
+    control_ = reinterpret_cast<const Control*>(base_);
+    const bool valid = std::memcmp(control_->magic, kMagic, sizeof(kMagic)) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The layout is fixed at creation; check it once, without overflow, so
+    // begin() can trust that every slot header and payload lies in the mapping
+    const uint64_t header = align64(sizeof(SlotHeader));
+    const uint64_t stride = control_->slot_stride;
+    const uint64_t offset = control_->slots_offset;
+    const bool layout = control_->slot_count >= 2 && offset >= sizeof(Control) && offset % 64 == 0 &&
+                        offset <= size_ && stride % 64 == 0 && stride >= header &&
+                        control_->slot_capacity <= stride - header &&
+                        control_->slot_count <= (size_ - offset) / stride;
+    if (!valid || control_->version != kVersion || control_->segment_size != size_ || !layout) {
+        ::munmap(const_cast<uint8_t*>(base_), size_);
+        base_ = nullptr;
+        throw std::runtime_error("Not a GVD result segment: " + name);
+    }
+}
+
+SharedResultSubscriber::~SharedResultSubscriber() {
+    if (base_) ::munmap(const_cast<uint8_t*>(base_), size_);
+}
+
+uint64_t SharedResultSubscriber::latestGeneration() const {
+    return control_->latest.load(std::memory_order_acquire);
+}
+
+int SharedResultSubscriber::begin(SharedSnapshot& snap) const {
+    const uint64_t generation = control_->latest.load(std::memory_order_acquire);
+    if (generation == 0) return kEmpty;
+    const SlotHeader* slot = slotAt(base_, control_, generation);
+    const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+    if (seq != 2 * generation) return kRetry; // lapped by the writer
+
+    // Fields may be torn by a concurrent rewrite; bound-check before use
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(slot) + align64(sizeof(SlotHeader));
+    const int32_t width = slot->width;
+    const int32_t height = slot->height;
+    const uint64_t mask_offset = slot->mask_offset;
+    const uint64_t topology_offset = slot->topology_offset;
+    const uint64_t topology_size = slot->topology_size;
+    const uint64_t cells = static_cast<uint64_t>(width < 0 ? 0 : width) * static_cast<uint64_t>(height < 0 ? 0 : height);
+    const uint64_t capacity = control_->slot_capacity;
+    bool ok = width >= 0 && height >= 0 && cells <= capacity &&
+              mask_offset >= cells * sizeof(float) && mask_offset <= capacity && cells <= capacity - mask_offset &&
+              topology_offset >= mask_offset + cells && topology_offset % 8 == 0 && topology_offset <= capacity &&
+              topology_size <= capacity - topology_offset;
+    if (ok) {
+        try {
+            snap.topology = TopologyBinaryView(payload + topology_offset, static_cast<size_t>(topology_size));
+        } catch (const std::exception&) {
+            ok = false;
+        }
+    }
+    if (!ok) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == seq) {
+            throw std::runtime_error("Corrupt slot in GVD result segment");
+        }
+        return kRetry;
+    }
+    snap.generation = generation;
+    snap.width = width;
+    snap.height = height;
+    snap.distance = reinterpret_cast<const float*>(payload);
+    snap.gvd_mask = payload + mask_offset;
+    snap.topology_data = payload + topology_offset;
+    snap.topology_size = static_cast<size_t>(topology_size);
+    return kReady;
+}
+
+bool SharedResultSubscriber::acquire(SharedSnapshot& snap) const {
+    for (;;) {
+        const int state = begin(snap);
+        if (state == kEmpty) return false;
+        if (state == kReady) return true;
+    }
+}
+
+bool SharedResultSubscriber::validate(const SharedSnapshot& snap) const {
+    // Order every read of the snapshot before the sequence re-check
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slotAt(base_, control_, snap.generation)->seq.load(std::memory_order_relaxed) == 2 * snap.generation;
+}
+
+bool SharedResultSubscriber::copyLatest(GvdResult& gvd, TopologicalMap& map, uint64_t* generation) const {
+    // Copy raw bytes first and parse only after validation: the topology
+    // view's offsets are untrusted until the sequence check passes
+    std::vector<uint8_t> topology;
+    GvdResult copy;
+    uint64_t copied_generation = 0;
+    const bool found = read([&](const SharedSnapshot& s) {
+        const size_t cells = static_cast<size_t>(s.width) * static_cast<size_t>(s.height);
+        copy.width = s.width;
+        copy.height = s.height;
+        copy.distance.assign(s.distance, s.distance + cells);
+        copy.gvd_mask.assign(s.gvd_mask, s.gvd_mask + cells);
+        topology.assign(s.topology_data, s.topology_data + s.topology_size);
+        copied_generation = s.generation;
+    });
+    if (!found) return false;
+    // 8-byte aligned copy for the view
+    std::vector<uint64_t> aligned((topology.size() + 7) / 8);
+    std::memcpy(aligned.data(), topology.data(), topology.size());
+    map = TopologyBinaryView(reinterpret_cast<const uint8_t*>(aligned.data()), topology.size()).toMap();
+    gvd = std::move(copy);
+    if (generation) *generation = copied_generation;
+    return true;
+}
+
+} // namespace gvd_topo
@@ -0,0 +1,184 @@
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace gvd_topo {
+
+using namespace topo_binary;
+
+namespace {
+
+static_assert(std::is_trivially_copyable<Header>::value, "Header must be POD");
+static_assert(sizeof(Header) % 8 == 0, "Header must keep 8-byte alignment");
+static_assert(sizeof(Node) % 8 == 0 && sizeof(Edge) % 8 == 0 && sizeof(Point) % 8 == 0, "Records must be 8-byte multiples");
+
+inline uint64_t align8(uint64_t v) { return (v + 7u) & ~uint64_t(7); }
+
+
+Header computeLayout(const TopologicalMap& map) {
+    Header h {};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.byte_order = kByteOrderMark;
+    h.flags = map.has_clearance ? kFlagHasClearance : 0u;
+    if (!map.complete) h.flags |= kFlagIncomplete;
+    h.node_count = map.nodes.size();
+    h.edge_count = map.edges.size();
+    for (const auto& e : map.edges) {
+        h.point_count += e.polyline.size();
+        h.clearance_count += e.clearance.size();
+    }
+    h.nodes_offset = sizeof(Header);
+    h.edges_offset = align8(h.nodes_offset + h.node_count * sizeof(Node));
+    h.points_offset = align8(h.edges_offset + h.edge_count * sizeof(Edge));
+    h.clearance_offset = align8(h.points_offset + h.point_count * sizeof(Point));
+    h.total_size = align8(h.clearance_offset + h.clearance_count * sizeof(float));
+    return h;
+}
+
+// Validates that [offset, offset + count * elem) lies inside size and is aligned
+bool sectionFits(uint64_t offset, uint64_t count, uint64_t elem, uint64_t size, uint64_t alignment) {
+    if (offset % alignment != 0 || offset > size) return false;
+    if (count > (size - offset) / elem) return false;
+    return true;
+}
+
+} // namespace
+
+size_t topologyBinarySize(const TopologicalMap& map) {
+    return static_cast<size_t>(computeLayout(map).total_size);
+}
+
+void serializeTopologyBinary(const TopologicalMap& map, uint8_t* dst) {
+    const Header h = computeLayout(map);
+    std::memset(dst, 0, static_cast<size_t>(h.total_size));
+    std::memcpy(dst, &h, sizeof(h));
+
+    auto* nodes = reinterpret_cast<Node*>(dst + h.nodes_offset);
+    for (size_t i = 0; i < map.nodes.size(); ++i) {
+        nodes[i] = Node{map.nodes[i].id, 0, map.nodes[i].x, map.nodes[i].y};
+    }
+    auto* edges = reinterpret_cast<Edge*>(dst + h.edges_offset);
+    auto* points = reinterpret_cast<Point*>(dst + h.points_offset);
+    auto* clearance = reinterpret_cast<float*>(dst + h.clearance_offset);
+    uint64_t point_cursor = 0;
+    uint64_t clearance_cursor = 0;
+    for (size_t i = 0; i < map.edges.size(); ++i) {
+        const TopoEdge& e = map.edges[i];
+        Edge& out = edges[i];
+        out.id = e.id;
+        out.u = e.u;
+        out.v = e.v;
+        out.flags = e.clipped ? kEdgeClipped : 0;
+        out.length = e.length;
+        out.min_clearance = e.min_clearance;
+        out.mean_clearance = e.mean_clearance;
+        out.point_offset = point_cursor;
+        out.point_count = e.polyline.size();
+        out.clearance_offset = clearance_cursor;
+        out.clearance_count = e.clearance.size();
+        for (const auto& p : e.polyline) points[point_cursor++] = Point{p.first, p.second};
+        if (!e.clearance.empty()) {
+            std::memcpy(clearance + clearance_cursor, e.clearance.data(), e.clearance.size() * sizeof(float));
+            clearance_cursor += e.clearance.size();
+        }
+    }
+}
+
+std::vector<uint8_t> serializeTopologyBinary(const TopologicalMap& map) {
+    std::vector<uint8_t> buffer(topologyBinarySize(map));
+    serializeTopologyBinary(map, buffer.data());
+    return buffer;
+}
+
+void writeTopologyBinary(const TopologicalMap& map, const std::string& path) {
+    const std::vector<uint8_t> buffer = serializeTopologyBinary(map);
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs) {
+        throw std::runtime_error("Cannot create topology file: " + path);
+    }
+    ofs.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!ofs) {
+        throw std::runtime_error("Failed to write topology file: " + path);
+    }
+}
+
+TopologyBinaryView::TopologyBinaryView(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(Header) || reinterpret_cast<uintptr_t>(data) % alignof(double) != 0) {
+        throw std::runtime_error("Topology buffer too small or misaligned");
+    }
+    const auto* h = reinterpret_cast<const Header*>(data);
+    if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a binary topology file");
+    }
+    if (h->version < kMinVersion || h->version > kVersion) {
+        throw std::runtime_error("Unsupported topology format version " + std::to_string(h->version));
+    }
+    if (h->flags & ~kKnownFlags) {
+        throw std::runtime_error("Topology file uses unknown flags");
+    }
+    if (h->byte_order != kByteOrderMark) {
+        throw std::runtime_error("Topology file has foreign byte order");
+    }
+    if (h->total_size > size ||
+        !sectionFits(h->nodes_offset, h->node_count, sizeof(Node), h->total_size, 8) ||
+        !sectionFits(h->edges_offset, h->edge_count, sizeof(Edge), h->total_size, 8) ||
+        !sectionFits(h->points_offset, h->point_count, sizeof(Point), h->total_size, 8) ||
+        !sectionFits(h->clearance_offset, h->clearance_count, sizeof(float), h->total_size, 4)) {
+        throw std::runtime_error("Topology file sections out of bounds");
+    }
+    header_ = h;
+    nodes_ = reinterpret_cast<const Node*>(data + h->nodes_offset);
+    edges_ = reinterpret_cast<const Edge*>(data + h->edges_offset);
+    points_ = reinterpret_cast<const Point*>(data + h->points_offset);
+    clearance_ = reinterpret_cast<const float*>(data + h->clearance_offset);
+    // Per-edge ranges are checked once here so accessors can stay unchecked
+    for (uint64_t i = 0; i < h->edge_count; ++i) {
+        const Edge& e = edges_[i];
+        if (e.point_offset > h->point_count || e.point_count > h->point_count - e.point_offset ||
+            e.clearance_offset > h->clearance_count || e.clearance_count > h->clearance_count - e.clearance_offset) {
+            header_ = nullptr;
+            throw std::runtime_error("Topology edge geometry out of bounds");
+        }
+        if (e.flags & ~kKnownEdgeFlags) {
+            header_ = nullptr;
+            throw std::runtime_error("Topology edge uses unknown flags");
+        }
+    }
+}
+
+TopologicalMap TopologyBinaryView::toMap() const {
+    TopologicalMap map;
+    map.has_clearance = hasClearance();
+    map.complete = complete();
+    map.nodes.resize(nodeCount());
+    for (size_t i = 0; i < nodeCount(); ++i) {
+        map.nodes[i].id = nodes_[i].id;
+        map.nodes[i].x = nodes_[i].x;
+        map.nodes[i].y = nodes_[i].y;
+    }
+    map.edges.resize(edgeCount());
+    for (size_t i = 0; i < edgeCount(); ++i) {
+        const Edge& src = edges_[i];
+        TopoEdge& e = map.edges[i];
+        e.id = src.id;
+        e.u = src.u;
+        e.v = src.v;
+        e.clipped = (src.flags & kEdgeClipped) != 0;
+        e.length = src.length;
+        e.min_clearance = src.min_clearance;
+        e.mean_clearance = src.mean_clearance;
+        const Point* pts = edgePoints(i);
+        e.polyline.resize(src.point_count);
+        for (size_t j = 0; j < src.point_count; ++j) e.polyline[j] = {pts[j].x, pts[j].y};
+        e.clearance.assign(edgeClearance(i), edgeClearance(i) + src.clearance_count);
+    }
+    return map;
+}
+
+MappedTopology::MappedTopology(const std::string& path)
+    : file_(path), view_(file_.data(), file_.size()) {}
+
+} // namespace gvd_topo
@@ -0,0 +1,235 @@
+#include "gvd_topo/io/TopologyLoader.hpp"
+#include "gvd_topo/io/MappedFile.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gvd_topo {
+
+namespace {
+
+// Schema-aware recursive descent over the raw buffer. Keys are compared in
+// place and numbers parsed with std::from_chars, so the only allocations are
+// the output vectors themselves.
+class JsonParser {
+public:
+    JsonParser(const char* data, size_t size) : p_(data), begin_(data), end_(data + size) {
+        points_.reserve(4096);
+        values_.reserve(4096);
+    }
+
+    TopologicalMap parse() {
+        TopologicalMap map;
+        expect('{');
+        if (!consume('}')) {
+            do {
+                const std::string_view key = parseKey();
+                if (key == "nodes") parseNodes(map);
+                else if (key == "edges") parseEdges(map);
+                else if (key == "complete") map.complete = parseBool();
+                else skipValue();
+            } while (consume(','));
+            expect('}');
+        }
+        skipSpace();
+        if (p_ != end_) fail("trailing characters");
+        return map;
+    }
+
+private:
+    const char* p_;
+    const char* begin_;
+    const char* end_;
+    // Scratch buffers reused across edges, so each polyline is allocated
+    // exactly once at its final size
+    std::vector<std::pair<double,double>> points_;
+    std::vector<float> values_;
+
+    [[noreturn]] void fail(const char* what) const {
+        throw std::runtime_error(std::string("Topology JSON: ") + what + " at byte " +
+                                 std::to_string(p_ - begin_));
+    }
+
+    void skipSpace() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (p_ < end_ && *p_ == c) { ++p_; return true; }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) fail("unexpected character");
+    }
+
+    std::string_view parseString() {
+        expect('"');
+        const char* start = p_;
+        while (p_ < end_ && *p_ != '"') {
+            if (*p_ == '\\') ++p_;
+            ++p_;
+        }
+        if (p_ >= end_) fail("unterminated string");
+        return std::string_view(start, static_cast<size_t>(p_++ - start));
+    }
+
+    std::string_view parseKey() {
+        const std::string_view key = parseString();
+        expect(':');
+        return key;
+    }
+
+    double parseDouble() {
+        skipSpace();
+        double v = 0.0;
+        const auto r = std::from_chars(p_, end_, v);
+        if (r.ec != std::errc()) fail("expected number");
+        p_ = r.ptr;
+        return v;
+    }
+
+    int parseInt() {
+        skipSpace();
+        int v = 0;
+        const auto r = std::from_chars(p_, end_, v);
+        if (r.ec != std::errc()) fail("expected integer");
+        p_ = r.ptr;
+        return v;
+    }
+
+    bool parseBool() {
+        skipSpace();
+        const std::string_view rest(p_, static_cast<size_t>(end_ - p_));
+        if (rest.substr(0, 4) == "true") { p_ += 4; return true; }
+        if (rest.substr(0, 5) == "false") { p_ += 5; return false; }
+        fail("expected boolean");
+    }
+
+    void skipValue() {
+        skipSpace();
+        if (p_ >= end_) fail("unexpected end of input");
+        if (*p_ == '"') { parseString(); return; }
+        if (*p_ == '{' || *p_ == '[') {
+            int depth = 0;
+            while (p_ < end_) {
+                const char c = *p_;
+                if (c == '"') { parseString(); continue; }
+                ++p_;
+                if (c == '{' || c == '[') ++depth;
+                else if ((c == '}' || c == ']') && --depth == 0) return;
+            }
+            fail("unterminated value");
+        }
+        while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' &&
+               *p_ != ' ' && *p_ != '\n' && *p_ != '\r' && *p_ != '\t') ++p_;
+    }
+
+    void parseNodes(TopologicalMap& map) {
+        expect('[');
+        if (consume(']')) return;
+        do {
+            TopoNode n;
+            expect('{');
+            if (!consume('}')) {
+                do {
+                    const std::string_view key = parseKey();
+                    if (key == "id") n.id = parseInt();
+                    else if (key == "x") n.x = parseDouble();
+                    else if (key == "y") n.y = parseDouble();
+                    else skipValue();
+                } while (consume(','));
+                expect('}');
+            }
+            map.nodes.push_back(n);
+        } while (consume(','));
+        expect(']');
+    }
+
+    void parseEdges(TopologicalMap& map) {
+        expect('[');
+        if (consume(']')) return;
+        do {
+            map.edges.emplace_back();
+            TopoEdge& e = map.edges.back();
+            expect('{');
+            if (!consume('}')) {
+                do {
+                    const std::string_view key = parseKey();
+                    if (key == "id") e.id = parseInt();
+                    else if (key == "u") e.u = parseInt();
+                    else if (key == "v") e.v = parseInt();
+                    else if (key == "length") e.length = parseDouble();
+                    else if (key == "min_clearance") { e.min_clearance = parseDouble(); map.has_clearance = true; }
+                    else if (key == "mean_clearance") { e.mean_clearance = parseDouble(); map.has_clearance = true; }
+                    else if (key == "clipped") e.clipped = parseBool();
+                    else if (key == "polyline") parsePolyline(e);
+                    else if (key == "clearance") parseClearance(e);
+                    else skipValue();
+                } while (consume(','));
+                expect('}');
+            }
+        } while (consume(','));
+        expect(']');
+    }
+
+    void parsePolyline(TopoEdge& e) {
+        expect('[');
+        points_.clear();
+        if (!consume(']')) {
+            do {
+                expect('[');
+                const double x = parseDouble();
+                expect(',');
+                const double y = parseDouble();
+                expect(']');
+                points_.emplace_back(x, y);
+            } while (consume(','));
+            expect(']');
+        }
+        e.polyline.assign(points_.begin(), points_.end());
+    }
+
+    void parseClearance(TopoEdge& e) {
+        expect('[');
+        values_.clear();
+        if (!consume(']')) {
+            do {
+                values_.push_back(static_cast<float>(parseDouble()));
+            } while (consume(','));
+            expect(']');
+        }
+        e.clearance.assign(values_.begin(), values_.end());
+    }
+};
+
+} // namespace
+
+TopologicalMap TopologyLoader::fromJson(const char* data, size_t size) {
+    return JsonParser(data, size).parse();
+}
+
+bool TopologyLoader::isBinary(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(topo_binary::kMagic)] = {};
+    if (!file.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, topo_binary::kMagic, sizeof(magic)) == 0;
+}
+
+TopologicalMap TopologyLoader::load(const std::string& path) {
+    MappedFile file(path);
+    const uint8_t* data = file.data();
+    if (file.size() >= sizeof(topo_binary::kMagic) &&
+        std::memcmp(data, topo_binary::kMagic, sizeof(topo_binary::kMagic)) == 0) {
+        return TopologyBinaryView(data, file.size()).toMap();
+    }
+    return fromJson(reinterpret_cast<const char*>(data), file.size());
+}
+
+} // namespace gvd_topo
@@ -1,4 +1,5 @@
 #include "gvd_topo/io/YamlLoader.hpp"
+#include "gvd_topo/io/PgmLoader.hpp"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -75,8 +76,18 @@ OccupancyGrid YamlLoader::loadFromYaml(const std::string& yaml_path, int occ_thr
     std::filesystem::path yaml_dir = yaml_file_path.parent_path();
     std::filesystem::path image_path = yaml_dir / info.image_file;
     
-    // Load image using existing functionality
-    OccupancyGrid grid = OccupancyGrid::loadFromImage(image_path.string(), info.resolution, occ_threshold);
+    // PGM maps honour the YAML thresholds (trinary, as map_server does);
+    // other formats keep the single occ_threshold rule
+    OccupancyGrid grid;
+    if (PgmLoader::isPgm(image_path.string())) {
+        PgmThreshold threshold;
+        threshold.occupied_thresh = info.occupied_thresh;
+        threshold.free_thresh = info.free_thresh;
+        threshold.negate = info.negate;
+        grid = PgmLoader::load(image_path.string(), info.resolution, threshold);
+    } else {
+        grid = OccupancyGrid::loadFromImage(image_path.string(), info.resolution, occ_threshold);
+    }
     
     // Set origin from YAML
     grid.origin.x = info.origin_x;
@@ -157,6 +168,8 @@ ConfigOptions YamlLoader::loadConfigFromYaml(const std::string& config_path) {
                 config.input.resolution = std::stod(value);
             } else if (key == "occupancy_threshold") {
                 config.input.occupancy_threshold = std::stoi(value);
+            } else if (key == "streaming") {
+                config.input.streaming = (value == "true" || value == "1");
             }
         } else if (current_section == "output") {
             if (key == "map_file") {
@@ -165,6 +178,58 @@ ConfigOptions YamlLoader::loadConfigFromYaml(const std::string& config_path) {
                 config.output.gvd_image = value;
             } else if (key == "topo_image") {
                 config.output.topo_image = value;
+            } else if (key == "map_binary_file") {
+                config.output.map_binary_file = value;
+            } else if (key == "json_precision") {
+                config.output.json_precision = std::stoi(value);
+            } else if (key == "distance_file") {
+                config.output.distance_file = value;
+            } else if (key == "distance_format") {
+                config.output.distance_format = value;
+            } else if (key == "distance_quantum") {
+                config.output.distance_quantum = std::stod(value);
+            }
+        } else if (current_section == "cache") {
+            if (key == "directory") {
+                if (!value.empty() && !std::filesystem::path(value).is_absolute()) {
+                    config.cache.directory = (config_dir / value).string();
+                } else {
+                    config.cache.directory = value;
+                }
+            } else if (key == "max_mb") {
+                config.cache.max_mb = std::stod(value);
+            }
+        } else if (current_section == "batch") {
+            if (key == "input") {
+                if (!value.empty() && !std::filesystem::path(value).is_absolute()) {
+                    config.batch.input = (config_dir / value).string();
+                } else {
+                    config.batch.input = value;
+                }
+            } else if (key == "output_dir") {
+                config.batch.output_dir = value;
+            } else if (key == "jobs") {
+                config.batch.jobs = std::stoi(value);
+            } else if (key == "threads_per_map") {
+                config.batch.threads_per_map = std::stoi(value);
+            } else if (key == "prefetch") {
+                config.batch.prefetch = std::stoi(value);
+            } else if (key == "pipelined") {
+                config.batch.pipelined = (value == "true" || value == "1");
+            } else if (key == "latest_wins") {
+                config.batch.latest_wins = (value == "true" || value == "1");
+            } else if (key == "pipeline_queue") {
+                config.batch.pipeline_queue = std::stoi(value);
+            }
+        } else if (current_section == "daemon") {
+            if (key == "socket") {
+                config.daemon.socket_path = value;
+            } else if (key == "workers") {
+                config.daemon.workers = std::stoi(value);
+            } else if (key == "queue_depth") {
+                config.daemon.queue_depth = std::stoi(value);
+            } else if (key == "grid_budget_mb") {
+                config.daemon.grid_budget_mb = std::stod(value);
             }
         } else if (current_section == "benchmark") {
             if (key == "enabled") {
@@ -193,6 +258,25 @@ ConfigOptions YamlLoader::loadConfigFromYaml(const std::string& config_path) {
                 config.processing.use_parallel_processing = (value == "true" || value == "1");
             } else if (key == "max_threads") {
                 config.processing.max_threads = std::stoi(value);
+            } else if (key == "deadline_ms") {
+                config.processing.deadline_ms = std::stod(value);
+            } else if (key == "anytime") {
+                config.processing.anytime = (value == "true" || value == "1");
+            } else if (key == "progress") {
+                config.processing.progress = (value == "true" || value == "1");
+            } else if (key == "clearance_profile") {
+                config.processing.clearance_profile = (value == "true" || value == "1");
+            } else if (key == "robot_radii") {
+                // Parse array format: [0.2, 0.35]
+                value.erase(std::remove(value.begin(), value.end(), '['), value.end());
+                value.erase(std::remove(value.begin(), value.end(), ']'), value.end());
+                std::istringstream iss(value);
+                std::string token;
+                config.processing.robot_radii.clear();
+                while (std::getline(iss, token, ',')) {
+                    if (token.find_first_not_of(" \t") == std::string::npos) continue;
+                    config.processing.robot_radii.push_back(std::stod(token));
+                }
             }
         }
     }
@@ -222,7 +306,10 @@ void YamlLoader::saveConfigToYaml(const ConfigOptions& config, const std::string
     file << "  resolution: " << config.input.resolution << "\n";
     file << "  \n";
     file << "  # Occupancy threshold (equivalent to --occ-thresh)\n";
-    file << "  occupancy_threshold: " << config.input.occupancy_threshold << "\n\n";
+    file << "  occupancy_threshold: " << config.input.occupancy_threshold << "\n";
+    file << "  \n";
+    file << "  # Stream PGM input in row bands overlapped with the EDT (equivalent to --stream)\n";
+    file << "  streaming: " << (config.input.streaming ? "true" : "false") << "\n\n";
     
     // Output configuration
     file << "output:\n";
@@ -233,7 +320,66 @@ void YamlLoader::saveConfigToYaml(const ConfigOptions& config, const std::string
     file << "  gvd_image: \"" << config.output.gvd_image << "\"\n";
     file << "  \n";
     file << "  # Output topological map visualization (equivalent to --out-topo-image)\n";
-    file << "  topo_image: \"" << config.output.topo_image << "\"\n\n";
+    file << "  topo_image: \"" << config.output.topo_image << "\"\n";
+    file << "  \n";
+    file << "  # Binary topological map for zero-copy loading (equivalent to --out-map-bin)\n";
+    file << "  map_binary_file: \"" << config.output.map_binary_file << "\"\n";
+    file << "  \n";
+    file << "  # Significant digits for coordinates in the JSON map (equivalent to --json-precision)\n";
+    file << "  json_precision: " << config.output.json_precision << "\n";
+    file << "  \n";
+    file << "  # Distance field export (equivalent to --out-distance, --distance-format, --distance-quantum)\n";
+    file << "  distance_file: \"" << config.output.distance_file << "\"\n";
+    file << "  distance_format: \"" << config.output.distance_format << "\"\n";
+    file << "  distance_quantum: " << config.output.distance_quantum << "\n\n";
+
+    // Cache configuration
+    file << "cache:\n";
+    file << "  # Result cache directory; empty disables caching (equivalent to --cache-dir)\n";
+    file << "  directory: \"" << config.cache.directory << "\"\n";
+    file << "  \n";
+    file << "  # Cache size bound in megabytes, least recently used entries are evicted (equivalent to --cache-max-mb)\n";
+    file << "  max_mb: " << config.cache.max_mb << "\n\n";
+
+    // Batch configuration
+    file << "batch:\n";
+    file << "  # Directory or manifest of maps; empty disables batch mode (equivalent to --batch)\n";
+    file << "  input: \"" << config.batch.input << "\"\n";
+    file << "  \n";
+    file << "  # Per-map outputs and batch_report.json (equivalent to --batch-out-dir)\n";
+    file << "  output_dir: \"" << config.batch.output_dir << "\"\n";
+    file << "  \n";
+    file << "  # Maps in parallel, 0 = cores / threads_per_map (equivalent to --batch-jobs)\n";
+    file << "  jobs: " << config.batch.jobs << "\n";
+    file << "  \n";
+    file << "  # Threads inside each map (equivalent to --threads-per-map)\n";
+    file << "  threads_per_map: " << config.batch.threads_per_map << "\n";
+    file << "  \n";
+    file << "  # Maps read ahead while others are processed (equivalent to --batch-prefetch)\n";
+    file << "  prefetch: " << config.batch.prefetch << "\n";
+    file << "  \n";
+    file << "  # Run load, EDT+GVD, topology and output writing as pipelined stages (equivalent to --pipeline)\n";
+    file << "  pipelined: " << (config.batch.pipelined ? "true" : "false") << "\n";
+    file << "  \n";
+    file << "  # Drop queued inputs superseded by newer ones (equivalent to --latest-wins)\n";
+    file << "  latest_wins: " << (config.batch.latest_wins ? "true" : "false") << "\n";
+    file << "  \n";
+    file << "  # Maps buffered between pipeline stages (equivalent to --pipeline-queue)\n";
+    file << "  pipeline_queue: " << config.batch.pipeline_queue << "\n\n";
+
+    // Daemon configuration
+    file << "daemon:\n";
+    file << "  # Unix domain socket to serve requests on; empty disables daemon mode (equivalent to --daemon)\n";
+    file << "  socket: \"" << config.daemon.socket_path << "\"\n";
+    file << "  \n";
+    file << "  # Requests processed concurrently, 0 = auto-detect (equivalent to --daemon-workers)\n";
+    file << "  workers: " << config.daemon.workers << "\n";
+    file << "  \n";
+    file << "  # Requests allowed to wait for a worker before BUSY replies (equivalent to --daemon-queue)\n";
+    file << "  queue_depth: " << config.daemon.queue_depth << "\n";
+    file << "  \n";
+    file << "  # Memory for GRID payloads being received or processed at once, in MB (equivalent to --daemon-grid-mb)\n";
+    file << "  grid_budget_mb: " << config.daemon.grid_budget_mb << "\n\n";
     
     // Benchmark configuration
     file << "benchmark:\n";
@@ -266,6 +412,22 @@ void YamlLoader::saveConfigToYaml(const ConfigOptions& config, const std::string
     file << "  # Performance settings\n";
     file << "  use_parallel_processing: " << (config.processing.use_parallel_processing ? "true" : "false") << "\n";
     file << "  max_threads: " << config.processing.max_threads << "  # 0 = auto-detect\n";
+    file << "  \n";
+    file << "  # Time budget for EDT/GVD + topology in ms, 0 = none (equivalent to --deadline-ms)\n";
+    file << "  deadline_ms: " << config.processing.deadline_ms << "\n";
+    file << "  # Keep a coarse or partial map flagged incomplete when the budget runs out\n";
+    file << "  anytime: " << (config.processing.anytime ? "true" : "false") << "\n";
+    file << "  progress: " << (config.processing.progress ? "true" : "false") << "\n";
+    file << "  \n";
+    file << "  # Per-point clearance profile on every edge (equivalent to --clearance-profile)\n";
+    file << "  clearance_profile: " << (config.processing.clearance_profile ? "true" : "false") << "\n";
+    file << "  \n";
+    file << "  # Robot radii for clearance-filtered topologies (equivalent to --robot-radii)\n";
+    file << "  robot_radii: [";
+    for (size_t i = 0; i < config.processing.robot_radii.size(); ++i) {
+        file << (i ? ", " : "") << config.processing.robot_radii[i];
+    }
+    file << "]\n";
 }
 
 } // namespace gvd_topo
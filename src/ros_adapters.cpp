@@ -50,6 +50,8 @@ MarkerArray topologicalMapToMarkers(const TopologicalMap& map, const std::string
         marker.pose.y = (edge.polyline.empty()) ? 0.0 : edge.polyline[0].second;
         marker.scale = edge.length;
         marker.color = {0, 0, 255, 255}; // Blue for edges
+        marker.min_width = 2.0 * edge.min_clearance;
+        marker.mean_width = 2.0 * edge.mean_clearance;
         array.markers.push_back(marker);
     }
     
@@ -86,6 +88,8 @@ std::vector<Marker> edgesToMarkers(const std::vector<TopoEdge>& edges, const std
         marker.pose.y = (edge.polyline.empty()) ? 0.0 : edge.polyline[0].second;
         marker.scale = edge.length;
         marker.color = {255, 0, 0, 255}; // Red for edges
+        marker.min_width = 2.0 * edge.min_clearance;
+        marker.mean_width = 2.0 * edge.mean_clearance;
         markers.push_back(marker);
     }
     
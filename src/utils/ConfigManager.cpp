@@ -1,5 +1,6 @@
 #include "gvd_topo/utils/ConfigManager.hpp"
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 namespace gvd_topo {
@@ -27,9 +28,69 @@ bool ConfigManager::parseCommandLine(int argc, char** argv) {
         else if (arg == "--occ-thresh" && i + 1 < argc) {
             config_.input.occupancy_threshold = std::stoi(argv[++i]);
         }
+        else if (arg == "--stream") {
+            config_.input.streaming = true;
+        }
         else if (arg == "--out-map" && i + 1 < argc) {
             config_.output.map_file = argv[++i];
         }
+        else if (arg == "--out-map-bin" && i + 1 < argc) {
+            config_.output.map_binary_file = argv[++i];
+        }
+        else if (arg == "--json-precision" && i + 1 < argc) {
+            config_.output.json_precision = std::stoi(argv[++i]);
+        }
+        else if (arg == "--out-distance" && i + 1 < argc) {
+            config_.output.distance_file = argv[++i];
+        }
+        else if (arg == "--distance-format" && i + 1 < argc) {
+            config_.output.distance_format = argv[++i];
+        }
+        else if (arg == "--distance-quantum" && i + 1 < argc) {
+            config_.output.distance_quantum = std::stod(argv[++i]);
+        }
+        else if (arg == "--cache-dir" && i + 1 < argc) {
+            config_.cache.directory = argv[++i];
+        }
+        else if (arg == "--cache-max-mb" && i + 1 < argc) {
+            config_.cache.max_mb = std::stod(argv[++i]);
+        }
+        else if (arg == "--batch" && i + 1 < argc) {
+            config_.batch.input = argv[++i];
+        }
+        else if (arg == "--batch-out-dir" && i + 1 < argc) {
+            config_.batch.output_dir = argv[++i];
+        }
+        else if (arg == "--batch-jobs" && i + 1 < argc) {
+            config_.batch.jobs = std::stoi(argv[++i]);
+        }
+        else if (arg == "--threads-per-map" && i + 1 < argc) {
+            config_.batch.threads_per_map = std::stoi(argv[++i]);
+        }
+        else if (arg == "--batch-prefetch" && i + 1 < argc) {
+            config_.batch.prefetch = std::stoi(argv[++i]);
+        }
+        else if (arg == "--pipeline") {
+            config_.batch.pipelined = true;
+        }
+        else if (arg == "--latest-wins") {
+            config_.batch.latest_wins = true;
+        }
+        else if (arg == "--pipeline-queue" && i + 1 < argc) {
+            config_.batch.pipeline_queue = std::stoi(argv[++i]);
+        }
+        else if (arg == "--daemon" && i + 1 < argc) {
+            config_.daemon.socket_path = argv[++i];
+        }
+        else if (arg == "--daemon-workers" && i + 1 < argc) {
+            config_.daemon.workers = std::stoi(argv[++i]);
+        }
+        else if (arg == "--daemon-queue" && i + 1 < argc) {
+            config_.daemon.queue_depth = std::stoi(argv[++i]);
+        }
+        else if (arg == "--daemon-grid-mb" && i + 1 < argc) {
+            config_.daemon.grid_budget_mb = std::stod(argv[++i]);
+        }
         else if (arg == "--out-gvd" && i + 1 < argc) {
             config_.output.gvd_image = argv[++i];
         }
@@ -51,6 +112,41 @@ bool ConfigManager::parseCommandLine(int argc, char** argv) {
         else if (arg == "--seed" && i + 1 < argc) {
             config_.benchmark.seed = static_cast<unsigned>(std::stoul(argv[++i]));
         }
+        else if (arg == "--threads" && i + 1 < argc) {
+            config_.processing.max_threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--no-parallel") {
+            config_.processing.use_parallel_processing = false;
+        }
+        else if (arg == "--deadline-ms" && i + 1 < argc) {
+            config_.processing.deadline_ms = std::stod(argv[++i]);
+        }
+        else if (arg == "--anytime") {
+            config_.processing.anytime = true;
+        }
+        else if (arg == "--progress") {
+            config_.processing.progress = true;
+        }
+        else if (arg == "--clearance-profile") {
+            config_.processing.clearance_profile = true;
+        }
+        else if (arg == "--robot-radii" && i + 1 < argc) {
+            std::istringstream iss(argv[++i]);
+            std::string token;
+            config_.processing.robot_radii.clear();
+            while (std::getline(iss, token, ',')) {
+                config_.processing.robot_radii.push_back(std::stod(token));
+            }
+        }
+        else if (arg == "--sweep-prune" && i + 1 < argc) {
+            config_.sweep.prune_min_length = argv[++i];
+        }
+        else if (arg == "--sweep-merge" && i + 1 < argc) {
+            config_.sweep.merge_radius = argv[++i];
+        }
+        else if (arg == "--sweep-out-dir" && i + 1 < argc) {
+            config_.sweep.output_dir = argv[++i];
+        }
         else if (arg == "--help" || arg == "-h") {
             printHelp(argv[0]);
             return false; // Indicate that help was shown
@@ -94,13 +190,43 @@ void ConfigManager::printHelp(const std::string& program_name) const {
     std::cout << "  --yaml, -y <file>      Input YAML map file\n";
     std::cout << "  --resolution <val>     Resolution (meters per pixel)\n";
     std::cout << "  --occ-thresh <val>     Occupancy threshold\n";
+    std::cout << "  --stream               Stream PGM input in row bands into the EDT\n";
     std::cout << "  --out-map <file>       Output map file\n";
+    std::cout << "  --out-map-bin <file>   Output binary (memory-mappable) map file\n";
+    std::cout << "  --json-precision <n>   Significant digits in the JSON map (default 6)\n";
+    std::cout << "  --out-distance <file>  Output distance field (EDT)\n";
+    std::cout << "  --distance-format <f>  fixed16 (default), float16 or npy\n";
+    std::cout << "  --distance-quantum <m> Fixed16 step in meters (default 0.001)\n";
+    std::cout << "  --cache-dir <dir>      Reuse EDT/GVD/topology results cached in <dir>\n";
+    std::cout << "  --cache-max-mb <val>   Cache size bound in MB (default 1024)\n";
+    std::cout << "  --batch <dir|file>     Process every map in a directory or manifest\n";
+    std::cout << "  --batch-out-dir <dir>  Per-map outputs and report (default batch_output)\n";
+    std::cout << "  --batch-jobs <n>       Maps processed in parallel (default cores / threads-per-map)\n";
+    std::cout << "  --threads-per-map <n>  Threads used inside each map (default 1)\n";
+    std::cout << "  --batch-prefetch <n>   Maps read ahead of processing (default 4)\n";
+    std::cout << "  --pipeline             Batch: run load/EDT/topology/write as pipelined stages\n";
+    std::cout << "  --latest-wins          Pipeline: drop queued maps superseded by newer ones\n";
+    std::cout << "  --pipeline-queue <n>   Pipeline: maps buffered between stages (default 2)\n";
+    std::cout << "  --daemon <socket>      Serve map requests on a Unix domain socket\n";
+    std::cout << "  --daemon-workers <n>   Concurrent daemon requests (default: auto)\n";
+    std::cout << "  --daemon-queue <n>     Waiting requests before BUSY replies (default 16)\n";
+    std::cout << "  --daemon-grid-mb <val> GRID payload memory before BUSY replies (default 1024)\n";
     std::cout << "  --out-gvd <file>       Output GVD image\n";
     std::cout << "  --out-topo-image <file> Output topology image\n";
     std::cout << "  --bench-w <val>        Benchmark width\n";
     std::cout << "  --bench-h <val>        Benchmark height\n";
     std::cout << "  --bench-occ <val>      Benchmark occupancy ratio\n";
     std::cout << "  --seed <val>           Random seed\n";
+    std::cout << "  --threads <n>          Threads for the EDT/GVD and topology loops (default: all cores)\n";
+    std::cout << "  --no-parallel          Run the EDT/GVD and topology loops on one thread\n";
+    std::cout << "  --deadline-ms <ms>     Time budget for EDT/GVD + topology (default: none)\n";
+    std::cout << "  --anytime              On the deadline, write a coarse/partial map flagged incomplete\n";
+    std::cout << "  --progress             Report EDT/GVD and topology progress on stderr\n";
+    std::cout << "  --clearance-profile    Write per-point clearance for every edge\n";
+    std::cout << "  --robot-radii <list>   Comma-separated robot radii (m); one topology each\n";
+    std::cout << "  --sweep-prune <spec>   Sweep prune_min_length: list a,b,c or range start:stop:step\n";
+    std::cout << "  --sweep-merge <spec>   Sweep merge_radius: list a,b,c or range start:stop:step\n";
+    std::cout << "  --sweep-out-dir <dir>  Write one map per sweep combination\n";
     std::cout << "  --help, -h             Show this help\n";
 }
 
@@ -108,7 +234,9 @@ bool ConfigManager::isValid() const {
     // Check if at least one input source is specified
     if (config_.input.image_file.empty() && 
         config_.input.yaml_file.empty() && 
-        !config_.benchmark.enabled) {
+        !config_.benchmark.enabled &&
+        !config_.batch.enabled() &&
+        !config_.daemon.enabled()) {
         return false;
     }
     
@@ -121,6 +249,39 @@ bool ConfigManager::isValid() const {
     if (config_.input.occupancy_threshold < 0 || config_.input.occupancy_threshold > 100) {
         return false;
     }
+
+    if (config_.processing.max_threads < 0) {
+        return false;
+    }
+
+    if (config_.processing.deadline_ms < 0.0) {
+        return false;
+    }
+
+    for (double r : config_.processing.robot_radii) {
+        if (r < 0.0) {
+            return false;
+        }
+    }
+
+    if (config_.cache.max_mb <= 0.0) {
+        return false;
+    }
+
+    if (config_.daemon.workers < 0 || config_.daemon.queue_depth < 0 || !(config_.daemon.grid_budget_mb > 0.0)) {
+        return false;
+    }
+
+    if (config_.batch.jobs < 0 || config_.batch.threads_per_map < 1 || config_.batch.prefetch < 1 ||
+        config_.batch.pipeline_queue < 1) {
+        return false;
+    }
+
+    const std::string& format = config_.output.distance_format;
+    if ((format != "fixed16" && format != "float16" && format != "npy") ||
+        config_.output.distance_quantum <= 0.0) {
+        return false;
+    }
     
     return true;
 }
@@ -139,9 +300,69 @@ void ConfigManager::mergeConfigurations(const ConfigOptions& file_config) {
     if (config_.input.occupancy_threshold == 50) { // Default value
         config_.input.occupancy_threshold = file_config.input.occupancy_threshold;
     }
+    if (!config_.input.streaming) {
+        config_.input.streaming = file_config.input.streaming;
+    }
     if (config_.output.map_file.empty()) {
         config_.output.map_file = file_config.output.map_file;
     }
+    if (config_.output.map_binary_file.empty()) {
+        config_.output.map_binary_file = file_config.output.map_binary_file;
+    }
+    if (config_.output.json_precision == 6) { // Default value
+        config_.output.json_precision = file_config.output.json_precision;
+    }
+    if (config_.output.distance_file.empty()) {
+        config_.output.distance_file = file_config.output.distance_file;
+    }
+    if (config_.output.distance_format == "fixed16") { // Default value
+        config_.output.distance_format = file_config.output.distance_format;
+    }
+    if (config_.output.distance_quantum == 0.001) { // Default value
+        config_.output.distance_quantum = file_config.output.distance_quantum;
+    }
+    if (config_.cache.directory.empty()) {
+        config_.cache.directory = file_config.cache.directory;
+    }
+    if (config_.cache.max_mb == 1024.0) { // Default value
+        config_.cache.max_mb = file_config.cache.max_mb;
+    }
+    if (config_.batch.input.empty()) {
+        config_.batch.input = file_config.batch.input;
+    }
+    if (config_.batch.output_dir == "batch_output") { // Default value
+        config_.batch.output_dir = file_config.batch.output_dir;
+    }
+    if (config_.batch.jobs == 0) { // Default value
+        config_.batch.jobs = file_config.batch.jobs;
+    }
+    if (config_.batch.threads_per_map == 1) { // Default value
+        config_.batch.threads_per_map = file_config.batch.threads_per_map;
+    }
+    if (config_.batch.prefetch == 4) { // Default value
+        config_.batch.prefetch = file_config.batch.prefetch;
+    }
+    if (!config_.batch.pipelined) {
+        config_.batch.pipelined = file_config.batch.pipelined;
+    }
+    if (!config_.batch.latest_wins) {
+        config_.batch.latest_wins = file_config.batch.latest_wins;
+    }
+    if (config_.batch.pipeline_queue == 2) { // Default value
+        config_.batch.pipeline_queue = file_config.batch.pipeline_queue;
+    }
+    if (config_.daemon.socket_path.empty()) {
+        config_.daemon.socket_path = file_config.daemon.socket_path;
+    }
+    if (config_.daemon.workers == 0) { // Default value
+        config_.daemon.workers = file_config.daemon.workers;
+    }
+    if (config_.daemon.queue_depth == 16) { // Default value
+        config_.daemon.queue_depth = file_config.daemon.queue_depth;
+    }
+    if (config_.daemon.grid_budget_mb == 1024.0) { // Default value
+        config_.daemon.grid_budget_mb = file_config.daemon.grid_budget_mb;
+    }
     if (config_.output.gvd_image.empty()) {
         config_.output.gvd_image = file_config.output.gvd_image;
     }
@@ -151,7 +372,23 @@ void ConfigManager::mergeConfigurations(const ConfigOptions& file_config) {
     if (!config_.benchmark.enabled) {
         config_.benchmark = file_config.benchmark;
     }
+    const auto cli_processing = config_.processing;
     config_.processing = file_config.processing;
+    config_.processing.clearance_profile = cli_processing.clearance_profile || file_config.processing.clearance_profile;
+    if (!cli_processing.robot_radii.empty()) {
+        config_.processing.robot_radii = cli_processing.robot_radii;
+    }
+    if (cli_processing.max_threads != 0) { // Default value
+        config_.processing.max_threads = cli_processing.max_threads;
+    }
+    if (!cli_processing.use_parallel_processing) {
+        config_.processing.use_parallel_processing = false;
+    }
+    if (cli_processing.deadline_ms > 0.0) {
+        config_.processing.deadline_ms = cli_processing.deadline_ms;
+    }
+    config_.processing.anytime = cli_processing.anytime || file_config.processing.anytime;
+    config_.processing.progress = cli_processing.progress || file_config.processing.progress;
 }
 
 } // namespace gvd_topo
@@ -0,0 +1,171 @@
+#include "gvd_topo/utils/TaskGraph.hpp"
+#include "gvd_topo/utils/Timer.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+namespace gvd_topo {
+
+// Scheduling state of one run(). Pool helpers hold it by shared_ptr and only
+// touch the graph's nodes after popping one from `ready`, which can only
+// happen while run() is still waiting for that node to settle.
+struct TaskGraph::RunState : std::enable_shared_from_this<RunState> {
+    std::vector<Node>* nodes {nullptr};
+    std::vector<NodeTiming>* timings {nullptr};
+    ThreadPool* pool {nullptr};
+    int max_runners {1};
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<size_t> unmet;   // dependencies not yet finished
+    std::vector<bool> poisoned;  // a dependency failed or was skipped
+    std::deque<NodeId> ready;
+    size_t settled {0};
+    int runners {1};             // the caller plus queued or running helpers
+    bool caller_waiting {false};
+    std::exception_ptr error;
+    Timer clock;
+
+    // Marks id finished (or skipped) and releases its dependents. Locked.
+    void settle(NodeId id, bool failed) {
+        ++settled;
+        for (NodeId d : (*nodes)[id].dependents) {
+            if (failed) poisoned[d] = true;
+            if (--unmet[d] > 0) continue;
+            if (poisoned[d]) {
+                (*timings)[d].ran = false;
+                settle(d, true);
+            } else {
+                ready.push_back(d);
+            }
+        }
+    }
+
+    // Enough helpers for the ready nodes nobody is about to pick up: the
+    // calling runner takes one itself, a waiting caller another. Locked.
+    void spawnHelpers() {
+        const size_t idle = caller_waiting ? 2 : 1;
+        size_t wanted = ready.size() > idle ? ready.size() - idle : 0;
+        while (wanted-- > 0 && runners < max_runners) {
+            ++runners;
+            std::shared_ptr<RunState> self = shared_from_this();
+            pool->submit([self]() { self->drain(false); });
+        }
+    }
+
+    // Runs ready nodes until none are left; the caller also waits for nodes
+    // still running elsewhere, since they may release more
+    void drain(bool caller) {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            if (ready.empty()) {
+                if (!caller) break;
+                if (settled == nodes->size()) return;
+                caller_waiting = true;
+                changed.wait(lock, [this]() { return !ready.empty() || settled == nodes->size(); });
+                caller_waiting = false;
+                continue;
+            }
+            const NodeId id = ready.front();
+            ready.pop_front();
+            lock.unlock();
+
+            NodeTiming& timing = (*timings)[id];
+            timing.start_ms = clock.ms();
+            bool failed = false;
+            try {
+                (*nodes)[id].fn();
+            } catch (...) {
+                failed = true;
+                std::lock_guard<std::mutex> guard(mutex);
+                if (!error) error = std::current_exception();
+            }
+            timing.end_ms = clock.ms();
+            timing.ran = true;
+
+            lock.lock();
+            settle(id, failed);
+            spawnHelpers();
+            changed.notify_all();
+        }
+        --runners;
+    }
+};
+
+TaskGraph::TaskGraph(ThreadPool& pool) : pool_(pool) {}
+
+TaskGraph::NodeId TaskGraph::add(std::string name, std::function<void()> fn, std::vector<NodeId> deps) {
+    const NodeId id = nodes_.size();
+    for (NodeId d : deps) {
+        if (d >= id) throw std::runtime_error("TaskGraph: node '" + name + "' depends on a later node");
+    }
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    for (NodeId d : deps) nodes_[d].dependents.push_back(id);
+    Node node;
+    node.fn = std::move(fn);
+    node.deps = std::move(deps);
+    nodes_.push_back(std::move(node));
+    NodeTiming timing;
+    timing.name = std::move(name);
+    timings_.push_back(std::move(timing));
+    return id;
+}
+
+void TaskGraph::run(int max_threads) {
+    for (auto& t : timings_) {
+        t.start_ms = t.end_ms = 0.0;
+        t.ran = false;
+    }
+    wall_ms_ = 0.0;
+    if (nodes_.empty()) return;
+
+    auto s = std::make_shared<RunState>();
+    s->nodes = &nodes_;
+    s->timings = &timings_;
+    s->pool = &pool_;
+    s->max_runners = max_threads > 0 ? std::min(max_threads, pool_.size()) : pool_.size();
+    s->max_runners = std::max(1, s->max_runners);
+    s->unmet.resize(nodes_.size());
+    s->poisoned.assign(nodes_.size(), false);
+    for (NodeId i = 0; i < nodes_.size(); ++i) {
+        s->unmet[i] = nodes_[i].deps.size();
+        if (s->unmet[i] == 0) s->ready.push_back(i);
+    }
+    {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        s->spawnHelpers();
+    }
+    s->drain(true);
+    wall_ms_ = s->clock.ms();
+    if (s->error) std::rethrow_exception(s->error);
+}
+
+std::vector<TaskGraph::NodeId> TaskGraph::criticalPath() const {
+    // Ids are a topological order, so one forward pass finds the longest chain
+    const size_t n = nodes_.size();
+    std::vector<double> finish(n, 0.0);
+    std::vector<NodeId> via(n, n);
+    NodeId last = n;
+    for (NodeId i = 0; i < n; ++i) {
+        if (!timings_[i].ran) continue;
+        double before = 0.0;
+        for (NodeId d : nodes_[i].deps) {
+            if (timings_[d].ran && finish[d] > before) {
+                before = finish[d];
+                via[i] = d;
+            }
+        }
+        finish[i] = before + timings_[i].ms();
+        if (last == n || finish[i] > finish[last]) last = i;
+    }
+    std::vector<NodeId> path;
+    for (NodeId i = last; i != n; i = via[i]) path.push_back(i);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+} // namespace gvd_topo
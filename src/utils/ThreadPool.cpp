@@ -0,0 +1,173 @@
+#include "gvd_topo/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace gvd_topo {
+
+namespace {
+
+// Worker identity of the current thread, so submissions from inside a task
+// land on that worker's own deque
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local int tls_worker = -1;
+
+// Shared by the caller and helpers of one parallelFor
+struct ForState {
+    const std::function<void(int, int)>* body {nullptr};
+    int begin {0};
+    int end {0};
+    int grain {1};
+    int chunks {0};
+    std::atomic<int> next {0};
+    std::atomic<int> done {0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+
+    // Claims chunks until none are left. body is only touched for a claimed
+    // chunk, i.e. while the caller is still waiting for it.
+    void work() {
+        for (;;) {
+            const int c = next.fetch_add(1);
+            if (c >= chunks) return;
+            const int lo = begin + c * grain;
+            const int hi = std::min(end, lo + grain);
+            try {
+                (*body)(lo, hi);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+            if (done.fetch_add(1) + 1 == chunks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    queues_.reserve(static_cast<size_t>(threads));
+    for (int i = 0; i < threads; ++i) queues_.push_back(std::make_unique<WorkerQueue>());
+    workers_.reserve(static_cast<size_t>(threads));
+    for (int i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    if (tls_pool == this) {
+        WorkerQueue& own = *queues_[static_cast<size_t>(tls_worker)];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        injected_.push_back(std::move(task));
+    }
+    // Counted after the push, and published under mutex_ so a worker cannot
+    // miss it between checking queued_ and going to sleep
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_;
+    }
+    cv_.notify_one();
+}
+
+bool ThreadPool::tryPop(int self, std::function<void()>& task) {
+    {
+        WorkerQueue& own = *queues_[static_cast<size_t>(self)];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!injected_.empty()) {
+            task = std::move(injected_.front());
+            injected_.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+    const int n = static_cast<int>(queues_.size());
+    for (int k = 1; k < n; ++k) {
+        WorkerQueue& victim = *queues_[static_cast<size_t>((self + k) % n)];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int self) {
+    tls_pool = this;
+    tls_worker = self;
+    for (;;) {
+        std::function<void()> task;
+        if (tryPop(self, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stopping_ || queued_ > 0; });
+        if (stopping_ && queued_ == 0) return; // stopping and drained
+    }
+}
+
+void ThreadPool::parallelFor(int begin, int end, int max_threads,
+                             const std::function<void(int, int)>& body, int grain) {
+    if (end <= begin) return;
+    const int n = end - begin;
+    const int threads = max_threads > 0 ? std::min(max_threads, size()) : size();
+    // A few chunks per thread so faster threads pick up the slack
+    grain = std::max({1, grain, (n + threads * 4 - 1) / (threads * 4)});
+    const int chunks = (n + grain - 1) / grain;
+    if (threads <= 1 || chunks <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    auto state = std::make_shared<ForState>();
+    state->body = &body;
+    state->begin = begin;
+    state->end = end;
+    state->grain = grain;
+    state->chunks = chunks;
+    const int helpers = std::min(threads, chunks) - 1;
+    for (int i = 0; i < helpers; ++i) {
+        enqueue([state]() { state->work(); });
+    }
+    state->work();
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&state]() { return state->done == state->chunks; });
+    }
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+} // namespace gvd_topo
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/io/DistanceField.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+constexpr double kFixedMax = 65535.0;
+constexpr double kHalfMax = 65504.0;
+
+std::string tempPath(const char* ext) {
+    return "test_distance_field_" + std::to_string(::getpid()) + ext;
+}
+
+// A real EDT with a few cells past the fixed16 and float16 ranges, with an
+// odd width so vector kernels hit their scalar tails
+GvdResult makeField() {
+    const OccupancyGrid grid = OccupancyGrid::randomMap(301, 203, 0.05, 0.02, 7);
+    GvdResult gvd = GvdGenerator().run(grid);
+    gvd.distance[1] = 70.0f;        // past fixed16 at 1 mm
+    gvd.distance[2] = 1.0e5f;       // past both
+    gvd.distance[3] = 1.0e-6f;      // float16 subnormal
+    gvd.distance[4] = 65.535f;      // fixed16 top step
+    return gvd;
+}
+
+// Writes, maps back and checks the decoded field against the source and the
+// writer's own report
+bool roundTrip(const GvdResult& gvd, DistanceFormat format, double quantum) {
+    DistanceExportOptions options;
+    options.format = format;
+    options.quantum = quantum;
+    const std::string path = tempPath(".gvdd");
+    const DistanceExportReport report = writeDistanceField(gvd, path, options);
+
+    bool ok = true;
+    double max_error = 0.0;
+    size_t saturated = 0;
+    {
+        const MappedDistanceField field(path);
+        const std::vector<float> decoded = field.toVector();
+        ok = field.width() == gvd.width && field.height() == gvd.height && field.format() == format &&
+             decoded.size() == gvd.distance.size();
+        const double limit = format == DistanceFormat::Fixed16 ? kFixedMax * quantum : kHalfMax;
+        for (size_t i = 0; ok && i < decoded.size(); ++i) {
+            const double v = gvd.distance[i];
+            if (format == DistanceFormat::Npy) {
+                ok = decoded[i] == gvd.distance[i];
+            } else if (v > limit) {
+                // Saturated cells clamp to the largest value, never wrap
+                ++saturated;
+                ok = format == DistanceFormat::Fixed16 ? decoded[i] >= limit - report.error_bound
+                                                       : std::isinf(decoded[i]) || decoded[i] >= kHalfMax;
+            } else {
+                const double err = std::fabs(decoded[i] - v);
+                max_error = std::max(max_error, err);
+                ok = err <= report.error_bound;
+            }
+            // at() scales in double for fixed16: allow the last float bit
+            ok = ok && (field.at(i) == decoded[i] ||
+                        std::fabs(field.at(i) - decoded[i]) <= std::fabs(decoded[i]) * 1e-6);
+        }
+        // Partial decodes match the full one
+        std::vector<float> part(333);
+        field.decode(1001, part.size(), part.data());
+        ok = ok && std::equal(part.begin(), part.end(), decoded.begin() + 1001);
+        ok = ok && report.saturated == saturated && std::fabs(report.max_error - max_error) < 1e-12;
+        const std::streamoff size = std::ifstream(path, std::ios::binary | std::ios::ate).tellg();
+        ok = ok && static_cast<size_t>(size) == report.bytes;
+    }
+    std::remove(path.c_str());
+
+    std::cout << distanceFormatName(format);
+    if (format == DistanceFormat::Fixed16) std::cout << " (quantum " << quantum << " m)";
+    std::cout << ": max error " << max_error << " m, bound " << report.error_bound << " m, " << saturated
+              << " saturated: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// The kernels alone, against the stated bounds over a wide value range
+bool kernels() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(0.0f, 60.0f);
+    std::vector<float> src(4099);
+    for (auto& v : src) v = dist(rng);
+    src[0] = 0.0f;
+    src[1] = 0.5f;
+    src[2] = 2048.0f;
+
+    std::vector<uint16_t> encoded(src.size());
+    std::vector<float> decoded(src.size());
+    bool ok = true;
+    for (double quantum : {0.001, 0.01, 0.0005}) {
+        quantizeFixed16(src.data(), encoded.data(), src.size(), quantum);
+        dequantizeFixed16(encoded.data(), decoded.data(), src.size(), quantum);
+        const double bound = 0.5 * quantum + kFixedMax * quantum * 1.1920929e-7;
+        for (size_t i = 0; i < src.size(); ++i) {
+            if (src[i] > kFixedMax * quantum) continue;
+            ok = ok && std::fabs(decoded[i] - src[i]) <= bound;
+        }
+    }
+    floatToHalf(src.data(), encoded.data(), src.size());
+    halfToFloat(encoded.data(), decoded.data(), src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+        ok = ok && std::fabs(decoded[i] - src[i]) <= std::max(std::ldexp(src[i], -11), std::ldexp(1.0f, -25));
+    }
+    // Values a half represents exactly come back unchanged
+    ok = ok && decoded[0] == 0.0f && decoded[1] == 0.5f && decoded[2] == 2048.0f;
+    std::cout << "Conversion kernels within bounds: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+bool rejectsBadInput(const GvdResult& gvd) {
+    bool ok = true;
+    auto throws = [](auto&& f) {
+        try {
+            f();
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    DistanceExportOptions zero;
+    zero.quantum = 0.0;
+    const std::string path = tempPath(".gvdd");
+    ok = ok && throws([&]() { writeDistanceField(gvd, path, zero); });
+    ok = ok && throws([&]() { parseDistanceFormat("float64"); });
+
+    // Truncated files of each kind fail to open
+    for (DistanceFormat format : {DistanceFormat::Fixed16, DistanceFormat::Npy}) {
+        DistanceExportOptions options;
+        options.format = format;
+        writeDistanceField(gvd, path, options);
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() / 2);
+        ok = ok && throws([&]() { MappedDistanceField field(path); });
+    }
+    std::remove(path.c_str());
+    std::cout << "Invalid quantum, format and truncated files rejected: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing distance field export..." << std::endl;
+    const GvdResult gvd = makeField();
+    bool ok = roundTrip(gvd, DistanceFormat::Npy, 0.0);
+    ok = roundTrip(gvd, DistanceFormat::Fixed16, 0.001) && ok;
+    ok = roundTrip(gvd, DistanceFormat::Fixed16, 0.01) && ok;
+    ok = roundTrip(gvd, DistanceFormat::Float16, 0.0) && ok;
+    ok = kernels() && ok;
+    ok = rejectsBadInput(gvd) && ok;
+    if (!ok) return 1;
+    std::cout << "Distance field test completed successfully!" << std::endl;
+    return 0;
+}
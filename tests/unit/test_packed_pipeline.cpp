@@ -0,0 +1,63 @@
+#include <iostream>
+#include <string>
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/PackedGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+// Staggered blocks in a walled area: a connected skeleton with many edges
+OccupancyGrid corridors(int width, int height) {
+    OccupancyGrid grid(width, height, 0.05);
+    for (int y = 0; y < grid.height; ++y) {
+        for (int x = 0; x < grid.width; ++x) {
+            const bool wall = x == 0 || y == 0 || x == grid.width - 1 || y == grid.height - 1;
+            const int by = (y + (x / 60) * 17) % 50;
+            const bool block = x % 60 >= 25 && x % 60 < 45 && by >= 20 && by < 35;
+            grid.data[grid.index(x, y)] = (wall || block) ? 100 : 0;
+        }
+    }
+    return grid;
+}
+
+// runPacked + the PackedMask extraction against run + the byte extraction:
+// same distances, same skeleton, same topology
+bool compare(const OccupancyGrid& grid, const char* name) {
+    GvdGenerator::Params gvd_params;
+    gvd_params.use_opencv = false; // runPacked is native-only
+    const GvdGenerator generator(gvd_params);
+    TopologyExtractor::Params topo_params;
+    topo_params.record_clearance_profile = true;
+    const TopologyExtractor extractor(topo_params);
+
+    const GvdResult bytes = generator.run(grid);
+    const PackedGvdResult packed = generator.runPacked(PackedOccupancy::fromGrid(grid));
+
+    const bool field = packed.width == bytes.width && packed.height == bytes.height &&
+                       packed.distance == bytes.distance;
+    const bool mask = packed.gvd_mask.toBytes() == bytes.gvd_mask;
+    const TopologicalMap from_bytes = extractor.run(bytes, grid.resolution);
+    const TopologicalMap from_bits = extractor.run(packed, grid.resolution);
+    const bool topology = !from_bytes.edges.empty() && from_bits.has_clearance == from_bytes.has_clearance &&
+                          from_bits.complete == from_bytes.complete && toJson(from_bits) == toJson(from_bytes);
+    std::cout << name << " (" << from_bytes.nodes.size() << " nodes, " << from_bytes.edges.size()
+              << " edges): distance " << (field ? "OK" : "FAIL") << ", mask " << (mask ? "OK" : "FAIL")
+              << ", topology " << (topology ? "OK" : "FAIL") << std::endl;
+    return field && mask && topology;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing packed pipeline against the byte pipeline..." << std::endl;
+    // Widths off a multiple of 64 leave partial words at every row end
+    bool ok = compare(corridors(240, 180), "corridors");
+    ok = compare(corridors(301, 150), "corridors, odd width") && ok;
+    ok = compare(OccupancyGrid::randomMap(203, 177, 0.05, 0.03, 5), "random 3%") && ok;
+    if (!ok) return 1;
+    std::cout << "Packed pipeline test completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/ResultCache.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+namespace fs = std::filesystem;
+
+constexpr uint64_t kUnbounded = uint64_t(1) << 40;
+
+OccupancyGrid corridors(int seed_shift) {
+    OccupancyGrid grid(240, 180, 0.05);
+    for (int y = 0; y < grid.height; ++y) {
+        for (int x = 0; x < grid.width; ++x) {
+            const bool wall = x == 0 || y == 0 || x == grid.width - 1 || y == grid.height - 1;
+            const int by = (y + (x / 60) * (17 + seed_shift)) % 50;
+            const bool block = x % 60 >= 25 && x % 60 < 45 && by >= 20 && by < 35;
+            grid.data[grid.index(x, y)] = (wall || block) ? 100 : 0;
+        }
+    }
+    return grid;
+}
+
+bool sameGvd(const GvdResult& a, const GvdResult& b) {
+    return a.width == b.width && a.height == b.height && a.distance == b.distance && a.gvd_mask == b.gvd_mask;
+}
+
+bool sameTopology(const TopologicalMap& a, const TopologicalMap& b) {
+    return a.has_clearance == b.has_clearance && a.complete == b.complete && toJson(a) == toJson(b);
+}
+
+// A hit returns exactly what the miss computed, in this cache and in a
+// second one opened on the same directory
+bool hitMatchesMiss(const std::string& dir) {
+    const OccupancyGrid grid = corridors(0);
+    const GvdGenerator generator;
+    TopologyExtractor::Params topo_params;
+    topo_params.record_clearance_profile = true;
+    const TopologyExtractor extractor(topo_params);
+    const uint64_t key = ResultCache::makeKey(grid, generator.params(), topo_params, grid.resolution);
+
+    ResultCache cache(dir, kUnbounded);
+    GvdResult gvd;
+    TopologicalMap map;
+    bool ok = !cache.load(key, gvd, map) && cache.stats().misses == 1;
+    gvd = generator.run(grid);
+    map = extractor.run(gvd, grid.resolution);
+    cache.store(key, gvd, map);
+    ok = ok && cache.stats().stores == 1 && fs::exists(cache.entryPath(key));
+
+    GvdResult cached_gvd;
+    TopologicalMap cached_map;
+    ok = ok && cache.load(key, cached_gvd, cached_map) && cache.stats().hits == 1;
+    ok = ok && sameGvd(cached_gvd, gvd) && sameTopology(cached_map, map);
+
+    ResultCache other(dir, kUnbounded);
+    GvdResult other_gvd;
+    TopologicalMap other_map;
+    ok = ok && other.load(key, other_gvd, other_map) && sameGvd(other_gvd, gvd) && sameTopology(other_map, map);
+    std::cout << "Hit equals miss (" << map.edges.size() << " edges): " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Inputs that change the output change the key; inputs that do not, do not
+bool keying() {
+    const OccupancyGrid grid = corridors(0);
+    const GvdGenerator::Params gvd_params;
+    const TopologyExtractor::Params topo_params;
+    const uint64_t base = ResultCache::makeKey(grid, gvd_params, topo_params, grid.resolution);
+
+    OccupancyGrid changed = grid;
+    changed.data[changed.index(120, 90)] = changed.data[changed.index(120, 90)] ? 0 : 100;
+    TopologyExtractor::Params pruned = topo_params;
+    pruned.prune_min_length += 0.1;
+    GvdGenerator::Params banded = gvd_params;
+    banded.stream_band_rows = 7;
+    bool ok = ResultCache::makeKey(changed, gvd_params, topo_params, grid.resolution) != base &&
+              ResultCache::makeKey(grid, gvd_params, pruned, grid.resolution) != base &&
+              ResultCache::makeKey(grid, gvd_params, topo_params, 2 * grid.resolution) != base &&
+              ResultCache::makeKey(grid, banded, topo_params, grid.resolution) == base;
+
+    // The key follows the EDT that actually runs: asking for OpenCV in a
+    // build without it gives the native result, and must share its key
+    GvdGenerator::Params native = gvd_params;
+    native.use_opencv = false;
+    GvdGenerator::Params opencv = gvd_params;
+    opencv.use_opencv = true;
+    const bool same_edt = GvdGenerator::usesOpenCvEdt(native) == GvdGenerator::usesOpenCvEdt(opencv);
+    const bool same_key = ResultCache::makeKey(grid, native, topo_params, grid.resolution) ==
+                          ResultCache::makeKey(grid, opencv, topo_params, grid.resolution);
+    ok = ok && same_key == same_edt;
+    if (same_key) {
+        // Whatever a shared key serves must be what either request computes
+        ok = ok && sameGvd(GvdGenerator(native).run(grid), GvdGenerator(opencv).run(grid));
+    }
+    std::cout << "Keys follow output-relevant inputs (OpenCV EDT "
+              << (GvdGenerator::usesOpenCvEdt(opencv) ? "available" : "unavailable") << "): "
+              << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Corrupt entries are misses and are removed; the size bound evicts the
+// least recently used entries first
+bool corruptionAndEviction(const std::string& dir) {
+    const GvdGenerator generator;
+    const TopologyExtractor::Params topo_params;
+    const TopologyExtractor extractor(topo_params);
+    uint64_t keys[4];
+    GvdResult gvds[4];
+    TopologicalMap maps[4];
+    for (int i = 0; i < 4; ++i) {
+        const OccupancyGrid grid = corridors(i + 1);
+        keys[i] = ResultCache::makeKey(grid, generator.params(), topo_params, grid.resolution);
+        gvds[i] = generator.run(grid);
+        maps[i] = extractor.run(gvds[i], grid.resolution);
+    }
+
+    ResultCache writer(dir, kUnbounded);
+    writer.store(keys[0], gvds[0], maps[0]);
+    const std::string path = writer.entryPath(keys[0]);
+    const uint64_t entry_bytes = fs::file_size(path);
+    {
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(static_cast<std::streamoff>(entry_bytes / 2));
+        f.write("garbage!", 8);
+        f.seekp(0);
+        f.write("XXXX", 4);
+    }
+    GvdResult gvd;
+    TopologicalMap map;
+    bool ok = !writer.load(keys[0], gvd, map) && !fs::exists(path);
+
+    // Room for two entries: storing a third evicts the oldest one
+    ResultCache bounded(dir, 2 * entry_bytes + entry_bytes / 2);
+    bounded.store(keys[1], gvds[1], maps[1]);
+    bounded.store(keys[2], gvds[2], maps[2]);
+    fs::last_write_time(bounded.entryPath(keys[1]), fs::file_time_type::clock::now() - std::chrono::hours(1));
+    bounded.store(keys[3], gvds[3], maps[3]);
+    ok = ok && bounded.stats().evictions == 1 && !fs::exists(bounded.entryPath(keys[1])) &&
+         bounded.load(keys[2], gvd, map) && sameGvd(gvd, gvds[2]) &&
+         bounded.load(keys[3], gvd, map) && sameTopology(map, maps[3]);
+    std::cout << "Corrupt entry dropped, LRU eviction: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing result cache..." << std::endl;
+    const fs::path root = fs::temp_directory_path() / ("gvd_topo_cache_test_" + std::to_string(::getpid()));
+    fs::remove_all(root);
+    bool ok = hitMatchesMiss((root / "a").string());
+    ok = keying() && ok;
+    ok = corruptionAndEviction((root / "b").string()) && ok;
+    fs::remove_all(root);
+    if (!ok) return 1;
+    std::cout << "Result cache test completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "gvd_topo/core/ClearanceFilter.hpp"
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+// The ROI GVD against the whole-map GVD over the same cells
+bool sameField(const GvdResult& whole, const GvdResult& part, const Roi& box) {
+    if (part.offset_x != box.x0 || part.offset_y != box.y0 ||
+        part.width != box.width() || part.height != box.height()) {
+        return false;
+    }
+    for (int y = 0; y < part.height; ++y) {
+        for (int x = 0; x < part.width; ++x) {
+            const size_t w = static_cast<size_t>(box.y0 + y) * whole.width + (box.x0 + x);
+            const size_t p = static_cast<size_t>(y) * part.width + x;
+            if (whole.distance[w] != part.distance[p] || whole.gvd_mask[w] != part.gvd_mask[p]) return false;
+        }
+    }
+    return true;
+}
+
+// Node positions are map cells times resolution: back to cells
+bool insideBox(const Roi& box, double x, double y, double res, int margin) {
+    const long cx = std::lround(x / res), cy = std::lround(y / res);
+    return cx >= box.x0 + margin && cy >= box.y0 + margin && cx < box.x1 - margin && cy < box.y1 - margin;
+}
+
+bool onBorder(const Roi& box, double x, double y, double res) {
+    const long cx = std::lround(x / res), cy = std::lround(y / res);
+    return cx == box.x0 || cy == box.y0 || cx == box.x1 - 1 || cy == box.y1 - 1;
+}
+
+// Edges of the whole-map topology lying well inside the ROI, by endpoint
+// positions and length, must all be found in the ROI topology
+bool interiorEdgesKept(const TopologicalMap& whole, const TopologicalMap& part, const Roi& box, double res) {
+    constexpr int kMargin = 4;
+    auto nodeAt = [](const TopologicalMap& m, int id) -> const TopoNode* {
+        for (const auto& n : m.nodes) if (n.id == id) return &n;
+        return nullptr;
+    };
+    size_t checked = 0;
+    for (const auto& e : whole.edges) {
+        const TopoNode* u = nodeAt(whole, e.u);
+        const TopoNode* v = nodeAt(whole, e.v);
+        if (!u || !v || !insideBox(box, u->x, u->y, res, kMargin) || !insideBox(box, v->x, v->y, res, kMargin)) continue;
+        bool interior = true;
+        for (const auto& p : e.polyline) interior = interior && insideBox(box, p.first, p.second, res, kMargin);
+        if (!interior) continue;
+        ++checked;
+        bool found = false;
+        for (const auto& f : part.edges) {
+            const TopoNode* a = nodeAt(part, f.u);
+            const TopoNode* b = nodeAt(part, f.v);
+            if (!a || !b || std::abs(f.length - e.length) > 1e-9) continue;
+            const bool forward = a->x == u->x && a->y == u->y && b->x == v->x && b->y == v->y;
+            const bool backward = a->x == v->x && a->y == v->y && b->x == u->x && b->y == u->y;
+            if (forward || backward) { found = true; break; }
+        }
+        if (!found) return false;
+    }
+    return checked > 0;
+}
+
+bool compareRoi(const OccupancyGrid& grid, const Roi& roi, const char* name) {
+    GvdGenerator::Params params;
+    params.use_opencv = false; // ROI runs are native-only
+    const GvdGenerator generator(params);
+    const TopologyExtractor extractor;
+    const double res = grid.resolution;
+    const Roi box = roi.clippedTo(grid.width, grid.height);
+
+    const GvdResult whole = generator.run(grid);
+    const GvdResult part = generator.run(grid, roi);
+    const bool field = sameField(whole, part, box);
+
+    // Tracing the ROI GVD and tracing the whole GVD restricted to the ROI
+    // see the same skeleton at the same map positions
+    const TopologicalMap from_part = extractor.run(part, res);
+    const bool topology = toJson(from_part) == toJson(extractor.run(whole, res, roi));
+    const bool interior = interiorEdgesKept(extractor.run(whole, res), from_part, box, res);
+
+    // Clipped edges, and only they, end on the ROI border
+    size_t clipped = 0;
+    bool flags = true;
+    for (const auto& e : from_part.edges) {
+        bool touches = false;
+        for (const auto& p : e.polyline) touches = touches || onBorder(box, p.first, p.second, res);
+        flags = flags && e.clipped == touches;
+        clipped += e.clipped ? 1 : 0;
+    }
+    flags = flags && clipped > 0;
+
+    // Per-radius maps of an ROI run are placed in the map like the plain one
+    const auto radii = extractForRadii(part, {0.0, 0.1}, extractor, res);
+    bool radius_ok = radii.size() == 2 && toJson(radii[0].map) == toJson(from_part);
+    for (const auto& n : radii[1].map.nodes) radius_ok = radius_ok && insideBox(box, n.x, n.y, res, 0);
+
+    std::cout << name << ": field " << (field ? "OK" : "FAIL") << ", topology " << (topology ? "OK" : "FAIL")
+              << ", interior edges " << (interior ? "OK" : "FAIL") << ", clipped " << clipped << " "
+              << (flags ? "OK" : "FAIL") << ", radii " << (radius_ok ? "OK" : "FAIL") << std::endl;
+    return field && topology && interior && flags && radius_ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing region-of-interest processing..." << std::endl;
+    // Staggered blocks inside a walled area: corridors give a connected
+    // skeleton that ROI borders cut through
+    OccupancyGrid grid(400, 300, 0.05);
+    for (int y = 0; y < grid.height; ++y) {
+        for (int x = 0; x < grid.width; ++x) {
+            const bool wall = x == 0 || y == 0 || x == grid.width - 1 || y == grid.height - 1;
+            const int by = (y + (x / 60) * 17) % 50;
+            const bool block = x % 60 >= 25 && x % 60 < 45 && by >= 20 && by < 35;
+            grid.data[grid.index(x, y)] = (wall || block) ? 100 : 0;
+        }
+    }
+    bool ok = compareRoi(grid, Roi{150, 100, 290, 220}, "inner ROI");
+    ok = compareRoi(grid, Roi{-20, 180, 120, 340}, "ROI past the corner") && ok;
+    if (!ok) return 1;
+    std::cout << "ROI test completed successfully!" << std::endl;
+    return 0;
+}
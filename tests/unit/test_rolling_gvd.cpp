@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/RollingGvd.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+constexpr int kMoves = 100;
+
+// Moves a window kMoves times at random and compares it every tenth move with
+// a fresh RollingGvd at the same pose and with TopologyExtractor::run on the
+// window's gvd()
+bool rollAgainstFresh(const OccupancyGrid& map, int max_step, uint32_t seed, const char* name) {
+    RollingGvd::Params params;
+    params.window_width = 200;
+    params.window_height = 160;
+    params.max_distance = 1.0;
+    RollingGvd rolling(map, params);
+    TopologyExtractor::Params topo_params;
+    topo_params.prune_min_length = params.prune_min_length;
+    topo_params.merge_radius = params.merge_radius;
+    const TopologyExtractor extractor(topo_params);
+    std::mt19937 rng(seed);
+    int cx = map.width / 2;
+    int cy = map.height / 2;
+    rolling.moveToCell(cx, cy);
+
+    bool ok = true;
+    size_t edges = 0;
+    for (int i = 1; i <= kMoves && ok; ++i) {
+        cx = std::clamp(cx + static_cast<int>(rng() % (2 * max_step + 1)) - max_step, 0, map.width);
+        cy = std::clamp(cy + static_cast<int>(rng() % (2 * max_step + 1)) - max_step, 0, map.height);
+        rolling.moveToCell(cx, cy);
+        if (i % 10 != 0) continue;
+        RollingGvd fresh(map, params);
+        fresh.moveToCell(cx, cy);
+        const GvdResult a = rolling.gvd();
+        const GvdResult b = fresh.gvd();
+        const TopologicalMap topo = rolling.topology();
+        ok = a.distance == b.distance && a.gvd_mask == b.gvd_mask &&
+             a.offset_x == rolling.originX() && a.offset_y == rolling.originY() &&
+             b.offset_x == a.offset_x && b.offset_y == a.offset_y &&
+             toJson(topo) == toJson(fresh.topology()) && toJson(topo) == toJson(extractor.run(a, map.resolution));
+        if (!ok) std::cout << name << ": mismatch after move " << i << std::endl;
+        edges = topo.edges.size();
+    }
+    std::cout << name << ": " << kMoves << " moves, " << edges << " edges, "
+              << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing rolling GVD against fresh builds..." << std::endl;
+    const OccupancyGrid map = OccupancyGrid::randomMap(600, 400, 0.05, 0.03, 3);
+    bool ok = rollAgainstFresh(map, 10, 1, "random 3%, small steps");
+    ok = rollAgainstFresh(map, 60, 2, "random 3%, large steps") && ok;
+    ok = rollAgainstFresh(OccupancyGrid::randomMap(600, 400, 0.05, 0.1, 4), 3, 3, "random 10%, creeping") && ok;
+    if (!ok) return 1;
+    std::cout << "Rolling GVD test completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "gvd_topo/io/SharedResults.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+constexpr int kReaders = 4;
+constexpr uint64_t kPublications = 3000;
+
+// Every value in generation g is derived from g, so a snapshot mixing two
+// generations (a torn read) is detectable
+GvdResult makeResult(uint64_t g) {
+    GvdResult r;
+    r.width = kWidth;
+    r.height = kHeight;
+    r.distance.assign(static_cast<size_t>(kWidth * kHeight), static_cast<float>(g));
+    r.gvd_mask.resize(static_cast<size_t>(kWidth * kHeight));
+    for (size_t i = 0; i < r.gvd_mask.size(); ++i) r.gvd_mask[i] = ((i + g) % 3 == 0) ? 255 : 0;
+    return r;
+}
+
+TopologicalMap makeMap(uint64_t g) {
+    TopologicalMap m;
+    const int nodes = 2 + static_cast<int>(g % 17);
+    for (int i = 0; i < nodes; ++i) {
+        TopoNode n; n.id = i; n.x = static_cast<double>(g); n.y = i;
+        m.nodes.push_back(n);
+    }
+    for (int i = 0; i + 1 < nodes; ++i) {
+        TopoEdge e; e.id = i; e.u = i; e.v = i + 1; e.length = static_cast<double>(g);
+        e.polyline.assign(1 + (g + i) % 5, {static_cast<double>(g), static_cast<double>(i)});
+        m.edges.push_back(e);
+    }
+    return m;
+}
+
+bool gridMatches(int width, int height, const float* distance, const uint8_t* mask, uint64_t g) {
+    if (width != kWidth || height != kHeight) return false;
+    for (size_t i = 0; i < static_cast<size_t>(kWidth * kHeight); ++i) {
+        if (distance[i] != static_cast<float>(g)) return false;
+        if (mask[i] != (((i + g) % 3 == 0) ? 255 : 0)) return false;
+    }
+    return true;
+}
+
+bool mapMatches(const TopologicalMap& m, uint64_t g) {
+    return toJson(m) == toJson(makeMap(g));
+}
+
+// Runs in a forked child; returns the process exit code
+int runReader(const std::string& name) {
+    SharedResultSubscriber sub(name);
+    uint64_t last = 0;
+    size_t reads = 0;
+    size_t failures = 0;
+    while (last < kPublications) {
+        // Zero-copy path: check in place, trust the verdict only if validated
+        bool intact = false;
+        uint64_t seen = 0;
+        const bool found = sub.read([&](const SharedSnapshot& s) {
+            seen = s.generation;
+            intact = gridMatches(s.width, s.height, s.distance, s.gvd_mask, s.generation) &&
+                     s.topology.nodeCount() == makeMap(s.generation).nodes.size();
+        });
+        if (found) {
+            if (!intact || seen < last) ++failures;
+            last = seen;
+            ++reads;
+        }
+
+        // Owning copy path
+        GvdResult gvd;
+        TopologicalMap map;
+        uint64_t g = 0;
+        if (sub.copyLatest(gvd, map, &g)) {
+            if (!gridMatches(gvd.width, gvd.height, gvd.distance.data(), gvd.gvd_mask.data(), g) ||
+                !mapMatches(map, g) || g < last) {
+                ++failures;
+            }
+            last = g;
+            ++reads;
+        }
+    }
+    std::cout << "reader " << ::getpid() << ": " << reads << " snapshots, " << failures << " inconsistent" << std::endl;
+    return failures == 0 && reads > 0 ? 0 : 1;
+}
+
+// A segment whose slot header stride or capacity does not fit its mapping
+// must be refused when subscribing, not read past the end later
+bool rejectsBadLayout(const std::string& name) {
+    // Control layout: magic[8], version, slot_count, slot_stride, slot_capacity, ...
+    constexpr size_t kStrideOffset = 16;
+    constexpr size_t kCapacityOffset = 24;
+    bool ok = true;
+    for (size_t field : {kStrideOffset, kCapacityOffset}) {
+        SharedResultPublisher publisher(name, 4096);
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+        struct stat st {};
+        ::fstat(fd, &st);
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        uint64_t& value = *reinterpret_cast<uint64_t*>(static_cast<uint8_t*>(p) + field);
+        // Stride one header short of the payload, or capacity past the stride
+        value = field == kStrideOffset ? value - 64 : value + 64;
+        ::munmap(p, static_cast<size_t>(st.st_size));
+        bool thrown = false;
+        try {
+            SharedResultSubscriber sub(name);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ok = ok && thrown;
+    }
+    std::cout << "Bad slot layout rejected: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing shared-memory result publication..." << std::endl;
+    const std::string name = "/gvd_topo_test_" + std::to_string(::getpid());
+
+    size_t slot_bytes = 0;
+    for (uint64_t g = 0; g < 85; ++g) { // sizes repeat with period lcm(17, 5)
+        slot_bytes = std::max(slot_bytes, SharedResultPublisher::requiredSlotBytes(makeResult(g), makeMap(g)));
+    }
+    SharedResultPublisher publisher(name, slot_bytes);
+    publisher.publish(makeResult(1), makeMap(1));
+
+    std::vector<pid_t> readers;
+    for (int i = 0; i < kReaders; ++i) {
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            int code = 1;
+            try {
+                code = runReader(name);
+            } catch (const std::exception& e) {
+                std::cerr << "reader failed: " << e.what() << std::endl;
+            }
+            std::cout.flush();
+            ::_exit(code); // skip destructors: the segment belongs to the parent
+        }
+        readers.push_back(pid);
+    }
+
+    bool ok = true;
+    for (uint64_t g = 2; g <= kPublications; ++g) {
+        if (publisher.publish(makeResult(g), makeMap(g)) != g) {
+            std::cout << "Generation numbering: FAIL" << std::endl;
+            ok = false;
+        }
+    }
+
+    for (pid_t pid : readers) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    // A late subscriber sees the final generation
+    GvdResult gvd;
+    TopologicalMap map;
+    uint64_t g = 0;
+    SharedResultSubscriber late(name);
+    const bool late_ok = late.copyLatest(gvd, map, &g) && g == kPublications && mapMatches(map, g);
+    std::cout << "Late subscriber: " << (late_ok ? "OK" : "FAIL") << std::endl;
+    std::cout << "Concurrent readers: " << (ok ? "OK" : "FAIL") << std::endl;
+    const bool layout_ok = rejectsBadLayout(name + "_layout");
+
+    if (!ok || !late_ok || !layout_ok) return 1;
+    std::cout << "Shared-memory test completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gvd_topo/core/ResultHolder.hpp"
+#include "gvd_topo/utils/SnapshotHolder.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+constexpr int kReaders = 8;
+constexpr uint64_t kPublications = 20000;
+constexpr size_t kPayload = 256;
+constexpr uint64_t kPoison = 0xdeaddeaddeaddeadull;
+
+std::atomic<long> g_live {0};
+
+// Payload derived from its generation, poisoned on destruction, so a torn or
+// freed snapshot seen by a reader is detectable
+struct Tracked {
+    uint64_t generation {0};
+    std::vector<uint64_t> payload;
+
+    explicit Tracked(uint64_t g) : generation(g), payload(kPayload) {
+        for (size_t i = 0; i < kPayload; ++i) payload[i] = g * 31 + i;
+        ++g_live;
+    }
+    Tracked(Tracked&& other) noexcept : generation(other.generation), payload(std::move(other.payload)) {
+        ++g_live;
+    }
+    ~Tracked() {
+        for (auto& v : payload) v = kPoison;
+        generation = kPoison;
+        --g_live;
+    }
+
+    bool intact() const {
+        if (payload.size() != kPayload) return false;
+        for (size_t i = 0; i < kPayload; ++i) {
+            if (payload[i] != generation * 31 + i) return false;
+        }
+        return true;
+    }
+};
+
+bool stressTracked() {
+    bool ok = true;
+    {
+        SnapshotHolder<Tracked> holder(kReaders + 1);
+        std::atomic<bool> done {false};
+        std::atomic<size_t> failures {0};
+        std::atomic<size_t> reads {0};
+        std::atomic<int> started_readers {0}; // readers that have seen a snapshot
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < kReaders; ++t) {
+            readers.emplace_back([&, t]() {
+                auto reader = holder.reader();
+                uint64_t last = 0;
+                size_t local = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto snap = reader.pin();
+                    if (!snap) continue;
+                    if (local == 0) ++started_readers;
+                    if (!snap->intact() || snap->generation != snap.generation() || snap.generation() < last) {
+                        ++failures;
+                    }
+                    last = snap.generation();
+                    if (local % 64 == static_cast<size_t>(t)) {
+                        // Nested pin: sees the same or a newer snapshot, while
+                        // the outer one must stay intact
+                        auto inner = reader.pin();
+                        if (!inner || inner.generation() < last || !inner->intact()) ++failures;
+                        if (!snap->intact()) ++failures;
+                    }
+                    ++local;
+                }
+                reads += local;
+            });
+        }
+
+        // One reader keeps a snapshot pinned until the writer has published
+        // kPublications / 4 more: a writer waiting for readers would time out.
+        // The writer holds back the last quarter until the pin is in place.
+        bool progressed = false;
+        std::atomic<bool> pinned {false};
+        std::thread sticky([&]() {
+            auto reader = holder.reader();
+            while (holder.generation() < kPublications / 4) std::this_thread::yield();
+            auto snap = reader.pin();
+            pinned = true;
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+            while (!progressed && std::chrono::steady_clock::now() < deadline) {
+                progressed = holder.generation() >= snap.generation() + kPublications / 4;
+                std::this_thread::yield();
+            }
+            if (!snap->intact()) ++failures;
+        });
+
+        for (uint64_t g = 1; g <= kPublications; ++g) {
+            if (g == kPublications - kPublications / 4 + 1) {
+                while (!pinned) std::this_thread::yield();
+            }
+            if (holder.publish(Tracked(g)) != g) ++failures;
+        }
+        // Let every reader see at least one snapshot before stopping them
+        const auto read_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (started_readers < kReaders && std::chrono::steady_clock::now() < read_deadline) {
+            std::this_thread::yield();
+        }
+        done = true;
+        for (auto& t : readers) t.join();
+        sticky.join();
+
+        holder.reclaim();
+        const bool drained = holder.pendingReclaim() == 0 && g_live.load() == 1;
+        std::cout << "Readers: " << kReaders << ", reads=" << reads.load() << ", failures=" << failures.load()
+                  << std::endl;
+        const bool all_read = started_readers.load() == kReaders;
+        std::cout << "Every reader saw snapshots: " << (all_read ? "OK" : "FAIL") << std::endl;
+        std::cout << "Writer not blocked by a pinned reader: " << (progressed ? "OK" : "FAIL") << std::endl;
+        std::cout << "Retired snapshots reclaimed: " << (drained ? "OK" : "FAIL") << std::endl;
+        ok = failures.load() == 0 && all_read && progressed && drained;
+    }
+    const bool released = g_live.load() == 0;
+    std::cout << "Holder releases the current snapshot: " << (released ? "OK" : "FAIL") << std::endl;
+    return ok && released;
+}
+
+bool readerSlots() {
+    SnapshotHolder<int> holder(2);
+    auto a = holder.reader();
+    bool ok = true;
+    {
+        auto b = holder.reader();
+        try {
+            holder.reader();
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+        if (b.pin()) ok = false; // nothing published yet
+    }
+    auto c = holder.reader(); // b's slot is free again
+    holder.publish(7);
+    ok = ok && *c.pin() == 7 && a.pin().generation() == 1;
+    std::cout << "Reader slot claiming: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+ResultSnapshot makeResult(uint64_t g) {
+    ResultSnapshot s;
+    s.gvd.width = 32;
+    s.gvd.height = 24;
+    s.gvd.distance.assign(32 * 24, static_cast<float>(g));
+    s.gvd.gvd_mask.assign(32 * 24, static_cast<uint8_t>(g % 251));
+    const int nodes = 2 + static_cast<int>(g % 13);
+    for (int i = 0; i < nodes; ++i) {
+        TopoNode n; n.id = i; n.x = static_cast<double>(g); n.y = i;
+        s.map.nodes.push_back(n);
+    }
+    return s;
+}
+
+bool resultMatches(const ResultSnapshot& s, uint64_t g) {
+    if (s.gvd.distance.size() != 32 * 24 || s.map.nodes.size() != 2 + g % 13) return false;
+    for (float d : s.gvd.distance) {
+        if (d != static_cast<float>(g)) return false;
+    }
+    for (uint8_t m : s.gvd.gvd_mask) {
+        if (m != g % 251) return false;
+    }
+    for (const auto& n : s.map.nodes) {
+        if (n.x != static_cast<double>(g)) return false;
+    }
+    return true;
+}
+
+bool stressResults() {
+    ResultHolder holder;
+    std::atomic<bool> done {false};
+    std::atomic<size_t> failures {0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < kReaders; ++t) {
+        readers.emplace_back([&]() {
+            auto reader = holder.reader();
+            while (!done.load(std::memory_order_relaxed)) {
+                auto snap = reader.pin();
+                if (snap && !resultMatches(*snap, snap.generation())) ++failures;
+            }
+        });
+    }
+    for (uint64_t g = 1; g <= kPublications / 10; ++g) holder.publish(makeResult(g));
+    done = true;
+    for (auto& t : readers) t.join();
+    const bool ok = failures.load() == 0;
+    std::cout << "ResultHolder snapshots: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing snapshot holder..." << std::endl;
+    const bool slots_ok = readerSlots();
+    const bool tracked_ok = stressTracked();
+    const bool results_ok = stressResults();
+    if (!slots_ok || !tracked_ok || !results_ok) return 1;
+    std::cout << "Snapshot holder test completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/PgmLoader.hpp"
+#include "gvd_topo/io/PgmStreamReader.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+constexpr int kOccThreshold = 50;
+
+// Binary P5 image of grid: occupied cells black, everything else white
+void writePgm(const OccupancyGrid& grid, const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    out << "P5\n" << grid.width << " " << grid.height << "\n255\n";
+    for (int y = 0; y < grid.height; ++y) {
+        for (int x = 0; x < grid.width; ++x) {
+            out.put(grid.data[grid.index(x, y)] == static_cast<int8_t>(Cell::Occupied) ? '\0' : '\xfe');
+        }
+    }
+}
+
+// --stream against the whole-grid path on the same (native) EDT: same
+// cells, same distance field and skeleton, same topology
+bool compare(const OccupancyGrid& source, const std::string& path, const char* name) {
+    writePgm(source, path);
+    GvdGenerator::Params params;
+    params.use_opencv = false;
+    const GvdGenerator generator(params);
+    const TopologyExtractor extractor;
+
+    const OccupancyGrid grid = OccupancyGrid::loadFromImage(path, source.resolution, kOccThreshold);
+    const GvdResult whole = generator.run(grid);
+
+    PgmStreamReader reader(path, source.resolution, CellThresholds::fromBinary(kOccThreshold));
+    OccupancyGrid streamed_grid;
+    const GvdResult streamed = generator.runStreaming(reader, &streamed_grid);
+
+    const bool cells = streamed_grid.data == grid.data;
+    const bool field = streamed.width == whole.width && streamed.height == whole.height &&
+                       streamed.distance == whole.distance && streamed.gvd_mask == whole.gvd_mask;
+    const bool topology = toJson(extractor.run(streamed, grid.resolution)) == toJson(extractor.run(whole, grid.resolution));
+    std::cout << name << ": cells " << (cells ? "OK" : "FAIL") << ", distance/skeleton " << (field ? "OK" : "FAIL")
+              << ", topology " << (topology ? "OK" : "FAIL") << std::endl;
+    std::remove(path.c_str());
+    return cells && field && topology;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing streaming against whole-grid GVD..." << std::endl;
+    const std::string path = "/tmp/gvd_topo_test_stream_" + std::to_string(::getpid()) + ".pgm";
+
+    // Band boundaries fall inside the map, and the sparse map leaves long
+    // obstacle-free columns
+    GvdGenerator::Params band_params;
+    const int rows = band_params.stream_band_rows * 2 + 37;
+    bool ok = compare(OccupancyGrid::randomMap(300, rows, 0.05, 0.08, 7), path, "random 8%");
+    ok = compare(OccupancyGrid::randomMap(211, rows, 0.05, 0.002, 11), path, "random 0.2%") && ok;
+    OccupancyGrid rooms(180, 140, 0.05);
+    for (int x = 0; x < rooms.width; ++x) {
+        rooms.data[rooms.index(x, 0)] = rooms.data[rooms.index(x, rooms.height - 1)] = 100;
+        if (x % 60 != 30) rooms.data[rooms.index(x, 70)] = 100;
+    }
+    for (int y = 0; y < rooms.height; ++y) {
+        rooms.data[rooms.index(0, y)] = rooms.data[rooms.index(rooms.width - 1, y)] = 100;
+    }
+    ok = compare(rooms, path, "rooms") && ok;
+
+    if (!ok) return 1;
+    std::cout << "Streaming test completed successfully!" << std::endl;
+    return 0;
+}
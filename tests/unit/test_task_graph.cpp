@@ -0,0 +1,148 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gvd_topo/utils/TaskGraph.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+void sleepMs(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+// A node never starts before its dependencies have ended, whatever the
+// thread budget; checked both from the nodes' own log and from timings()
+bool ordering(ThreadPool& pool, int max_threads) {
+    // Diamond with a tail: a -> {b, c} -> d -> e, plus an independent f
+    TaskGraph graph(pool);
+    std::mutex mutex;
+    std::vector<std::string> log;
+    auto step = [&](const char* name, int ms) {
+        return [&, name, ms]() {
+            sleepMs(ms);
+            std::lock_guard<std::mutex> lock(mutex);
+            log.push_back(name);
+        };
+    };
+    const auto a = graph.add("a", step("a", 5));
+    const auto b = graph.add("b", step("b", 10), {a});
+    const auto c = graph.add("c", step("c", 2), {a});
+    const auto d = graph.add("d", step("d", 2), {b, c, b});
+    graph.add("e", step("e", 1), {d});
+    graph.add("f", step("f", 3));
+    graph.run(max_threads);
+
+    auto pos = [&](const std::string& name) {
+        for (size_t i = 0; i < log.size(); ++i) if (log[i] == name) return static_cast<int>(i);
+        return -1;
+    };
+    bool ok = log.size() == 6 && pos("f") >= 0 && pos("a") < pos("b") && pos("a") < pos("c") &&
+              pos("b") < pos("d") && pos("c") < pos("d") && pos("d") < pos("e");
+    const auto& t = graph.timings();
+    for (const auto& n : t) ok = ok && n.ran && n.end_ms >= n.start_ms;
+    ok = ok && t[b].start_ms >= t[a].end_ms && t[c].start_ms >= t[a].end_ms &&
+         t[d].start_ms >= t[b].end_ms && t[d].start_ms >= t[c].end_ms && t[4].start_ms >= t[d].end_ms &&
+         graph.wallMs() >= t[4].end_ms;
+    std::cout << "Dependency order, max_threads=" << max_threads << ": " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// The longest dependency chain by node time, not the one with most nodes
+bool criticalPath(ThreadPool& pool) {
+    TaskGraph graph(pool);
+    const auto root = graph.add("root", []() { sleepMs(5); });
+    const auto s1 = graph.add("short-1", []() { sleepMs(2); }, {root});
+    const auto s2 = graph.add("short-2", []() { sleepMs(2); }, {s1});
+    const auto s3 = graph.add("short-3", []() { sleepMs(2); }, {s2});
+    const auto slow = graph.add("slow", []() { sleepMs(60); }, {root});
+    const auto join = graph.add("join", []() { sleepMs(1); }, {s3, slow});
+    graph.run();
+    const std::vector<TaskGraph::NodeId> path = graph.criticalPath();
+    const std::vector<TaskGraph::NodeId> expected {root, slow, join};
+    // Independent branches overlap, so the wall time stays near the chain
+    double chain = 0.0;
+    for (auto id : path) chain += graph.timings()[id].ms();
+    const bool ok = path == expected && graph.wallMs() >= chain - 1e-6;
+    std::cout << "Critical path root -> slow -> join: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// A throwing node skips its dependents only, and run() rethrows at the end
+bool failure(ThreadPool& pool) {
+    TaskGraph graph(pool);
+    std::atomic<int> ran {0};
+    const auto bad = graph.add("bad", []() { throw std::runtime_error("node failed"); });
+    const auto child = graph.add("child", [&]() { ++ran; }, {bad});
+    graph.add("grandchild", [&]() { ++ran; }, {child});
+    const auto other = graph.add("other", [&]() { sleepMs(5); ++ran; });
+    bool thrown = false;
+    try {
+        graph.run();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    const auto& t = graph.timings();
+    const bool ok = thrown && ran == 1 && t[bad].ran && !t[child].ran && !t[2].ran && t[other].ran &&
+                    graph.criticalPath() == std::vector<TaskGraph::NodeId>{other};
+    std::cout << "Failed node skips dependents: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Nodes that use the pool themselves, as the CLI's topology nodes do
+bool nestedParallelFor(ThreadPool& pool) {
+    TaskGraph graph(pool);
+    std::vector<std::atomic<int>> sums(8);
+    std::vector<TaskGraph::NodeId> parts;
+    for (int i = 0; i < 8; ++i) {
+        parts.push_back(graph.add("part", [&, i]() {
+            pool.parallelFor(0, 1000, 0, [&](int lo, int hi) {
+                for (int k = lo; k < hi; ++k) sums[i] += k;
+            });
+        }));
+    }
+    std::atomic<int> total {0};
+    graph.add("sum", [&]() { for (const auto& s : sums) total += s; }, parts);
+    graph.run();
+    const bool ok = total == 8 * (1000 * 999 / 2);
+    std::cout << "Nodes running parallelFor: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing task graph..." << std::endl;
+    // A deadlock shows up as a hang; fail instead
+    std::thread([]() {
+        std::this_thread::sleep_for(std::chrono::seconds(60));
+        std::cout << "Timed out (deadlock?)" << std::endl;
+        std::_Exit(1);
+    }).detach();
+
+    ThreadPool pool(4);
+    ThreadPool single(1);
+    bool ok = ordering(pool, 0);
+    ok = ordering(pool, 1) && ok;
+    ok = ordering(single, 0) && ok;
+    ok = criticalPath(pool) && ok;
+    ok = failure(pool) && ok;
+    ok = nestedParallelFor(pool) && ok;
+    ok = nestedParallelFor(single) && ok;
+
+    bool rejected = false;
+    try {
+        TaskGraph graph(pool);
+        graph.add("forward", []() {}, {3});
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    std::cout << "Forward dependency rejected: " << (rejected ? "OK" : "FAIL") << std::endl;
+    if (!ok || !rejected) return 1;
+    std::cout << "Task graph test completed successfully!" << std::endl;
+    return 0;
+}
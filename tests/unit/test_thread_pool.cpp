@@ -0,0 +1,116 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gvd_topo/utils/ThreadPool.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+// Every index of [begin, end) visited exactly once
+bool coverage(ThreadPool& pool) {
+    bool ok = true;
+    for (int max_threads : {0, 1, 3}) {
+        for (int grain : {1, 7, 1000}) {
+            std::vector<std::atomic<int>> hits(1013);
+            pool.parallelFor(5, 1013, max_threads, [&](int lo, int hi) {
+                for (int i = lo; i < hi; ++i) ++hits[i];
+            }, grain);
+            for (int i = 0; i < 1013; ++i) ok = ok && hits[i] == (i >= 5 ? 1 : 0);
+        }
+    }
+    std::cout << "Chunks cover the range once: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Threads inside body never exceed max_threads, the caller included
+bool honoursMaxThreads(ThreadPool& pool) {
+    std::atomic<int> active {0};
+    std::atomic<int> peak {0};
+    pool.parallelFor(0, 64, 2, [&](int, int) {
+        const int now = ++active;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        --active;
+    });
+    const bool ok = peak.load() >= 1 && peak.load() <= 2;
+    std::cout << "max_threads=2 peak concurrency " << peak.load() << ": " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// parallelFor inside parallelFor, and inside tasks filling every worker, as
+// the engines do when batch jobs, radii or sweeps run on the pool
+bool nested(ThreadPool& pool, const char* name) {
+    constexpr int kOuter = 16;
+    constexpr int kInner = 200;
+    std::vector<std::atomic<int>> sums(kOuter);
+    pool.parallelFor(0, kOuter, 0, [&](int o0, int o1) {
+        for (int o = o0; o < o1; ++o) {
+            pool.parallelFor(0, kInner, 0, [&](int i0, int i1) {
+                for (int i = i0; i < i1; ++i) sums[o] += i;
+            });
+        }
+    });
+    std::vector<std::future<int>> tasks;
+    for (int t = 0; t < pool.size() * 3; ++t) {
+        tasks.push_back(pool.submit([&pool]() {
+            std::atomic<int> sum {0};
+            pool.parallelFor(0, kInner, 0, [&](int i0, int i1) {
+                for (int i = i0; i < i1; ++i) sum += i;
+            });
+            return sum.load();
+        }));
+    }
+    bool ok = true;
+    for (const auto& s : sums) ok = ok && s == kInner * (kInner - 1) / 2;
+    for (auto& t : tasks) ok = ok && t.get() == kInner * (kInner - 1) / 2;
+    std::cout << name << " nested parallelFor: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+bool rethrows(ThreadPool& pool) {
+    std::atomic<int> ran {0};
+    bool thrown = false;
+    try {
+        pool.parallelFor(0, 100, 0, [&](int lo, int hi) {
+            ran += hi - lo;
+            if (lo <= 50 && 50 < hi) throw std::runtime_error("chunk failed");
+        }, 10);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    // The other chunks still run before the exception reaches the caller
+    const bool ok = thrown && ran == 100;
+    std::cout << "Body exception rethrown after all chunks: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing work-stealing thread pool..." << std::endl;
+    // A deadlock shows up as a hang; fail instead
+    std::thread([]() {
+        std::this_thread::sleep_for(std::chrono::seconds(60));
+        std::cout << "Timed out (deadlock?)" << std::endl;
+        std::_Exit(1);
+    }).detach();
+
+    ThreadPool pool(4);
+    ThreadPool single(1);
+    bool ok = coverage(pool);
+    ok = honoursMaxThreads(pool) && ok;
+    ok = nested(pool, "4 workers,") && ok;
+    ok = nested(single, "1 worker,") && ok;
+    ok = nested(ThreadPool::shared(), "Shared pool,") && ok;
+    ok = rethrows(pool) && ok;
+    if (!ok) return 1;
+    std::cout << "Thread pool test completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+// Field-by-field equality; the binary format stores every value exactly
+bool sameMap(const TopologicalMap& a, const TopologicalMap& b) {
+    if (a.nodes.size() != b.nodes.size() || a.edges.size() != b.edges.size() ||
+        a.has_clearance != b.has_clearance || a.complete != b.complete) {
+        return false;
+    }
+    for (size_t i = 0; i < a.nodes.size(); ++i) {
+        const TopoNode& p = a.nodes[i];
+        const TopoNode& q = b.nodes[i];
+        if (p.id != q.id || p.x != q.x || p.y != q.y) return false;
+    }
+    for (size_t i = 0; i < a.edges.size(); ++i) {
+        const TopoEdge& p = a.edges[i];
+        const TopoEdge& q = b.edges[i];
+        if (p.id != q.id || p.u != q.u || p.v != q.v || p.length != q.length || p.clipped != q.clipped ||
+            p.polyline != q.polyline || p.clearance != q.clearance) {
+            return false;
+        }
+        if (a.has_clearance && (p.min_clearance != q.min_clearance || p.mean_clearance != q.mean_clearance)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Staggered blocks in a walled area: a connected skeleton with many edges
+TopologicalMap extractCorridors(bool clearance) {
+    OccupancyGrid grid(240, 180, 0.05);
+    for (int y = 0; y < grid.height; ++y) {
+        for (int x = 0; x < grid.width; ++x) {
+            const bool wall = x == 0 || y == 0 || x == grid.width - 1 || y == grid.height - 1;
+            const int by = (y + (x / 60) * 17) % 50;
+            const bool block = x % 60 >= 25 && x % 60 < 45 && by >= 20 && by < 35;
+            grid.data[grid.index(x, y)] = (wall || block) ? 100 : 0;
+        }
+    }
+    TopologyExtractor::Params params;
+    params.record_clearance_profile = clearance;
+    return TopologyExtractor(params).run(GvdGenerator().run(grid), grid.resolution);
+}
+
+bool roundTrip(const TopologicalMap& map, const char* name) {
+    const std::vector<uint8_t> bytes = serializeTopologyBinary(map);
+    bool ok = bytes.size() == topologyBinarySize(map);
+
+    // In-memory view: counts, flags and geometry in place, then a full copy
+    const TopologyBinaryView view(bytes.data(), bytes.size());
+    ok = ok && view.nodeCount() == map.nodes.size() && view.edgeCount() == map.edges.size() &&
+         view.hasClearance() == map.has_clearance && view.complete() == map.complete;
+    for (size_t i = 0; ok && i < map.edges.size(); ++i) {
+        const topo_binary::Edge& e = view.edges()[i];
+        ok = e.point_count == map.edges[i].polyline.size() &&
+             ((e.flags & topo_binary::kEdgeClipped) != 0) == map.edges[i].clipped;
+        for (size_t j = 0; ok && j < e.point_count; ++j) {
+            ok = view.edgePoints(i)[j].x == map.edges[i].polyline[j].first &&
+                 view.edgePoints(i)[j].y == map.edges[i].polyline[j].second;
+        }
+    }
+    ok = ok && sameMap(view.toMap(), map);
+
+    // Through a file and mmap
+    const std::string path = "test_topology_binary_" + std::to_string(::getpid()) + ".bin";
+    writeTopologyBinary(map, path);
+    {
+        const MappedTopology mapped(path);
+        ok = ok && sameMap(mapped.view().toMap(), map);
+    }
+    std::remove(path.c_str());
+
+    std::cout << name << ": " << map.nodes.size() << " nodes, " << map.edges.size() << " edges, "
+              << bytes.size() << " bytes: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+bool throws(const std::vector<uint8_t>& bytes) {
+    try {
+        TopologyBinaryView(bytes.data(), bytes.size());
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Damaged or newer files are refused at construction, never read past
+bool rejectsBadInput(const TopologicalMap& map) {
+    using namespace topo_binary;
+    const std::vector<uint8_t> good = serializeTopologyBinary(map);
+    auto header = [](std::vector<uint8_t>& b) { return reinterpret_cast<Header*>(b.data()); };
+    bool ok = !throws(good);
+
+    std::vector<uint8_t> b = good;
+    b.resize(b.size() - 8);
+    ok = ok && throws(b);
+    b = good;
+    b[0] = 'X';
+    ok = ok && throws(b);
+    b = good;
+    header(b)->version = kVersion + 1;
+    ok = ok && throws(b);
+    b = good;
+    header(b)->flags |= 1u << 7;
+    ok = ok && throws(b);
+    b = good;
+    header(b)->byte_order = 0x04030201u;
+    ok = ok && throws(b);
+    b = good;
+    header(b)->edges_offset = good.size();
+    ok = ok && throws(b);
+    b = good;
+    reinterpret_cast<Edge*>(b.data() + header(b)->edges_offset)->flags |= 1 << 5;
+    ok = ok && throws(b);
+    b = good;
+    Edge* last = reinterpret_cast<Edge*>(b.data() + header(b)->edges_offset) + (map.edges.size() - 1);
+    last->point_count = header(b)->point_count + 1;
+    ok = ok && throws(b);
+
+    // Files from older writers still load: their newer bits are all zero
+    b = good;
+    header(b)->version = kMinVersion;
+    ok = ok && !throws(b);
+
+    std::cout << "Damaged and unknown-version input rejected: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing binary topology format..." << std::endl;
+    const TopologicalMap plain = extractCorridors(false);
+    TopologicalMap profiled = extractCorridors(true);
+    bool ok = !plain.edges.empty() && profiled.has_clearance;
+    ok = roundTrip(plain, "Plain map") && ok;
+    ok = roundTrip(profiled, "Clearance profile") && ok;
+
+    // Flags set by anytime and ROI runs survive the round trip
+    profiled.complete = false;
+    for (size_t i = 0; i < profiled.edges.size(); i += 3) profiled.edges[i].clipped = true;
+    ok = roundTrip(profiled, "Incomplete, clipped edges") && ok;
+    ok = roundTrip(TopologicalMap{}, "Empty map") && ok;
+    ok = rejectsBadInput(plain) && ok;
+    if (!ok) return 1;
+    std::cout << "Binary topology test completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "gvd_topo/core/TopologyGraph.hpp"
+#include "gvd_topo/core/TopologyOverlay.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+const double kInf = std::numeric_limits<double>::infinity();
+
+// A 4 x 3 rectangle with its 0-2 diagonal, and a separate two-node component.
+// Ids are offset from storage indices so lookups cannot silently coincide.
+TopologicalMap makeMap() {
+    TopologicalMap map;
+    const double xy[6][2] = {{0, 0}, {4, 0}, {4, 3}, {0, 3}, {10, 10}, {12, 10}};
+    for (int i = 0; i < 6; ++i) {
+        TopoNode n;
+        n.id = 100 + i;
+        n.x = xy[i][0];
+        n.y = xy[i][1];
+        map.nodes.push_back(n);
+    }
+    const int uv[6][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 2}, {4, 5}};
+    for (int i = 0; i < 6; ++i) {
+        TopoEdge e;
+        e.id = 20 + i;
+        e.u = 100 + uv[i][0];
+        e.v = 100 + uv[i][1];
+        const auto& a = xy[uv[i][0]];
+        const auto& b = xy[uv[i][1]];
+        e.length = std::hypot(b[0] - a[0], b[1] - a[1]);
+        e.polyline = {{a[0], a[1]}, {b[0], b[1]}};
+        map.edges.push_back(e);
+    }
+    return map;
+}
+
+// Every node, two points on one edge, and points on the other component
+std::vector<GraphLocation> makeLocations(const TopologyGraph& graph) {
+    std::vector<GraphLocation> locs;
+    for (int n = 0; n < graph.nodeCount(); ++n) {
+        GraphLocation l;
+        l.node = n;
+        locs.push_back(l);
+    }
+    for (const auto& p : std::vector<std::pair<double,double>>{{1, -0.1}, {3, 0.2}, {2, 3}, {11, 10}}) {
+        locs.push_back(graph.snap(p.first, p.second));
+    }
+    return locs;
+}
+
+double pathLength(const TopologyGraph& graph, const std::vector<int>& edges) {
+    double sum = 0.0;
+    for (int e : edges) sum += graph.edgeLength(e);
+    return sum;
+}
+
+bool near(double a, double b) {
+    return a == b || std::fabs(a - b) < 1e-9;
+}
+
+bool snapping(const TopologyGraph& graph) {
+    const GraphLocation a = graph.snap(1, -0.1);
+    const GraphLocation b = graph.snap(3, 0.2);
+    const GraphLocation c = graph.snap(11, 10.5);
+    const bool ok = graph.nodeCount() == 6 && graph.edgeCount() == 6 && graph.nodeIndex(105) == 5 &&
+                    graph.edgeIndex(24) == 4 && graph.nodeIndex(7) == -1 && graph.edgeIndex(7) == -1 &&
+                    a.edge == graph.edgeIndex(20) && near(a.fraction, 0.25) && near(a.snap_distance, 0.1) &&
+                    b.edge == a.edge && near(b.fraction, 0.75) &&
+                    c.edge == graph.edgeIndex(25) && near(c.fraction, 0.5) && near(c.snap_distance, 0.5);
+    std::cout << "Snapping onto edges and nodes: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Every matrix cell equals the point-to-point query, serial and parallel,
+// with and without an overlay
+bool matrixMatchesShortestPath(const TopologyGraph& graph, const std::vector<GraphLocation>& locs) {
+    TopologyOverlay overlay(graph);
+    overlay.blockEdge(24);
+    overlay.scaleEdgeCost(21, 2.0);
+    bool ok = true;
+    for (const TopologyOverlay* o : {static_cast<const TopologyOverlay*>(nullptr),
+                                     static_cast<const TopologyOverlay*>(&overlay)}) {
+        DistanceMatrixOptions options;
+        options.overlay = o;
+        const DistanceMatrix m = computeDistanceMatrix(graph, locs, locs, options);
+        options.use_parallel = false;
+        const DistanceMatrix serial = computeDistanceMatrix(graph, locs, locs, options);
+        ok = ok && m.rows == locs.size() && m.cols == locs.size() && m.values == serial.values;
+        for (size_t r = 0; r < locs.size(); ++r) {
+            for (size_t c = 0; c < locs.size(); ++c) {
+                const GraphPath path = shortestPath(graph, locs[r], locs[c], o);
+                ok = ok && path.cost == m.at(r, c) && !std::isnan(m.at(r, c));
+                // Between nodes the path is made of whole edges
+                if (!o && locs[r].node >= 0 && locs[c].node >= 0 && path.cost != kInf) {
+                    ok = ok && near(pathLength(graph, path.edges), path.cost);
+                }
+            }
+        }
+    }
+
+    // Spot values: diagonal, same-edge run, unreachable component
+    const DistanceMatrix m = computeDistanceMatrix(graph, locs, locs);
+    const size_t on_a = 6, on_b = 7, far = 9;
+    ok = ok && m.at(0, 2) == 5.0 && near(m.at(on_a, on_b), 2.0) && near(m.at(on_b, on_a), 2.0) &&
+         near(m.at(on_a, 0), 1.0) && m.at(0, 4) == kInf && m.at(on_a, far) == kInf && m.at(far, 0) == kInf &&
+         near(m.at(far, 4), 1.0) && m.at(4, 4) == 0.0;
+    const GraphPath direct = shortestPath(graph, locs[on_a], locs[on_b]);
+    ok = ok && direct.edges == std::vector<int>{graph.edgeIndex(20)} &&
+         shortestPath(graph, locs[0], locs[4]).edges.empty();
+
+    // With the diagonal blocked, 0 -> 2 goes round the rectangle's cheaper side
+    DistanceMatrixOptions blocked;
+    blocked.overlay = &overlay;
+    ok = ok && computeDistanceMatrix(graph, locs, locs, blocked).at(0, 2) == 7.0;
+    std::cout << "Matrix equals per-pair shortestPath: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Predecessor trees rebuild the same routes as the point-to-point query
+bool predecessorTrees(const TopologyGraph& graph, const std::vector<GraphLocation>& locs) {
+    DistanceMatrixOptions options;
+    options.compute_predecessors = true;
+    const DistanceMatrix m = computeDistanceMatrix(graph, locs, locs, options);
+    bool ok = m.predecessors.size() == locs.size();
+    for (size_t r = 0; ok && r < locs.size(); ++r) {
+        const std::vector<int>& tree = m.predecessors[r];
+        ok = tree.size() == static_cast<size_t>(graph.nodeCount());
+        for (int n = 0; ok && n < graph.nodeCount(); ++n) {
+            const std::vector<int> route = tracePredecessors(graph, tree, n);
+            if (m.at(r, n) == kInf || static_cast<int>(r) == n) {
+                ok = tree[n] == -1 && route.empty();
+            } else if (locs[r].node >= 0) {
+                ok = near(pathLength(graph, route), m.at(r, n)) &&
+                     route == shortestPath(graph, locs[r], locs[n]).edges;
+            } else {
+                // From a point on an edge the tree is rooted at that edge's ends
+                const double len = pathLength(graph, route);
+                ok = near(len + m.at(r, graph.edgeU(locs[r].edge)), m.at(r, n)) ||
+                     near(len + m.at(r, graph.edgeV(locs[r].edge)), m.at(r, n));
+            }
+        }
+    }
+    ok = ok && tracePredecessors(graph, m.predecessors[0], -1).empty() &&
+         tracePredecessors(graph, m.predecessors[0], graph.nodeCount()).empty();
+    std::cout << "Predecessor trees match shortest paths: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// The cache serves repeats and recomputes once the overlay changes
+bool cacheFollowsOverlay(const TopologyGraph& graph, const std::vector<GraphLocation>& locs) {
+    TopologyOverlay overlay(graph);
+    DistanceMatrixOptions options;
+    options.overlay = &overlay;
+    DistanceMatrixCache cache;
+    const auto first = cache.get(graph, locs, locs, options);
+    bool ok = cache.get(graph, locs, locs, options) == first && first->at(0, 2) == 5.0;
+
+    overlay.blockEdge(24);
+    const auto blocked = cache.get(graph, locs, locs, options);
+    ok = ok && blocked != first && blocked->at(0, 2) == 7.0 && cache.get(graph, locs, locs, options) == blocked;
+
+    overlay.unblockEdge(24);
+    const auto reopened = cache.get(graph, locs, locs, options);
+    ok = ok && reopened != blocked && reopened->values == first->values;
+
+    cache.invalidate();
+    const auto fresh = cache.get(graph, locs, locs, options);
+    ok = ok && fresh != reopened && fresh->values == first->values;
+    std::cout << "Cache recomputes after an overlay change: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing topology graph..." << std::endl;
+    const TopologyGraph graph(makeMap());
+    const std::vector<GraphLocation> locs = makeLocations(graph);
+    bool ok = snapping(graph);
+    ok = matrixMatchesShortestPath(graph, locs) && ok;
+    ok = predecessorTrees(graph, locs) && ok;
+    ok = cacheFollowsOverlay(graph, locs) && ok;
+    if (!ok) return 1;
+    std::cout << "Topology graph test completed successfully!" << std::endl;
+    return 0;
+}
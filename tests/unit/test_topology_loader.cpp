@@ -0,0 +1,131 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include "gvd_topo/core/GvdGenerator.hpp"
+#include "gvd_topo/core/OccupancyGrid.hpp"
+#include "gvd_topo/core/TopologyExtractor.hpp"
+#include "gvd_topo/io/JsonWriter.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+#include "gvd_topo/io/TopologyLoader.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+bool sameMap(const TopologicalMap& a, const TopologicalMap& b) {
+    if (a.nodes.size() != b.nodes.size() || a.edges.size() != b.edges.size() ||
+        a.has_clearance != b.has_clearance || a.complete != b.complete) {
+        return false;
+    }
+    for (size_t i = 0; i < a.nodes.size(); ++i) {
+        const TopoNode& p = a.nodes[i];
+        const TopoNode& q = b.nodes[i];
+        if (p.id != q.id || p.x != q.x || p.y != q.y) return false;
+    }
+    for (size_t i = 0; i < a.edges.size(); ++i) {
+        const TopoEdge& p = a.edges[i];
+        const TopoEdge& q = b.edges[i];
+        if (p.id != q.id || p.u != q.u || p.v != q.v || p.length != q.length || p.clipped != q.clipped ||
+            p.polyline != q.polyline || p.clearance != q.clearance) {
+            return false;
+        }
+        if (a.has_clearance && (p.min_clearance != q.min_clearance || p.mean_clearance != q.mean_clearance)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TopologicalMap extractCorridors() {
+    OccupancyGrid grid(240, 180, 0.05);
+    for (int y = 0; y < grid.height; ++y) {
+        for (int x = 0; x < grid.width; ++x) {
+            const bool wall = x == 0 || y == 0 || x == grid.width - 1 || y == grid.height - 1;
+            const int by = (y + (x / 60) * 17) % 50;
+            const bool block = x % 60 >= 25 && x % 60 < 45 && by >= 20 && by < 35;
+            grid.data[grid.index(x, y)] = (wall || block) ? 100 : 0;
+        }
+    }
+    TopologyExtractor::Params params;
+    params.record_clearance_profile = true;
+    TopologicalMap map = TopologyExtractor(params).run(GvdGenerator().run(grid), grid.resolution);
+    map.complete = false;
+    for (size_t i = 0; i < map.edges.size(); i += 3) map.edges[i].clipped = true;
+    return map;
+}
+
+// Round-trip precision keeps every double; the default precision is only
+// stable under a second round trip
+bool jsonRoundTrip(const TopologicalMap& map) {
+    JsonWriteOptions exact;
+    exact.precision = 17;
+    const bool lossless = sameMap(TopologyLoader::fromJson(formatTopologyJson(map, exact)), map);
+    const std::string text = toJson(map);
+    const bool stable = toJson(TopologyLoader::fromJson(text)) == text;
+    const bool empty = sameMap(TopologyLoader::fromJson(toJson(TopologicalMap{})), TopologicalMap{});
+    const bool ok = lossless && stable && empty;
+    std::cout << "JSON round trip (precision 17 exact, default stable): " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// load() picks the parser from the leading bytes, not the extension
+bool loadFiles(const TopologicalMap& map) {
+    const std::string stem = "test_topology_loader_" + std::to_string(::getpid());
+    const std::string bin = stem + ".json"; // deliberately misleading
+    const std::string json = stem + ".bin";
+    writeTopologyBinary(map, bin);
+    JsonWriteOptions exact;
+    exact.precision = 17;
+    writeTopologyJson(map, json, exact);
+    const bool ok = TopologyLoader::isBinary(bin) && !TopologyLoader::isBinary(json) &&
+                    sameMap(TopologyLoader::load(bin), map) && sameMap(TopologyLoader::load(json), map);
+    std::remove(bin.c_str());
+    std::remove(json.c_str());
+    std::cout << "load() detects binary and JSON files: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+bool rejectsMalformed() {
+    const char* bad[] = {
+        "",
+        "{\"nodes\": [",
+        "{\"nodes\": [{\"id\": 1, \"x\": }], \"edges\": []}",
+        "{\"nodes\": [], \"edges\": [{\"id\": 0, \"u\": 0, \"v\": 1, \"polyline\": [[1, 2]}]}",
+        "[1, 2, 3]",
+    };
+    bool ok = true;
+    for (const char* text : bad) {
+        bool thrown = false;
+        try {
+            TopologyLoader::fromJson(text);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ok = ok && thrown;
+    }
+    // Unknown keys are skipped, whatever their value
+    const TopologicalMap extra = TopologyLoader::fromJson(
+        "{\"meta\": {\"a\": [1, {\"b\": null}]}, \"nodes\": [{\"id\": 3, \"x\": 1.5, \"y\": -2, \"tag\": \"n\"}], "
+        "\"edges\": []}");
+    ok = ok && extra.nodes.size() == 1 && extra.nodes[0].id == 3 && extra.nodes[0].x == 1.5 &&
+         extra.nodes[0].y == -2.0 && extra.complete;
+    std::cout << "Malformed JSON rejected, unknown keys skipped: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing topology loader..." << std::endl;
+    const TopologicalMap map = extractCorridors();
+    bool ok = !map.edges.empty() && map.has_clearance;
+    ok = jsonRoundTrip(map) && ok;
+    ok = loadFiles(map) && ok;
+    ok = rejectsMalformed() && ok;
+    if (!ok) return 1;
+    std::cout << "Topology loader test completed successfully!" << std::endl;
+    return 0;
+}
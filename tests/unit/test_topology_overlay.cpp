@@ -0,0 +1,227 @@
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "gvd_topo/core/TopologyGraph.hpp"
+#include "gvd_topo/core/TopologyOverlay.hpp"
+#include "gvd_topo/io/JsonWriter.hpp"
+#include "gvd_topo/io/TopologyBinary.hpp"
+
+namespace {
+
+using namespace gvd_topo;
+
+TopoEdge makeEdge(int id, int u, int v, double length, std::vector<std::pair<double,double>> polyline) {
+    TopoEdge e;
+    e.id = id;
+    e.u = u;
+    e.v = v;
+    e.length = length;
+    e.polyline = std::move(polyline);
+    return e;
+}
+
+// Square 0-1-2-3 with a diagonal 0-2, clearance data on every edge
+TopologicalMap makeSquare() {
+    TopologicalMap map;
+    const double xy[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    for (int i = 0; i < 4; ++i) {
+        TopoNode n;
+        n.id = 10 + i;
+        n.x = xy[i][0];
+        n.y = xy[i][1];
+        map.nodes.push_back(n);
+    }
+    map.edges.push_back(makeEdge(0, 10, 11, 1.0, {{0, 0}, {1, 0}}));
+    map.edges.push_back(makeEdge(1, 11, 12, 1.0, {{1, 0}, {1, 1}}));
+    map.edges.push_back(makeEdge(2, 12, 13, 1.0, {{1, 1}, {0, 1}}));
+    map.edges.push_back(makeEdge(3, 13, 10, 1.0, {{0, 1}, {0, 0}}));
+    map.edges.push_back(makeEdge(4, 10, 12, 1.5, {{0, 0}, {0.5, 0.5}, {1, 1}}));
+    map.has_clearance = true;
+    for (auto& e : map.edges) {
+        e.min_clearance = 0.25;
+        e.mean_clearance = 0.5;
+        e.clearance.assign(e.polyline.size(), 0.5f);
+    }
+    return map;
+}
+
+// Map-level flags reach the overlaid copy and both export formats
+bool flagsSurvive() {
+    TopologicalMap map = makeSquare();
+    map.complete = false;
+    const TopologyGraph graph(map);
+    TopologyOverlay overlay(graph);
+    overlay.blockEdge(1);
+    overlay.scaleEdgeCost(4, 2.0);
+    const TopologicalMap out = applyOverlay(map, overlay);
+
+    const std::string json = formatTopologyJson(out);
+    const std::vector<uint8_t> bytes = serializeTopologyBinary(out);
+    const TopologyBinaryView view(bytes.data(), bytes.size());
+    const bool ok = out.has_clearance && !out.complete && out.edges.size() == 4 &&
+                    json.find("\"complete\": false") != std::string::npos &&
+                    json.find("\"min_clearance\"") != std::string::npos &&
+                    view.hasClearance() && !view.complete() && view.edgeClearance(0)[0] == 0.5f;
+
+    map.complete = true;
+    map.has_clearance = false;
+    const TopologicalMap plain = applyOverlay(map, overlay);
+    const bool plain_ok = plain.complete && !plain.has_clearance;
+    std::cout << "has_clearance and complete survive applyOverlay: " << (ok && plain_ok ? "OK" : "FAIL")
+              << std::endl;
+    return ok && plain_ok;
+}
+
+const double kInf = std::numeric_limits<double>::infinity();
+
+bool hasNode(const TopologicalMap& m, int id) {
+    for (const auto& n : m.nodes) if (n.id == id) return true;
+    return false;
+}
+
+bool hasEdge(const TopologicalMap& m, int id) {
+    for (const auto& e : m.edges) if (e.id == id) return true;
+    return false;
+}
+
+// By-id changes: unknown ids and invalid factors are refused, every change
+// bumps the revision, clear() restores the plain graph
+bool byId() {
+    const TopologicalMap map = makeSquare();
+    const TopologyGraph graph(map);
+    TopologyOverlay overlay(graph);
+    const int e1 = graph.edgeIndex(1);
+    const int e4 = graph.edgeIndex(4);
+    bool ok = !overlay.blockEdge(77) && !overlay.blockNode(77) && !overlay.scaleEdgeCost(77, 2.0) &&
+              !overlay.scaleEdgeCost(4, -1.0) && !overlay.scaleEdgeCost(4, std::nan("")) &&
+              overlay.revision() == 0;
+    ok = ok && overlay.blockEdge(1) && overlay.edgeBlocked(e1) && overlay.edgeFactor(e1) == kInf;
+    ok = ok && overlay.scaleEdgeCost(4, 3.0) && overlay.edgeFactor(e4) == 3.0;
+    // A blocked endpoint blocks every edge at it
+    ok = ok && overlay.blockNode(13) && overlay.edgeFactor(graph.edgeIndex(2)) == kInf &&
+         overlay.edgeFactor(graph.edgeIndex(3)) == kInf && overlay.edgeFactor(graph.edgeIndex(0)) == 1.0;
+    ok = ok && overlay.revision() == 3;
+    ok = ok && overlay.unblockEdge(1) && overlay.unblockNode(13) && overlay.edgeFactor(e1) == 1.0;
+    overlay.clear();
+    for (int e = 0; e < graph.edgeCount(); ++e) ok = ok && overlay.edgeFactor(e) == 1.0;
+    ok = ok && overlay.revision() == 6;
+    std::cout << "Block, unblock and scale by id: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Edges are selected by their geometry entering the polygon: a vertex inside
+// or a segment crossing its border; nodes by position
+bool polygonSelection() {
+    const TopologicalMap map = makeSquare();
+    const TopologyGraph graph(map);
+    TopologyOverlay overlay(graph);
+    auto box = [](double x0, double y0, double x1, double y1) {
+        return Polygon2D{{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+    };
+
+    // Crosses edge 1 between its vertices; holds no node and no vertex
+    bool ok = overlay.blockPolygon(box(0.9, 0.4, 1.1, 0.6)) == 1 && overlay.edgeBlocked(graph.edgeIndex(1));
+    for (int e = 0; e < graph.edgeCount(); ++e) ok = ok && (overlay.edgeBlocked(e) == (graph.edgeId(e) == 1));
+    for (int n = 0; n < graph.nodeCount(); ++n) ok = ok && !overlay.nodeBlocked(n);
+    ok = ok && overlay.unblockPolygon(box(0.9, 0.4, 1.1, 0.6)) == 1 && !overlay.edgeBlocked(graph.edgeIndex(1));
+
+    // Holds only the diagonal's middle vertex
+    ok = ok && overlay.blockPolygon(box(0.45, 0.45, 0.55, 0.55)) == 1 && overlay.edgeBlocked(graph.edgeIndex(4));
+    overlay.clear();
+
+    // Around node 11: both of its edges and the node itself
+    ok = ok && overlay.blockPolygon(box(0.9, -0.1, 1.1, 0.1)) == 2 && overlay.nodeBlocked(graph.nodeIndex(11)) &&
+         overlay.edgeBlocked(graph.edgeIndex(0)) && overlay.edgeBlocked(graph.edgeIndex(1));
+    overlay.clear();
+    ok = ok && overlay.scalePolygon(box(0.9, -0.1, 1.1, 0.1), 2.5) == 2 &&
+         overlay.edgeFactor(graph.edgeIndex(0)) == 2.5 && overlay.edgeFactor(graph.edgeIndex(1)) == 2.5 &&
+         overlay.edgeFactor(graph.edgeIndex(2)) == 1.0 && !overlay.nodeBlocked(graph.nodeIndex(11));
+
+    // Degenerate polygons and polygons away from the graph touch nothing
+    const uint64_t revision = overlay.revision();
+    ok = ok && overlay.blockPolygon({{0, 0}, {1, 1}}) == 0 && overlay.scalePolygon({}, 2.0) == 0 &&
+         overlay.revision() == revision && overlay.blockPolygon(box(5, 5, 6, 6)) == 0;
+    std::cout << "Polygon selection: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Regression: blocking a zero-length edge made its cost 0 * inf = NaN, which
+// routing then treated as passable
+bool zeroLengthEdgeBlocked() {
+    TopologicalMap map;
+    for (int i = 0; i < 3; ++i) {
+        TopoNode n;
+        n.id = i;
+        n.x = i == 2 ? 5.0 : 0.0;
+        map.nodes.push_back(n);
+    }
+    map.edges.push_back(makeEdge(0, 0, 1, 0.0, {}));
+    map.edges.push_back(makeEdge(1, 0, 2, 5.0, {}));
+    map.edges.push_back(makeEdge(2, 2, 1, 5.0, {}));
+    const TopologyGraph graph(map);
+    TopologyOverlay overlay(graph);
+    GraphLocation from;
+    from.node = graph.nodeIndex(0);
+    GraphLocation to;
+    to.node = graph.nodeIndex(1);
+
+    bool ok = shortestPath(graph, from, to, &overlay).cost == 0.0;
+    overlay.scaleEdgeCost(0, 4.0);
+    ok = ok && shortestPath(graph, from, to, &overlay).cost == 0.0;
+    overlay.blockEdge(0);
+    const GraphPath detour = shortestPath(graph, from, to, &overlay);
+    DistanceMatrixOptions options;
+    options.overlay = &overlay;
+    const DistanceMatrix m = computeDistanceMatrix(graph, {from}, {to}, options);
+    ok = ok && overlay.edgeFactor(graph.edgeIndex(0)) == kInf && detour.cost == 10.0 &&
+         detour.edges == std::vector<int>{graph.edgeIndex(1), graph.edgeIndex(2)} && m.at(0, 0) == 10.0;
+    // Starting on the blocked edge itself: nothing is reachable
+    GraphLocation on_edge;
+    on_edge.edge = graph.edgeIndex(0);
+    on_edge.fraction = 0.5;
+    ok = ok && shortestPath(graph, on_edge, to, &overlay).cost == kInf;
+    std::cout << "Blocked zero-length edge stays blocked: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Regression: edges the graph does not index (dangling ones) were passed
+// through applyOverlay even when they ended at a node it had just removed
+bool droppedNodeEdges() {
+    TopologicalMap map = makeSquare();
+    map.edges.push_back(makeEdge(98, 10, 50, 1.0, {{0, 0}, {-1, 0}})); // node 50 does not exist
+    map.edges.push_back(makeEdge(99, 12, 50, 1.0, {{1, 1}, {2, 2}}));
+    const TopologyGraph graph(map);
+    TopologyOverlay overlay(graph);
+    overlay.blockNode(12);
+    const TopologicalMap out = applyOverlay(map, overlay);
+    bool ok = !hasNode(out, 12) && out.nodes.size() == 3 && hasEdge(out, 0) && hasEdge(out, 3) &&
+              hasEdge(out, 98) && !hasEdge(out, 99) && !hasEdge(out, 1) && !hasEdge(out, 2) && !hasEdge(out, 4);
+    for (const auto& e : out.edges) ok = ok && e.u != 12 && e.v != 12;
+
+    // Scaled edges report their effective cost; the source map is untouched
+    overlay.clear();
+    overlay.scaleEdgeCost(4, 2.0);
+    const TopologicalMap scaled = applyOverlay(map, overlay);
+    for (const auto& e : scaled.edges) {
+        ok = ok && e.length == (e.id == 4 ? 3.0 : 1.0);
+    }
+    ok = ok && map.edges[4].length == 1.5;
+    std::cout << "No edge left at a dropped node: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Testing topology overlay..." << std::endl;
+    bool ok = flagsSurvive();
+    ok = byId() && ok;
+    ok = polygonSelection() && ok;
+    ok = zeroLengthEdgeBlocked() && ok;
+    ok = droppedNodeEdges() && ok;
+    if (!ok) return 1;
+    std::cout << "Topology overlay test completed successfully!" << std::endl;
+    return 0;
+}